@@ -0,0 +1,122 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Replaces the global allocation functions of the benchmark executable to count heap allocations. The engine
+// library links into this executable, so its allocations are counted too.
+
+namespace
+{
+std::atomic<size_t> g_allocationCount{0};
+
+void *CountedAllocate(size_t size)
+{
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void *CountedAllocateAligned(size_t size, std::align_val_t alignment)
+{
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    const auto align = static_cast<size_t>(alignment);
+    return std::aligned_alloc(align, (std::max<size_t>(size, 1) + align - 1) / align * align);
+}
+} // namespace
+
+namespace bench
+{
+size_t GetAllocationCount()
+{
+    return g_allocationCount.load(std::memory_order_relaxed);
+}
+} // namespace bench
+
+void *operator new(size_t size)
+{
+    if (void *memory = CountedAllocate(size))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    return CountedAllocate(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    return CountedAllocate(size);
+}
+
+void *operator new(size_t size, std::align_val_t alignment)
+{
+    if (void *memory = CountedAllocateAligned(size, alignment))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void *operator new(size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return CountedAllocateAligned(size, alignment);
+}
+
+void *operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return CountedAllocateAligned(size, alignment);
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, size_t, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory, size_t, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
\ No newline at end of file
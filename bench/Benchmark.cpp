@@ -0,0 +1,304 @@
+#include "Benchmark.h"
+#include "version.h"
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+namespace bench
+{
+namespace
+{
+constexpr size_t MAX_ITERATIONS = size_t(1) << 24;
+
+BenchmarkOptions g_options;
+
+double TimeIterations(const std::function<void()> &function, size_t iterations)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        function();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+double Median(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    const size_t middle = values.size() / 2;
+    return values.size() % 2 == 0 ? 0.5 * (values[middle - 1] + values[middle]) : values[middle];
+}
+
+std::string FormatTime(double ms)
+{
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(3);
+    if (ms >= 1.0)
+    {
+        stream << ms << " ms";
+    }
+    else if (ms >= 1.0e-3)
+    {
+        stream << ms * 1.0e3 << " us";
+    }
+    else
+    {
+        stream << ms * 1.0e6 << " ns";
+    }
+    return stream.str();
+}
+
+std::string FormatCount(double count)
+{
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(2) << count;
+    return stream.str();
+}
+
+std::string EscapeJson(const std::string &text)
+{
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+size_t GetRepetitions(size_t repetitions)
+{
+    if (g_options.repetitions > 0)
+    {
+        repetitions = g_options.repetitions;
+    }
+    return std::max<size_t>(repetitions, 2);
+}
+
+BenchmarkResult Summarize(const std::string &name, size_t repetitions, size_t iterations, size_t items,
+                          const std::vector<double> &samples, size_t allocations)
+{
+    BenchmarkResult result;
+    result.name = name;
+    result.repetitions = repetitions;
+    result.iterations = iterations;
+    result.items = items;
+    result.allocations = static_cast<double>(allocations) / static_cast<double>(repetitions * iterations * items);
+    result.minMs = *std::min_element(samples.begin(), samples.end());
+    result.maxMs = *std::max_element(samples.begin(), samples.end());
+    result.medianMs = Median(samples);
+
+    double sum = 0.0;
+    for (double sample : samples)
+    {
+        sum += sample;
+    }
+    result.meanMs = sum / static_cast<double>(samples.size());
+
+    double squaredError = 0.0;
+    std::vector<double> deviations;
+    deviations.reserve(samples.size());
+    for (double sample : samples)
+    {
+        squaredError += (sample - result.meanMs) * (sample - result.meanMs);
+        deviations.push_back(std::abs(sample - result.medianMs));
+    }
+    result.stddevMs = std::sqrt(squaredError / static_cast<double>(samples.size() - 1));
+    result.madMs = Median(deviations);
+    result.ci95Ms = 1.96 * result.stddevMs / std::sqrt(static_cast<double>(samples.size()));
+
+    std::cout << std::left << std::setw(56) << name << std::right << " median " << std::setw(12)
+              << FormatTime(result.medianMs) << "  mean " << std::setw(12) << FormatTime(result.meanMs) << " +- "
+              << std::setw(12) << FormatTime(result.ci95Ms) << "  min " << std::setw(12) << FormatTime(result.minMs)
+              << "  allocs " << std::setw(8) << FormatCount(result.allocations) << "  (" << repetitions << " x "
+              << iterations << ")" << std::endl;
+
+    return result;
+}
+} // namespace
+
+void SetOptions(const BenchmarkOptions &options)
+{
+    g_options = options;
+}
+
+const BenchmarkOptions &GetOptions()
+{
+    return g_options;
+}
+
+bool IsEnabled(const std::string &name)
+{
+    return g_options.filter.empty() || name.find(g_options.filter) != std::string::npos;
+}
+
+std::optional<BenchmarkResult> Measure(const std::string &name, size_t repetitions,
+                                       const std::function<void()> &function, size_t items)
+{
+    if (!IsEnabled(name))
+    {
+        return std::nullopt;
+    }
+
+    repetitions = GetRepetitions(repetitions);
+    items = std::max<size_t>(items, 1);
+
+    // Calibration doubles as warm-up: grow the batch until one sample is long enough to time reliably
+    size_t iterations = 1;
+    while (iterations < MAX_ITERATIONS)
+    {
+        const double elapsedMs = TimeIterations(function, iterations);
+        if (elapsedMs >= g_options.minSampleMs)
+        {
+            break;
+        }
+        const double scale = elapsedMs > 0.0 ? g_options.minSampleMs / elapsedMs : 10.0;
+        iterations = std::min(MAX_ITERATIONS, static_cast<size_t>(static_cast<double>(iterations) *
+                                                                  std::clamp(scale * 1.2, 2.0, 10.0)));
+    }
+
+    const double perSample = static_cast<double>(iterations) * static_cast<double>(items);
+    std::vector<double> samples;
+    samples.reserve(repetitions);
+    size_t allocations = 0;
+    for (size_t i = 0; i < repetitions; ++i)
+    {
+        const size_t allocationsBefore = GetAllocationCount();
+        const double elapsedMs = TimeIterations(function, iterations);
+        allocations += GetAllocationCount() - allocationsBefore;
+        samples.push_back(elapsedMs / perSample);
+    }
+
+    return Summarize(name, repetitions, iterations, items, samples, allocations);
+}
+
+std::optional<BenchmarkResult> MeasureWithSetup(const std::string &name, size_t repetitions,
+                                                const std::function<void()> &setup,
+                                                const std::function<void()> &function, size_t items)
+{
+    if (!IsEnabled(name))
+    {
+        return std::nullopt;
+    }
+
+    repetitions = GetRepetitions(repetitions);
+    items = std::max<size_t>(items, 1);
+
+    // One untimed warm-up round, then every sample is a single call on freshly prepared state
+    setup();
+    function();
+
+    std::vector<double> samples;
+    samples.reserve(repetitions);
+    size_t allocations = 0;
+    for (size_t i = 0; i < repetitions; ++i)
+    {
+        setup();
+        const size_t allocationsBefore = GetAllocationCount();
+        const double elapsedMs = TimeIterations(function, 1);
+        allocations += GetAllocationCount() - allocationsBefore;
+        samples.push_back(elapsedMs / static_cast<double>(items));
+    }
+
+    return Summarize(name, repetitions, 1, items, samples, allocations);
+}
+
+bool WriteJson(const std::string &path, const std::vector<BenchmarkResult> &results)
+{
+    std::ofstream file(path);
+    if (!file)
+    {
+        return false;
+    }
+
+    char date[32] = {};
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+#ifdef NDEBUG
+    const char *buildType = "release";
+#else
+    const char *buildType = "debug";
+#endif
+
+    file << std::setprecision(std::numeric_limits<double>::max_digits10);
+    file << "{\n  \"context\": {\n";
+    file << "    \"version\": \"" << VERSION_STRING << "\",\n";
+    file << "    \"date\": \"" << date << "\",\n";
+    file << "    \"build_type\": \"" << buildType << "\",\n";
+    file << "    \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+    file << "    \"min_sample_ms\": " << g_options.minSampleMs << "\n";
+    file << "  },\n  \"benchmarks\": [";
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const auto &result = results[i];
+        file << (i == 0 ? "\n" : ",\n");
+        file << "    {\"name\": \"" << EscapeJson(result.name) << "\", \"repetitions\": " << result.repetitions
+             << ", \"iterations\": " << result.iterations << ", \"items\": " << result.items
+             << ", \"min_ms\": " << result.minMs << ", \"median_ms\": " << result.medianMs
+             << ", \"mean_ms\": " << result.meanMs << ", \"stddev_ms\": " << result.stddevMs
+             << ", \"mad_ms\": " << result.madMs << ", \"ci95_ms\": " << result.ci95Ms
+             << ", \"max_ms\": " << result.maxMs << ", \"allocations\": " << result.allocations << "}";
+    }
+
+    file << "\n  ]\n}\n";
+    return static_cast<bool>(file);
+}
+
+GLFWwindow *CreateBenchmarkContext()
+{
+    for (bool offscreen : {true, false})
+    {
+        glfwInitHint(GLFW_PLATFORM, offscreen ? GLFW_PLATFORM_NULL : GLFW_ANY_PLATFORM);
+        if (!glfwInit())
+        {
+            continue;
+        }
+
+        glfwDefaultWindowHints();
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        if (offscreen)
+        {
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+        }
+
+        GLFWwindow *window = glfwCreateWindow(256, 256, "DefinEngineBench", nullptr, nullptr);
+        if (window)
+        {
+            glfwMakeContextCurrent(window);
+            glewExperimental = GL_TRUE;
+            if (glewInit() == GLEW_OK)
+            {
+                return window;
+            }
+            glfwDestroyWindow(window);
+        }
+        glfwTerminate();
+    }
+    return nullptr;
+}
+
+void DestroyBenchmarkContext(GLFWwindow *window)
+{
+    glfwDestroyWindow(window);
+    glfwTerminate();
+}
+} // namespace bench
\ No newline at end of file
@@ -0,0 +1,157 @@
+#pragma once
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct GLFWwindow;
+
+namespace bench
+{
+/**
+ * @struct BenchmarkOptions
+ * @brief Settings shared by all benchmarks, usually taken from the command line.
+ */
+struct BenchmarkOptions
+{
+    size_t repetitions = 0;   ///< Timed samples per benchmark (0 keeps each benchmark's default).
+    double minSampleMs = 5.0; ///< Each sample repeats the benchmark until it runs at least this long.
+    std::string filter;       ///< Only benchmarks whose name contains this string run (empty = all).
+};
+
+/**
+ * @struct BenchmarkResult
+ * @brief Timing of a single benchmark over all of its samples, normalized to one item.
+ */
+struct BenchmarkResult
+{
+    std::string name;       ///< Name of the benchmark.
+    size_t repetitions = 0; ///< Number of timed samples.
+    size_t iterations = 0;  ///< Calls of the benchmark function per sample.
+    size_t items = 1;       ///< Items processed per call; all times below are per item.
+    double minMs = 0.0;     ///< Fastest sample in milliseconds.
+    double medianMs = 0.0;  ///< Median sample in milliseconds.
+    double meanMs = 0.0;    ///< Mean of the samples in milliseconds.
+    double stddevMs = 0.0;  ///< Sample standard deviation in milliseconds.
+    double madMs = 0.0;     ///< Median absolute deviation from the median in milliseconds.
+    double ci95Ms = 0.0;    ///< Half-width of the 95% confidence interval of the mean in milliseconds.
+    double maxMs = 0.0;     ///< Slowest sample in milliseconds.
+    double allocations = 0; ///< Global heap allocations per item during the timed samples.
+};
+
+/**
+ * @brief Sets the options used by Measure().
+ * @param options The new options.
+ */
+void SetOptions(const BenchmarkOptions &options);
+
+/**
+ * @brief Gets the options used by Measure().
+ * @return The current options.
+ */
+const BenchmarkOptions &GetOptions();
+
+/**
+ * @brief Checks whether a benchmark passes the name filter.
+ * @param name Name of the benchmark.
+ * @return True if the benchmark should run.
+ */
+bool IsEnabled(const std::string &name);
+
+/**
+ * @brief Times a function and prints the result.
+ *
+ * The function first runs in a calibration loop, which doubles as warm-up, that finds how many calls make a
+ * sample last at least BenchmarkOptions::minSampleMs. Then the given number of samples is timed. Functions
+ * must leave the state they work on unchanged so that every call does the same work.
+ * @param name Name of the benchmark.
+ * @param repetitions Default number of timed samples.
+ * @param function The code to measure.
+ * @param items Number of items one call processes; times are reported per item.
+ * @return The collected timings, or nothing if the benchmark is filtered out.
+ */
+std::optional<BenchmarkResult> Measure(const std::string &name, size_t repetitions,
+                                       const std::function<void()> &function, size_t items = 1);
+
+/**
+ * @brief Times a function that changes the state it works on, e.g. destroying objects.
+ *
+ * Every sample runs setup untimed and then one timed call of the function; there is no calibration, so the
+ * function should run for at least a millisecond.
+ * @param name Name of the benchmark.
+ * @param repetitions Default number of timed samples.
+ * @param setup Prepares the state for one call.
+ * @param function The code to measure.
+ * @param items Number of items one call processes; times are reported per item.
+ * @return The collected timings, or nothing if the benchmark is filtered out.
+ */
+std::optional<BenchmarkResult> MeasureWithSetup(const std::string &name, size_t repetitions,
+                                                const std::function<void()> &setup,
+                                                const std::function<void()> &function, size_t items = 1);
+
+/**
+ * @brief Gets the number of global heap allocations made by the process so far.
+ * @return The count, from the replaced global operator new of the benchmark executable.
+ */
+size_t GetAllocationCount();
+
+/**
+ * @brief Writes results as JSON so runs can be compared across commits.
+ * @param path Output file path.
+ * @param results The results to write.
+ * @return True if the file was written.
+ */
+bool WriteJson(const std::string &path, const std::vector<BenchmarkResult> &results);
+
+/**
+ * @brief Creates a small hidden window for its GL context: offscreen (null platform + OSMesa) first, then the
+ * default platform. The context is made current and GLEW is initialized.
+ * @return The window, or nullptr if no context could be created.
+ */
+GLFWwindow *CreateBenchmarkContext();
+
+/**
+ * @brief Destroys a window created by CreateBenchmarkContext() and terminates GLFW.
+ * @param window The window.
+ */
+void DestroyBenchmarkContext(GLFWwindow *window);
+
+/**
+ * @brief Keeps the compiler from optimizing away a value that is otherwise unused.
+ * @param value The value to keep.
+ */
+template <typename T> inline void DoNotOptimize(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief Runs the job system scaling benchmarks.
+ * @param results Receives one result per benchmark.
+ */
+void RunJobSystemBenchmarks(std::vector<BenchmarkResult> &results);
+
+/**
+ * @brief Runs the Scene and GameObject benchmarks.
+ * @param results Receives one result per benchmark.
+ */
+void RunSceneBenchmarks(std::vector<BenchmarkResult> &results);
+
+/**
+ * @brief Runs the RenderQueue benchmarks. Draw benchmarks are skipped if no GL context can be created.
+ * @param results Receives one result per benchmark.
+ */
+void RunRenderQueueBenchmarks(std::vector<BenchmarkResult> &results);
+
+/**
+ * @brief Runs the component system benchmarks against the per-object update walk. The MeshComponent benchmarks
+ * are skipped if no GL context can be created.
+ * @param results Receives one result per benchmark.
+ */
+void RunSystemBenchmarks(std::vector<BenchmarkResult> &results);
+} // namespace bench
\ No newline at end of file
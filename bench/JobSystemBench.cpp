@@ -0,0 +1,137 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <jobs/JobSystem.h>
+#include <jobs/TaskGraph.h>
+#include <thread>
+
+namespace bench
+{
+namespace
+{
+constexpr size_t ELEMENT_COUNT = 1 << 22;
+constexpr size_t GRAIN_SIZE = 4096;
+constexpr size_t SMALL_JOB_COUNT = 1 << 16;
+constexpr size_t REPETITIONS = 15;
+constexpr size_t GRAPH_TASK_COUNT = 64;
+
+float Work(float value)
+{
+    return std::sqrt(value) * std::sin(value) + std::cos(value * 0.5f);
+}
+} // namespace
+
+void RunJobSystemBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    std::vector<float> input(ELEMENT_COUNT);
+    std::vector<float> output(ELEMENT_COUNT);
+    for (size_t i = 0; i < ELEMENT_COUNT; ++i)
+    {
+        input[i] = static_cast<float>(i % 1024) * 0.01f;
+    }
+
+    // 1, 2, 4, ... threads up to and including the hardware thread count
+    uint32_t hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    std::vector<uint32_t> threadCounts;
+    for (uint32_t threads = 1; threads < hardwareThreads; threads *= 2)
+    {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(hardwareThreads);
+
+    double singleThreadMs = 0.0;
+    for (uint32_t threads : threadCounts)
+    {
+        eng::JobSystem jobSystem;
+        jobSystem.Init(static_cast<int>(threads) - 1);
+
+        std::string suffix = "/threads:" + std::to_string(threads);
+
+        auto parallelFor = Measure("JobSystem/ParallelFor" + suffix, REPETITIONS, [&]() {
+            jobSystem.ParallelFor(ELEMENT_COUNT, GRAIN_SIZE, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    output[i] = Work(input[i]);
+                }
+            });
+        });
+
+        if (parallelFor)
+        {
+            if (threads == 1)
+            {
+                singleThreadMs = parallelFor->medianMs;
+            }
+            else if (singleThreadMs > 0.0 && parallelFor->medianMs > 0.0)
+            {
+                std::cout << "    speedup vs 1 thread: " << singleThreadMs / parallelFor->medianMs << "x" << std::endl;
+            }
+            results.push_back(*parallelFor);
+        }
+
+        auto smallJobs = Measure("JobSystem/SmallJobs" + suffix, REPETITIONS, [&]() {
+            std::atomic<uint32_t> sum = 0;
+            eng::JobCounter counter;
+            for (size_t i = 0; i < SMALL_JOB_COUNT; ++i)
+            {
+                jobSystem.Run([&sum]() { sum.fetch_add(1, std::memory_order_relaxed); }, &counter);
+            }
+            jobSystem.Wait(counter);
+        });
+        if (smallJobs)
+        {
+            results.push_back(*smallJobs);
+        }
+
+        // Root, GRAPH_TASK_COUNT independent slices of the ParallelFor work, and a join: the spread between
+        // thread counts shows how well the graph exposes independent tasks
+        eng::TaskGraph fanOut;
+        const eng::TaskId root = fanOut.AddTask(eng::StringId("Root"), []() {});
+        const eng::TaskId join = fanOut.AddTask(eng::StringId("Join"), []() {});
+        const size_t sliceSize = ELEMENT_COUNT / GRAPH_TASK_COUNT;
+        for (size_t task = 0; task < GRAPH_TASK_COUNT; ++task)
+        {
+            const eng::TaskId slice =
+                fanOut.AddTask(eng::StringId("Slice " + std::to_string(task)), [&input, &output, task, sliceSize]() {
+                    for (size_t i = task * sliceSize; i < (task + 1) * sliceSize; ++i)
+                    {
+                        output[i] = Work(input[i]);
+                    }
+                });
+            fanOut.AddDependency(root, slice);
+            fanOut.AddDependency(slice, join);
+        }
+
+        auto fanOutResult =
+            Measure("TaskGraph/FanOut:" + std::to_string(GRAPH_TASK_COUNT) + suffix, REPETITIONS, [&]() {
+                fanOut.Run(jobSystem);
+            });
+        if (fanOutResult)
+        {
+            results.push_back(*fanOutResult);
+        }
+
+        // Empty tasks that each wait for the previous one: pure scheduling overhead per task
+        eng::TaskGraph chain;
+        eng::TaskId previous = eng::TaskGraph::INVALID_TASK;
+        for (size_t task = 0; task < GRAPH_TASK_COUNT; ++task)
+        {
+            const eng::TaskId link = chain.AddTask(eng::StringId("Link " + std::to_string(task)), []() {});
+            if (previous != eng::TaskGraph::INVALID_TASK)
+            {
+                chain.AddDependency(previous, link);
+            }
+            previous = link;
+        }
+
+        auto chainResult = Measure("TaskGraph/Chain:" + std::to_string(GRAPH_TASK_COUNT) + suffix, REPETITIONS,
+                                   [&]() { chain.Run(jobSystem); });
+        if (chainResult)
+        {
+            results.push_back(*chainResult);
+        }
+    }
+}
+} // namespace bench
\ No newline at end of file
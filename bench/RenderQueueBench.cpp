@@ -0,0 +1,262 @@
+#include "Benchmark.h"
+#include <GL/glew.h>
+#include <Engine.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <graphics/ShaderProgram.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <render/FrustumCuller.h>
+#include <render/Material.h>
+#include <render/Mesh.h>
+#include <render/MeshLodChain.h>
+#include <render/RenderQueue.h>
+
+namespace bench
+{
+namespace
+{
+constexpr size_t REPETITIONS = 20;
+constexpr size_t MATERIAL_COUNT = 4;
+const size_t COMMAND_COUNTS[] = {100, 1000, 10000};
+constexpr size_t CULL_OBJECT_COUNT = 100000;
+
+const char *VERTEX_SHADER = R"(
+    #version 330 core
+    layout (location = 0) in vec3 position;
+
+    uniform mat4 uModel;
+    uniform mat4 uView;
+    uniform mat4 uProjection;
+
+    void main()
+    {
+        gl_Position = uProjection * uView * uModel * vec4(position, 1.0);
+    }
+)";
+
+const char *FRAGMENT_SHADER = R"(
+    #version 330 core
+    out vec4 FragColor;
+
+    uniform float uBrightness;
+
+    void main()
+    {
+        FragColor = vec4(vec3(uBrightness), 1.0);
+    }
+)";
+
+eng::RenderCommand MakeCommand(const std::shared_ptr<eng::Mesh> &mesh, const std::shared_ptr<eng::Material> &material,
+                          size_t index)
+{
+    eng::RenderCommand command;
+    command.mesh = mesh;
+    command.material = material;
+    command.modelMatrix = glm::mat4(1.0f);
+    command.modelMatrix[3] = glm::vec4(static_cast<float>(index % 100) * 0.01f, 0.0f, 0.0f, 1.0f);
+    return command;
+}
+
+void RunSubmitBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    // Submission does not touch GL, so it runs without a context, with materials but no meshes
+    std::vector<std::shared_ptr<eng::Material>> materials;
+    for (size_t i = 0; i < MATERIAL_COUNT; ++i)
+    {
+        materials.push_back(std::make_shared<eng::Material>());
+    }
+
+    for (size_t commandCount : COMMAND_COUNTS)
+    {
+        eng::RenderQueue queue;
+        auto result = Measure("RenderQueue::Submit/commands:" + std::to_string(commandCount), REPETITIONS,
+                              [&]() {
+                                  for (size_t i = 0; i < commandCount; ++i)
+                                  {
+                                      queue.Submit(MakeCommand(nullptr, materials[i % MATERIAL_COUNT], i));
+                                  }
+                                  queue.Flip();
+                              },
+                              commandCount);
+        if (result)
+        {
+            results.push_back(*result);
+        }
+        queue.Clear();
+    }
+}
+
+void RunCullBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    // Unit cubes scattered around a perspective camera at the origin looking down -z, so a fraction is visible
+    std::vector<glm::mat4> modelMatrices(CULL_OBJECT_COUNT, glm::mat4(1.0f));
+    uint32_t seed = 12345;
+    auto random = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24) * 400.0f - 200.0f;
+    };
+    for (auto &modelMatrix : modelMatrices)
+    {
+        modelMatrix[3] = glm::vec4(random(), random(), random(), 1.0f);
+    }
+
+    eng::BoundingBox box;
+    box.Expand(glm::vec3(-0.5f));
+    box.Expand(glm::vec3(0.5f));
+    eng::BoundingSphere sphere;
+    sphere.center = glm::vec3(0.0f);
+    sphere.radius = glm::length(glm::vec3(0.5f));
+
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 150.0f);
+    const eng::Frustum frustum = eng::Frustum::FromMatrix(projection);
+
+    eng::FrustumCuller culler;
+    std::vector<uint32_t> visible;
+    auto result = Measure("FrustumCuller/objects:" + std::to_string(CULL_OBJECT_COUNT), REPETITIONS,
+                          [&]() {
+                              culler.Clear();
+                              for (const auto &modelMatrix : modelMatrices)
+                              {
+                                  culler.Add(modelMatrix, box, sphere);
+                              }
+                              culler.Cull(frustum, visible);
+                          },
+                          CULL_OBJECT_COUNT);
+    if (result)
+    {
+        std::cout << "    visible: " << visible.size() << " of " << CULL_OBJECT_COUNT << std::endl;
+        results.push_back(*result);
+    }
+}
+
+void RunLodSelectionBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    // The same scattered unit cubes, moved in front of the camera as if culled already, each with its own three
+    // level chain; only the selection is measured, so the levels need no meshes
+    std::vector<glm::mat4> modelMatrices(CULL_OBJECT_COUNT, glm::mat4(1.0f));
+    uint32_t seed = 12345;
+    auto random = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24) * 400.0f - 200.0f;
+    };
+    for (auto &modelMatrix : modelMatrices)
+    {
+        modelMatrix[3] = glm::vec4(random(), random(), -std::abs(random()), 1.0f);
+    }
+
+    std::vector<eng::MeshLodChain> chains;
+    chains.reserve(CULL_OBJECT_COUNT);
+    for (size_t i = 0; i < CULL_OBJECT_COUNT; ++i)
+    {
+        chains.emplace_back(std::vector<eng::MeshLod>{{nullptr, 0.05f}, {nullptr, 0.01f}, {nullptr, 0.005f}});
+    }
+
+    eng::BoundingSphere sphere;
+    sphere.center = glm::vec3(0.0f);
+    sphere.radius = glm::length(glm::vec3(0.5f));
+
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 150.0f);
+    size_t levelCounts[4] = {};
+    auto result = Measure("MeshLodChain::SelectLevel/objects:" + std::to_string(CULL_OBJECT_COUNT), REPETITIONS,
+                          [&]() {
+                              std::fill(std::begin(levelCounts), std::end(levelCounts), 0);
+                              for (size_t i = 0; i < CULL_OBJECT_COUNT; ++i)
+                              {
+                                  const float coverage = eng::MeshLodChain::ComputeScreenCoverage(
+                                      sphere.Transform(modelMatrices[i]), projection, projection[1][1]);
+                                  const uint32_t level = chains[i].SelectLevel(coverage);
+                                  ++levelCounts[std::min<uint32_t>(level, 3)];
+                              }
+                          },
+                          CULL_OBJECT_COUNT);
+    if (result)
+    {
+        std::cout << "    levels 0/1/2/culled: " << levelCounts[0] << "/" << levelCounts[1] << "/" << levelCounts[2]
+                  << "/" << levelCounts[3] << std::endl;
+        results.push_back(*result);
+    }
+}
+
+void RunDrawBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    bool anyEnabled = false;
+    for (size_t commandCount : COMMAND_COUNTS)
+    {
+        anyEnabled = anyEnabled || IsEnabled("RenderQueue::Draw/commands:" + std::to_string(commandCount));
+    }
+    if (!anyEnabled)
+    {
+        return;
+    }
+
+    GLFWwindow *window = CreateBenchmarkContext();
+    if (!window)
+    {
+        std::cout << "RenderQueue::Draw skipped: no GL context available" << std::endl;
+        return;
+    }
+
+    {
+        auto &graphicsAPI = eng::Engine::GetInstance().GetGraphicsAPI();
+        graphicsAPI.Init();
+
+        eng::VertexLayout layout;
+        layout.elements.push_back({0, 3, GL_FLOAT, 0});
+        layout.stride = sizeof(float) * 3;
+        const std::vector<float> vertices = {-0.01f, -0.01f, 0.0f, 0.01f, -0.01f, 0.0f, 0.0f, 0.01f, 0.0f};
+        const std::vector<uint32_t> indices = {0, 1, 2};
+        auto mesh = std::make_shared<eng::Mesh>(layout, vertices, indices);
+
+        auto shaderProgram = graphicsAPI.CreateShaderProgram(VERTEX_SHADER, FRAGMENT_SHADER);
+        std::vector<std::shared_ptr<eng::Material>> materials;
+        for (size_t i = 0; i < MATERIAL_COUNT; ++i)
+        {
+            auto material = std::make_shared<eng::Material>();
+            material->SetShaderProgram(shaderProgram);
+            material->SetParam("uBrightness", static_cast<float>(i) / static_cast<float>(MATERIAL_COUNT));
+            materials.push_back(material);
+        }
+
+        for (size_t commandCount : COMMAND_COUNTS)
+        {
+            eng::RenderQueue queue;
+            eng::CameraData cameraData;
+            cameraData.viewMatrix = glm::mat4(1.0f);
+            cameraData.projectionMatrix = glm::mat4(1.0f);
+            queue.SetCameraData(cameraData);
+            for (size_t i = 0; i < commandCount; ++i)
+            {
+                queue.Submit(MakeCommand(mesh, materials[i % MATERIAL_COUNT], i));
+            }
+            queue.Flip();
+
+            // glFinish makes every sample include the GPU work instead of only queueing it
+            auto result = Measure("RenderQueue::Draw/commands:" + std::to_string(commandCount), REPETITIONS,
+                                  [&]() {
+                                      graphicsAPI.ClearBuffers();
+                                      queue.Draw(graphicsAPI);
+                                      glFinish();
+                                  },
+                                  commandCount);
+            if (result)
+            {
+                results.push_back(*result);
+            }
+            queue.Clear();
+        }
+    }
+
+    DestroyBenchmarkContext(window);
+}
+} // namespace
+
+void RunRenderQueueBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    RunSubmitBenchmarks(results);
+    RunCullBenchmarks(results);
+    RunLodSelectionBenchmarks(results);
+    RunDrawBenchmarks(results);
+}
+} // namespace bench
\ No newline at end of file
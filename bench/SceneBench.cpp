@@ -0,0 +1,901 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <cmath>
+#include <core/Bounds.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <jobs/JobSystem.h>
+#include <memory>
+#include <random>
+#include <scene/Scene.h>
+#include <thread>
+#include <utility>
+
+namespace bench
+{
+namespace
+{
+constexpr size_t REPETITIONS = 25;
+
+/**
+ * @class BenchComponent
+ * @brief Minimal component; every index I is a distinct component type.
+ */
+template <size_t I> class BenchComponent final : public eng::Component
+{
+    COMPONENT(BenchComponent)
+
+  public:
+    void Update(float deltaTime) override
+    {
+        m_time += deltaTime;
+    }
+
+  private:
+    float m_time = 0.0f;
+};
+
+/**
+ * @class IntegrateComponent
+ * @brief Declared system with some arithmetic per instance, touching only its own data.
+ */
+class IntegrateComponent final : public eng::Component
+{
+    COMPONENT(IntegrateComponent)
+
+  public:
+    using Writes = eng::ComponentList<>;
+
+    void Update(float deltaTime) override
+    {
+        m_velocity += std::sin(m_position) * deltaTime;
+        m_position += m_velocity * deltaTime;
+    }
+
+    [[nodiscard]] float GetPosition() const
+    {
+        return m_position;
+    }
+
+  private:
+    float m_position = 1.0f;
+    float m_velocity = 0.0f;
+};
+
+/**
+ * @class FollowComponent
+ * @brief Declared system that reads the IntegrateComponent of its owner, so it runs in a later wave.
+ */
+class FollowComponent final : public eng::Component
+{
+    COMPONENT(FollowComponent)
+
+  public:
+    using Reads = eng::ComponentList<IntegrateComponent>;
+
+    void Update(float deltaTime) override
+    {
+        const float target = m_owner->GetComponent<IntegrateComponent>()->GetPosition();
+        m_value += (target - m_value) * std::min(deltaTime * 4.0f, 1.0f);
+    }
+
+  private:
+    float m_value = 0.0f;
+};
+
+/**
+ * @class DecayComponent
+ * @brief Declared system that conflicts with neither of the above, so it shares the first wave.
+ */
+class DecayComponent final : public eng::Component
+{
+    COMPONENT(DecayComponent)
+
+  public:
+    using Writes = eng::ComponentList<>;
+
+    void Update(float deltaTime) override
+    {
+        m_value = m_value * std::exp(-deltaTime) + std::cos(m_value) * deltaTime;
+    }
+
+  private:
+    float m_value = 1.0f;
+};
+
+template <size_t... Is> void AddBenchComponents(eng::GameObject *object, std::index_sequence<Is...>)
+{
+    (object->AddComponent<BenchComponent<Is>>(), ...);
+}
+
+template <size_t... Is> void AddHeapBenchComponents(eng::GameObject *object, std::index_sequence<Is...>)
+{
+    (object->AddComponent(new BenchComponent<Is>()), ...);
+}
+
+/**
+ * @brief Builds chains of objects, each object being the child of the previous one.
+ * @return The deepest object of the last chain.
+ */
+eng::GameObject *BuildChains(eng::Scene &scene, size_t chains, size_t depth)
+{
+    eng::GameObject *leaf = nullptr;
+    for (size_t chain = 0; chain < chains; ++chain)
+    {
+        eng::GameObject *parent = nullptr;
+        for (size_t level = 0; level < depth; ++level)
+        {
+            parent = scene.CreateObject("Node", parent);
+            parent->SetPosition(glm::vec3(0.0f, 1.0f, 0.0f));
+            parent->AddComponent<BenchComponent<0>>();
+        }
+        leaf = parent;
+    }
+    return leaf;
+}
+
+void RunUpdateBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    constexpr size_t OBJECT_COUNT = 10000;
+
+    // Same number of objects, laid out flat and as deep chains
+    const std::pair<size_t, size_t> layouts[] = {{OBJECT_COUNT, 1}, {OBJECT_COUNT / 100, 100}, {10, OBJECT_COUNT / 10}};
+    for (const auto &[chains, depth] : layouts)
+    {
+        const std::string name = "Scene::Update/chains:" + std::to_string(chains) + "/depth:" + std::to_string(depth);
+        if (!IsEnabled(name))
+        {
+            continue;
+        }
+
+        eng::Scene scene;
+        BuildChains(scene, chains, depth);
+        if (auto result = Measure(name, REPETITIONS, [&]() { scene.Update(1.0f / 60.0f); }, OBJECT_COUNT))
+        {
+            results.push_back(*result);
+        }
+    }
+}
+
+void RunParallelSystemBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    constexpr size_t OBJECT_COUNT = 100000;
+
+    // 1, 2, 4, ... threads up to and including the hardware thread count; one thread runs the serial path
+    const uint32_t hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    std::vector<uint32_t> threadCounts;
+    for (uint32_t threads = 1; threads < hardwareThreads; threads *= 2)
+    {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(hardwareThreads);
+
+    for (uint32_t threads : threadCounts)
+    {
+        const std::string name =
+            "Scene::Update/systems:3/objects:" + std::to_string(OBJECT_COUNT) + "/threads:" + std::to_string(threads);
+        if (!IsEnabled(name))
+        {
+            continue;
+        }
+
+        eng::JobSystem jobSystem;
+        jobSystem.Init(static_cast<int>(threads) - 1);
+
+        eng::Scene scene;
+        scene.SetJobSystem(&jobSystem);
+        for (size_t i = 0; i < OBJECT_COUNT; ++i)
+        {
+            eng::GameObject *object = scene.CreateObject("Object");
+            object->AddComponent<IntegrateComponent>();
+            object->AddComponent<FollowComponent>();
+            object->AddComponent<DecayComponent>();
+        }
+
+        if (auto result = Measure(name, REPETITIONS, [&]() { scene.Update(1.0f / 60.0f); }, OBJECT_COUNT))
+        {
+            results.push_back(*result);
+        }
+    }
+}
+
+void RunEachBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    for (size_t objectCount : {1000, 10000, 100000})
+    {
+        const std::string name = "Scene::Each/objects:" + std::to_string(objectCount);
+        if (!IsEnabled(name))
+        {
+            continue;
+        }
+
+        // Half of the objects carry a second type, so the query spans two archetypes
+        eng::Scene scene;
+        for (size_t i = 0; i < objectCount; ++i)
+        {
+            eng::GameObject *object = scene.CreateObject("Object");
+            object->AddComponent<BenchComponent<0>>();
+            if (i % 2 == 0)
+            {
+                object->AddComponent<BenchComponent<1>>();
+            }
+        }
+
+        auto update = [](eng::GameObject &, BenchComponent<0> &component) { component.Update(1.0f / 60.0f); };
+        auto result = Measure(name, REPETITIONS, [&]() { scene.Each<BenchComponent<0>>(update); }, objectCount);
+        if (result)
+        {
+            results.push_back(*result);
+        }
+    }
+}
+
+void RunWorldTransformBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    for (size_t depth : {1, 4, 16, 64, 256})
+    {
+        const std::string name = "GameObject::GetWorldTransform/depth:" + std::to_string(depth);
+
+        eng::Scene scene;
+        eng::GameObject *leaf = BuildChains(scene, 1, depth);
+        eng::GameObject *root = leaf;
+        while (root->GetParent())
+        {
+            root = root->GetParent();
+        }
+
+        if (auto result = Measure(name + "/cached", REPETITIONS, [&]() { DoNotOptimize(leaf->GetWorldTransform()); }))
+        {
+            results.push_back(*result);
+        }
+
+        // Moving the root invalidates the whole chain, so the leaf pays for every level again
+        auto result = Measure(name + "/root-moved", REPETITIONS, [&]() {
+            root->SetPosition(root->GetPosition());
+            DoNotOptimize(leaf->GetWorldTransform());
+        });
+        if (result)
+        {
+            results.push_back(*result);
+        }
+    }
+}
+
+void RunTransformStoreBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    for (size_t nodeCount : {1000, 10000, 100000, 1000000})
+    {
+        const std::string name = "TransformStore::UpdateWorldTransforms/nodes:" + std::to_string(nodeCount);
+        if (!IsEnabled(name))
+        {
+            continue;
+        }
+
+        // Trees with a fan-out of 8, built without GameObjects so the million-node case stays cheap to set up
+        eng::TransformStore store;
+        store.Reserve(nodeCount);
+        for (size_t i = 0; i < nodeCount; ++i)
+        {
+            const uint32_t index = store.Allocate(nullptr);
+            store.SetPosition(index, glm::vec3(0.0f, 1.0f, 0.0f));
+            store.SetParent(index, i == 0 ? eng::TransformStore::INVALID_INDEX : static_cast<uint32_t>((i - 1) / 8));
+        }
+        store.UpdateWorldTransforms();
+
+        auto result = Measure(
+            name, REPETITIONS,
+            [&]() {
+                store.InvalidateAll();
+                store.UpdateWorldTransforms();
+            },
+            nodeCount);
+        if (result)
+        {
+            results.push_back(*result);
+        }
+    }
+}
+
+template <size_t N> void RunGetComponentBenchmark(std::vector<BenchmarkResult> &results)
+{
+    const std::string prefix = "GameObject::GetComponent/components:" + std::to_string(N);
+
+    eng::Scene scene;
+    eng::GameObject *object = scene.CreateObject("Object");
+    AddBenchComponents(object, std::make_index_sequence<N>());
+
+    if (auto result = Measure(prefix + "/first", REPETITIONS,
+                              [&]() { DoNotOptimize(object->GetComponent<BenchComponent<0>>()); }))
+    {
+        results.push_back(*result);
+    }
+
+    if (auto result = Measure(prefix + "/last", REPETITIONS,
+                              [&]() { DoNotOptimize(object->GetComponent<BenchComponent<N - 1>>()); }))
+    {
+        results.push_back(*result);
+    }
+
+    if (auto result = Measure(prefix + "/missing", REPETITIONS,
+                              [&]() { DoNotOptimize(object->GetComponent<BenchComponent<N>>()); }))
+    {
+        results.push_back(*result);
+    }
+
+    // Components added through AddComponent(Component *) are found through the sorted type-to-slot table
+    eng::GameObject *heapObject = scene.CreateObject("HeapObject");
+    AddHeapBenchComponents(heapObject, std::make_index_sequence<N>());
+
+    if (auto result = Measure(prefix + "/heap-last", REPETITIONS,
+                              [&]() { DoNotOptimize(heapObject->GetComponent<BenchComponent<N - 1>>()); }))
+    {
+        results.push_back(*result);
+    }
+}
+
+void RunSetParentBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    for (size_t objectCount : {100, 1000, 10000, 100000})
+    {
+        const std::string name = "Scene::SetParent/objects:" + std::to_string(objectCount);
+        if (!IsEnabled(name))
+        {
+            continue;
+        }
+
+        eng::Scene scene;
+        BuildChains(scene, objectCount, 1);
+        eng::GameObject *parent = scene.CreateObject("Parent");
+        eng::GameObject *child = scene.CreateObject("Child");
+
+        // Attach and detach so the scene ends every call in the state it started in
+        auto result = Measure(
+            name, REPETITIONS,
+            [&]() {
+                scene.SetParent(child, parent);
+                scene.SetParent(child, nullptr);
+            },
+            2);
+        if (result)
+        {
+            results.push_back(*result);
+        }
+    }
+}
+
+void RunBulkAttachBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    constexpr size_t OBJECT_COUNT = 10000;
+    const std::string prefix = "Scene::SetParent/attach:" + std::to_string(OBJECT_COUNT);
+
+    // Spawn a pool of root objects untimed, then attach all of them under one pool root
+    std::unique_ptr<eng::Scene> scene;
+    std::vector<eng::GameObject *> objects;
+    eng::GameObject *pool = nullptr;
+    auto setup = [&]() {
+        scene.reset();
+        scene = std::make_unique<eng::Scene>();
+        objects.clear();
+        pool = scene->CreateObject("Pool");
+        for (size_t i = 0; i < OBJECT_COUNT; ++i)
+        {
+            objects.push_back(scene->CreateObject("Bullet"));
+        }
+    };
+
+    if (IsEnabled(prefix + "/single"))
+    {
+        auto result = MeasureWithSetup(
+            prefix + "/single", REPETITIONS, setup,
+            [&]() {
+                for (eng::GameObject *object : objects)
+                {
+                    scene->SetParent(object, pool);
+                }
+            },
+            OBJECT_COUNT);
+        if (result)
+        {
+            results.push_back(*result);
+        }
+    }
+
+    if (IsEnabled(prefix + "/batch"))
+    {
+        auto result = MeasureWithSetup(
+            prefix + "/batch", REPETITIONS, setup, [&]() { scene->SetParent(objects, pool); }, OBJECT_COUNT);
+        if (result)
+        {
+            results.push_back(*result);
+        }
+    }
+}
+
+void RunSpawnBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    constexpr size_t SPAWN_COUNT = 1000;
+
+    for (bool heapComponents : {false, true})
+    {
+        const std::string name = "Scene::Spawn/objects:" + std::to_string(SPAWN_COUNT) +
+                                 (heapComponents ? "/heap-component" : "/stored-component");
+        if (!IsEnabled(name))
+        {
+            continue;
+        }
+
+        // One frame of a spawner: create a wave, destroy it, refresh the transforms. After the calibration
+        // rounds every slab, chunk and vector has reached its size, so the allocation count shows the steady
+        // state
+        eng::Scene scene;
+        eng::GameObject *pool = scene.CreateObject("Pool");
+        const eng::StringId bulletName("Bullet");
+        std::vector<eng::GameObject *> wave;
+        wave.reserve(SPAWN_COUNT);
+        auto result = Measure(
+            name, REPETITIONS,
+            [&]() {
+                eng::ObjectPool::Scope scope(&scene.GetObjectPool());
+                wave.clear();
+                for (size_t i = 0; i < SPAWN_COUNT; ++i)
+                {
+                    eng::GameObject *object = scene.CreateObject(bulletName, pool);
+                    object->SetPosition(glm::vec3(static_cast<float>(i), 0.0f, 0.0f));
+                    if (heapComponents)
+                    {
+                        object->AddComponent(new BenchComponent<0>());
+                    }
+                    else
+                    {
+                        object->AddComponent<BenchComponent<0>>();
+                    }
+                    wave.push_back(object);
+                }
+                scene.DestroyObjects(wave);
+                scene.UpdateWorldTransforms();
+            },
+            SPAWN_COUNT);
+        if (result)
+        {
+            results.push_back(*result);
+        }
+    }
+}
+
+void RunHandleBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    constexpr size_t OBJECT_COUNT = 10000;
+    const std::string prefix = "Scene::Resolve/objects:" + std::to_string(OBJECT_COUNT);
+    if (!IsEnabled(prefix))
+    {
+        return;
+    }
+
+    eng::Scene scene;
+    std::vector<eng::GameObject *> objects;
+    std::vector<eng::ObjectHandle> objectHandles;
+    std::vector<eng::ComponentHandle> componentHandles;
+    for (size_t i = 0; i < OBJECT_COUNT; ++i)
+    {
+        eng::GameObject *object = scene.CreateObject("Object");
+        objects.push_back(object);
+        objectHandles.push_back(object->GetHandle());
+        componentHandles.push_back(object->AddComponent<BenchComponent<0>>()->GetHandle());
+    }
+
+    if (auto result = Measure(
+            prefix + "/raw-pointer", REPETITIONS,
+            [&]() {
+                for (eng::GameObject *object : objects)
+                {
+                    DoNotOptimize(object->IsAlive());
+                }
+            },
+            OBJECT_COUNT))
+    {
+        results.push_back(*result);
+    }
+
+    if (auto result = Measure(
+            prefix + "/ObjectHandle", REPETITIONS,
+            [&]() {
+                for (eng::ObjectHandle handle : objectHandles)
+                {
+                    DoNotOptimize(scene.Resolve(handle));
+                }
+            },
+            OBJECT_COUNT))
+    {
+        results.push_back(*result);
+    }
+
+    if (auto result = Measure(
+            prefix + "/ComponentHandle", REPETITIONS,
+            [&]() {
+                for (const eng::ComponentHandle &handle : componentHandles)
+                {
+                    DoNotOptimize(scene.Resolve<BenchComponent<0>>(handle));
+                }
+            },
+            OBJECT_COUNT))
+    {
+        results.push_back(*result);
+    }
+}
+
+void RunFindByNameBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    constexpr size_t OBJECT_COUNT = 10000;
+    const std::string prefix = "Scene::FindByName/objects:" + std::to_string(OBJECT_COUNT);
+    if (!IsEnabled(prefix))
+    {
+        return;
+    }
+
+    eng::Scene scene;
+    std::vector<eng::GameObject *> objects;
+    for (size_t i = 0; i < OBJECT_COUNT; ++i)
+    {
+        objects.push_back(scene.CreateObject("Object" + std::to_string(i)));
+    }
+    const std::string target = "Object" + std::to_string(OBJECT_COUNT / 2);
+    const eng::StringId targetId(target);
+
+    // What callers had to do before the index: compare the name of every object
+    if (auto result = Measure(prefix + "/linear-walk", REPETITIONS, [&]() {
+            for (eng::GameObject *object : objects)
+            {
+                if (object->GetName() == target)
+                {
+                    DoNotOptimize(object);
+                    break;
+                }
+            }
+        }))
+    {
+        results.push_back(*result);
+    }
+
+    if (auto result = Measure(prefix + "/string", REPETITIONS, [&]() { DoNotOptimize(scene.FindByName(target)); }))
+    {
+        results.push_back(*result);
+    }
+
+    if (auto result =
+            Measure(prefix + "/StringId", REPETITIONS, [&]() { DoNotOptimize(scene.FindByName(targetId)); }))
+    {
+        results.push_back(*result);
+    }
+}
+
+void RunDestroyBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    constexpr size_t OBJECT_COUNT = 100000;
+    constexpr size_t PARENT_COUNT = 100;
+    const std::string prefix = "Scene::DestroyObjects/objects:" + std::to_string(OBJECT_COUNT) + "/destroyed:50%";
+
+    // Every sample rebuilds the scene untimed, then destroys every other object
+    std::unique_ptr<eng::Scene> scene;
+    std::vector<eng::GameObject *> doomed;
+    auto setup = [&]() {
+        scene.reset();
+        scene = std::make_unique<eng::Scene>();
+        doomed.clear();
+        for (size_t p = 0; p < PARENT_COUNT; ++p)
+        {
+            eng::GameObject *parent = scene->CreateObject("Parent");
+            for (size_t i = 0; i < OBJECT_COUNT / PARENT_COUNT; ++i)
+            {
+                eng::GameObject *object = scene->CreateObject("Object", parent);
+                object->AddComponent<BenchComponent<0>>();
+                if (i % 2 == 0)
+                {
+                    doomed.push_back(object);
+                }
+            }
+        }
+    };
+
+    if (IsEnabled(prefix + "/batch"))
+    {
+        auto result = MeasureWithSetup(
+            prefix + "/batch", REPETITIONS / 5, setup, [&]() { scene->DestroyObjects(doomed); }, OBJECT_COUNT / 2);
+        if (result)
+        {
+            results.push_back(*result);
+        }
+    }
+
+    if (IsEnabled(prefix + "/mark-and-update"))
+    {
+        auto result = MeasureWithSetup(
+            prefix + "/mark-and-update", REPETITIONS / 5, setup,
+            [&]() {
+                for (eng::GameObject *object : doomed)
+                {
+                    object->MarkForDestroy();
+                }
+                scene->Update(1.0f / 60.0f);
+            },
+            OBJECT_COUNT / 2);
+        if (result)
+        {
+            results.push_back(*result);
+        }
+    }
+}
+void RunSpatialIndexBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    constexpr size_t OBJECT_COUNT = 100000;
+    constexpr size_t QUERY_COUNT = 100;
+    constexpr float WORLD_SIZE = 1000.0f;
+    const std::string prefix = "Scene::SpatialIndex/objects:" + std::to_string(OBJECT_COUNT);
+    if (!IsEnabled(prefix))
+    {
+        return;
+    }
+
+    // Unit cubes scattered through the world, each drifting at its own velocity
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> position(-0.5f * WORLD_SIZE, 0.5f * WORLD_SIZE);
+    std::uniform_real_distribution<float> speed(-5.0f, 5.0f);
+
+    eng::Scene scene;
+    std::vector<eng::GameObject *> objects;
+    std::vector<glm::vec3> velocities;
+    eng::BoundingBox unitBox;
+    unitBox.min = glm::vec3(-0.5f);
+    unitBox.max = glm::vec3(0.5f);
+    for (size_t i = 0; i < OBJECT_COUNT; ++i)
+    {
+        eng::GameObject *object = scene.CreateObject("Object");
+        object->SetPosition(glm::vec3(position(random), position(random), position(random)));
+        object->SetLocalBounds(unitBox);
+        objects.push_back(object);
+        velocities.emplace_back(speed(random), speed(random), speed(random));
+    }
+    scene.UpdateWorldTransforms();
+
+    std::vector<glm::vec3> queryPoints;
+    for (size_t i = 0; i < QUERY_COUNT; ++i)
+    {
+        queryPoints.emplace_back(position(random), position(random), position(random));
+    }
+
+    // One frame of movement: every object moves, then the index follows the new world transforms
+    if (auto result = Measure(
+            prefix + "/move-all", REPETITIONS / 5,
+            [&]() {
+                for (size_t i = 0; i < OBJECT_COUNT; ++i)
+                {
+                    objects[i]->SetPosition(objects[i]->GetPosition() + velocities[i] * (1.0f / 60.0f));
+                }
+                scene.UpdateWorldTransforms();
+            },
+            OBJECT_COUNT))
+    {
+        results.push_back(*result);
+    }
+
+    std::vector<eng::GameObject *> found;
+    if (auto result = Measure(
+            prefix + "/QueryBox", REPETITIONS,
+            [&]() {
+                for (const glm::vec3 &point : queryPoints)
+                {
+                    eng::BoundingBox box;
+                    box.min = point - glm::vec3(10.0f);
+                    box.max = point + glm::vec3(10.0f);
+                    scene.QueryBox(box, found);
+                    DoNotOptimize(found.size());
+                }
+            },
+            QUERY_COUNT))
+    {
+        results.push_back(*result);
+    }
+
+    if (auto result = Measure(
+            prefix + "/QuerySphere", REPETITIONS,
+            [&]() {
+                for (const glm::vec3 &point : queryPoints)
+                {
+                    scene.QuerySphere({point, 10.0f}, found);
+                    DoNotOptimize(found.size());
+                }
+            },
+            QUERY_COUNT))
+    {
+        results.push_back(*result);
+    }
+
+    // What callers had to do without the index: test the world bounds of every object
+    if (auto result = Measure(
+            prefix + "/QuerySphere/linear-scan", REPETITIONS / 5,
+            [&]() {
+                for (const glm::vec3 &point : queryPoints)
+                {
+                    found.clear();
+                    for (eng::GameObject *object : objects)
+                    {
+                        if (object->GetWorldBounds().DistanceSquared(point) <= 100.0f)
+                        {
+                            found.push_back(object);
+                        }
+                    }
+                    DoNotOptimize(found.size());
+                }
+            },
+            QUERY_COUNT))
+    {
+        results.push_back(*result);
+    }
+
+    // A camera at the edge of the world looking inwards, seeing a few percent of the objects
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 300.0f);
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 0.5f * WORLD_SIZE), glm::vec3(0.0f),
+                                       glm::vec3(0.0f, 1.0f, 0.0f));
+    const eng::Frustum frustum = eng::Frustum::FromMatrix(projection * view);
+    if (auto result = Measure(prefix + "/QueryFrustum", REPETITIONS, [&]() {
+            scene.QueryFrustum(frustum, found);
+            DoNotOptimize(found.size());
+        }))
+    {
+        results.push_back(*result);
+    }
+
+    if (auto result = Measure(
+            prefix + "/RayCast", REPETITIONS,
+            [&]() {
+                for (const glm::vec3 &point : queryPoints)
+                {
+                    DoNotOptimize(scene.RayCast(point, glm::normalize(-point), WORLD_SIZE));
+                }
+            },
+            QUERY_COUNT))
+    {
+        results.push_back(*result);
+    }
+
+    if (auto result = Measure(
+            prefix + "/QueryNearest:8", REPETITIONS,
+            [&]() {
+                for (const glm::vec3 &point : queryPoints)
+                {
+                    scene.QueryNearest(point, 8, found);
+                    DoNotOptimize(found.size());
+                }
+            },
+            QUERY_COUNT))
+    {
+        results.push_back(*result);
+    }
+}
+void RunSpatialGridBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    constexpr size_t OBJECT_COUNT = 200000;
+    constexpr size_t QUERY_COUNT = 1000;
+    constexpr float WORLD_SIZE = 1000.0f;
+    constexpr float QUERY_RADIUS = 2.0f;
+    const std::string prefix = "Scene::SpatialGrid/objects:" + std::to_string(OBJECT_COUNT);
+    if (!IsEnabled(prefix))
+    {
+        return;
+    }
+
+    // A top-down field of small entities, about two units apart on average, each drifting its own way
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> position(-0.5f * WORLD_SIZE, 0.5f * WORLD_SIZE);
+    std::uniform_real_distribution<float> speed(-3.0f, 3.0f);
+
+    eng::Scene scene;
+    scene.GetSpatialGrid().SetCellSize(2.0f * QUERY_RADIUS);
+    std::vector<eng::GameObject *> objects;
+    std::vector<glm::vec3> velocities;
+    for (size_t i = 0; i < OBJECT_COUNT; ++i)
+    {
+        eng::GameObject *object = scene.CreateObject("Entity");
+        object->SetPosition(glm::vec3(position(random), position(random), 0.0f));
+        object->SetInSpatialGrid(true);
+        objects.push_back(object);
+        velocities.emplace_back(speed(random), speed(random), 0.0f);
+    }
+    scene.UpdateWorldTransforms();
+
+    if (auto result = Measure(
+            prefix + "/move-all", REPETITIONS / 5,
+            [&]() {
+                for (size_t i = 0; i < OBJECT_COUNT; ++i)
+                {
+                    objects[i]->SetPosition(objects[i]->GetPosition() + velocities[i] * (1.0f / 60.0f));
+                }
+                scene.UpdateWorldTransforms();
+            },
+            OBJECT_COUNT))
+    {
+        results.push_back(*result);
+    }
+
+    std::vector<glm::vec2> queryPoints;
+    for (size_t i = 0; i < QUERY_COUNT; ++i)
+    {
+        queryPoints.emplace_back(position(random), position(random));
+    }
+
+    if (auto result = Measure(
+            prefix + "/QueryGridRadius", REPETITIONS,
+            [&]() {
+                size_t count = 0;
+                for (const glm::vec2 &point : queryPoints)
+                {
+                    scene.QueryGridRadius(point, QUERY_RADIUS, [&count](eng::GameObject *) {
+                        ++count;
+                        return true;
+                    });
+                }
+                DoNotOptimize(count);
+            },
+            QUERY_COUNT))
+    {
+        results.push_back(*result);
+    }
+
+    if (auto result = Measure(
+            prefix + "/QueryGridRange", REPETITIONS,
+            [&]() {
+                size_t count = 0;
+                for (const glm::vec2 &point : queryPoints)
+                {
+                    scene.QueryGridRange(point - glm::vec2(QUERY_RADIUS), point + glm::vec2(QUERY_RADIUS),
+                                         [&count](eng::GameObject *) {
+                                             ++count;
+                                             return true;
+                                         });
+                }
+                DoNotOptimize(count);
+            },
+            QUERY_COUNT))
+    {
+        results.push_back(*result);
+    }
+
+    // The neighbors of every entity, as a flocking or separation system would gather them each update
+    if (auto result = Measure(
+            prefix + "/QueryGridNeighbors/all", REPETITIONS / 5,
+            [&]() {
+                size_t count = 0;
+                for (eng::GameObject *object : objects)
+                {
+                    scene.QueryGridNeighbors(object, QUERY_RADIUS, [&count](eng::GameObject *) {
+                        ++count;
+                        return true;
+                    });
+                }
+                DoNotOptimize(count);
+            },
+            OBJECT_COUNT))
+    {
+        results.push_back(*result);
+    }
+}
+} // namespace
+
+void RunSceneBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    RunUpdateBenchmarks(results);
+    RunParallelSystemBenchmarks(results);
+    RunEachBenchmarks(results);
+    RunWorldTransformBenchmarks(results);
+    RunTransformStoreBenchmarks(results);
+    RunGetComponentBenchmark<1>(results);
+    RunGetComponentBenchmark<8>(results);
+    RunGetComponentBenchmark<32>(results);
+    RunSetParentBenchmarks(results);
+    RunBulkAttachBenchmarks(results);
+    RunSpawnBenchmarks(results);
+    RunHandleBenchmarks(results);
+    RunFindByNameBenchmarks(results);
+    RunDestroyBenchmarks(results);
+    RunSpatialIndexBenchmarks(results);
+    RunSpatialGridBenchmarks(results);
+}
+} // namespace bench
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include "Benchmark.h"
+#include <Engine.h>
+#include <GL/glew.h>
+#include <iostream>
+#include <render/Material.h>
+#include <render/Mesh.h>
+#include <scene/Scene.h>
+#include <scene/components/CameraComponent.h>
+#include <scene/components/MeshComponent.h>
+#include <scene/components/PlayerControllerComponent.h>
+
+namespace bench
+{
+namespace
+{
+constexpr size_t REPETITIONS = 20;
+const size_t OBJECT_COUNTS[] = {1000, 10000};
+
+/**
+ * @class SpinComponent
+ * @brief Component with a small Update, so the benchmarks measure dispatch and memory access.
+ */
+class SpinComponent : public eng::Component
+{
+    COMPONENT(SpinComponent)
+
+  public:
+    void Update(float deltaTime) override
+    {
+        m_angle += m_speed * deltaTime;
+    }
+
+  private:
+    float m_angle = 0.0f; ///< Accumulated angle.
+    float m_speed = 1.0f; ///< Angular speed.
+};
+
+/**
+ * @brief Measures Scene::Update over one component per object, once through the component systems
+ * (AddComponent<T>) and once through the per-object walk with virtual calls (AddComponent(new T)).
+ * @param afterUpdate Called after every update, e.g. to drop the submitted render commands.
+ */
+template <typename T, typename Create, typename After>
+void RunUpdateComparison(std::vector<BenchmarkResult> &results, const std::string &label, Create create,
+                         After afterUpdate)
+{
+    for (size_t objectCount : OBJECT_COUNTS)
+    {
+        for (bool systems : {true, false})
+        {
+            const std::string name = "Scene::Update/" + label + (systems ? "/systems" : "/tree-walk") +
+                                     "/objects:" + std::to_string(objectCount);
+            if (!IsEnabled(name))
+            {
+                continue;
+            }
+
+            eng::Scene scene;
+            for (size_t i = 0; i < objectCount; ++i)
+            {
+                eng::GameObject *object = scene.CreateObject("Object");
+                if (systems)
+                {
+                    create([&](auto &&...args) { object->AddComponent<T>(args...); });
+                }
+                else
+                {
+                    create([&](auto &&...args) { object->AddComponent(new T(args...)); });
+                }
+            }
+
+            auto result = Measure(
+                name, REPETITIONS,
+                [&]() {
+                    scene.Update(1.0f / 60.0f);
+                    afterUpdate();
+                },
+                objectCount);
+            if (result)
+            {
+                results.push_back(*result);
+            }
+        }
+    }
+}
+
+void RunMeshComponentBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    bool anyEnabled = false;
+    for (size_t objectCount : OBJECT_COUNTS)
+    {
+        for (const char *mode : {"/systems", "/tree-walk"})
+        {
+            anyEnabled = anyEnabled || IsEnabled(std::string("Scene::Update/MeshComponent") + mode + "/objects:" +
+                                                 std::to_string(objectCount));
+        }
+    }
+    if (!anyEnabled)
+    {
+        return;
+    }
+
+    GLFWwindow *window = CreateBenchmarkContext();
+    if (!window)
+    {
+        std::cout << "Scene::Update/MeshComponent skipped: no GL context available" << std::endl;
+        return;
+    }
+
+    {
+        auto &engine = eng::Engine::GetInstance();
+        engine.GetGraphicsAPI().Init();
+
+        eng::VertexLayout layout;
+        layout.elements.push_back({0, 3, GL_FLOAT, 0});
+        layout.stride = sizeof(float) * 3;
+        const std::vector<float> vertices = {-0.01f, -0.01f, 0.0f, 0.01f, -0.01f, 0.0f, 0.0f, 0.01f, 0.0f};
+        const std::vector<uint32_t> indices = {0, 1, 2};
+        auto mesh = std::make_shared<eng::Mesh>(layout, vertices, indices);
+        auto material = std::make_shared<eng::Material>();
+
+        auto &renderQueue = engine.GetRenderQueue();
+        RunUpdateComparison<eng::MeshComponent>(
+            results, "MeshComponent", [&](auto add) { add(material, mesh); }, [&]() { renderQueue.Clear(); });
+    }
+
+    DestroyBenchmarkContext(window);
+}
+} // namespace
+
+void RunSystemBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    auto noArguments = [](auto add) { add(); };
+    auto nothing = []() {};
+
+    RunUpdateComparison<SpinComponent>(results, "SpinComponent", noArguments, nothing);
+    RunUpdateComparison<eng::PlayerControllerComponent>(results, "PlayerControllerComponent", noArguments, nothing);
+
+    // The camera has no Update: its system does not exist, while the walk still makes one virtual call each
+    RunUpdateComparison<eng::CameraComponent>(results, "CameraComponent", noArguments, nothing);
+
+    RunMeshComponentBenchmarks(results);
+}
+} // namespace bench
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include "Benchmark.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+void PrintUsage(const char *executable)
+{
+    std::cout << "Usage: " << executable << " [options]\n"
+              << "  --json <file>       Write the results as JSON\n"
+              << "  --filter <text>     Only run benchmarks whose name contains text\n"
+              << "  --repetitions <n>   Timed samples per benchmark (overrides the defaults)\n"
+              << "  --min-time <ms>     Minimum duration of one sample (default 5)" << std::endl;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    bench::BenchmarkOptions options;
+    std::string jsonPath;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (std::strcmp(arg, "--json") == 0 && value)
+        {
+            jsonPath = value;
+            ++i;
+        }
+        else if (std::strcmp(arg, "--filter") == 0 && value)
+        {
+            options.filter = value;
+            ++i;
+        }
+        else if (std::strcmp(arg, "--repetitions") == 0 && value)
+        {
+            options.repetitions = std::strtoul(value, nullptr, 10);
+            ++i;
+        }
+        else if (std::strcmp(arg, "--min-time") == 0 && value)
+        {
+            options.minSampleMs = std::strtod(value, nullptr);
+            ++i;
+        }
+        else
+        {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    bench::SetOptions(options);
+
+    std::vector<bench::BenchmarkResult> results;
+
+    bench::RunJobSystemBenchmarks(results);
+    bench::RunSceneBenchmarks(results);
+    bench::RunSystemBenchmarks(results);
+    bench::RunRenderQueueBenchmarks(results);
+
+    if (!jsonPath.empty())
+    {
+        if (!bench::WriteJson(jsonPath, results))
+        {
+            std::cerr << "Failed to write " << jsonPath << std::endl;
+            return 1;
+        }
+        std::cout << "Wrote " << results.size() << " results to " << jsonPath << std::endl;
+    }
+
+    return 0;
+}
\ No newline at end of file
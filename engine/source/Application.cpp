@@ -2,6 +2,18 @@
 
 namespace eng
 {
+void Application::FixedUpdate(float)
+{
+}
+
+void Application::LateUpdate(float)
+{
+}
+
+void Application::BuildFrameGraph(TaskGraph &)
+{
+}
+
 void Application::SetNeedsToBeClosed(bool value)
 {
     m_needsToBeClosed = value;
@@ -2,6 +2,8 @@
 
 namespace eng
 {
+class TaskGraph;
+
 /**
  * @class Application
  * @brief Base class for all engine-based applications.
@@ -20,12 +22,40 @@ class Application
      */
     [[nodiscard]] virtual bool Init() = 0;
 
+    /**
+     * @brief Called zero or more times per frame at the engine's fixed tick rate, before Update.
+     * @param fixedDeltaTime The duration of one fixed step in seconds.
+     */
+    virtual void FixedUpdate(float fixedDeltaTime);
+
     /**
      * @brief Pure virtual function for the application update loop.
      * @param deltaTime The time since the last frame in seconds.
      */
     virtual void Update(float deltaTime) = 0;
 
+    /**
+     * @brief Called once per frame after Update, before rendering.
+     * @param deltaTime The time since the last frame in seconds.
+     */
+    virtual void LateUpdate(float deltaTime);
+
+    /**
+     * @brief Called once after a successful Init() to add application tasks to the engine's frame graph.
+     *
+     * The engine's own tasks are "Input", "FixedUpdate", "Update", "LateUpdate", "TransformPropagation",
+     * "Camera", "Culling", "RenderCommandBuild", "RenderSubmit" and "InputEndFrame"; find them with
+     * TaskGraph::FindTask() to order new tasks against them.
+     *
+     * A task runs at the same time as every task it is not ordered against, possibly on another thread.
+     * "TransformPropagation" rewrites the world transforms, the spatial index and the spatial grid, so a task
+     * that touches the scene must either finish before it or start after it. "Culling" and
+     * "RenderCommandBuild" read the render queue's submit frame, so tasks that submit render commands or set
+     * the camera must finish before "Culling".
+     * @param graph The frame graph, run once per frame.
+     */
+    virtual void BuildFrameGraph(TaskGraph &graph);
+
     /**
      * @brief Pure virtual function for application cleanup.
      */
@@ -1,10 +1,14 @@
 #include "Engine.h"
 #include "Application.h"
+#include "profiling/Profiler.h"
 #include "scene/Component.h"
 #include "scene/GameObject.h"
 #include "scene/components/CameraComponent.h"
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
 #include <iostream>
 #include <utility>
 
@@ -46,6 +50,11 @@ void cursorPositionCallback(GLFWwindow *window, double xpos, double ypos)
     inputManager.SetMousePositionCurrent(currentPos);
 }
 
+void errorCallback(int errorCode, const char *description)
+{
+    std::cerr << "GLFW error " << errorCode << ": " << description << std::endl;
+}
+
 Engine &Engine::GetInstance()
 {
     static Engine instance;
@@ -53,14 +62,38 @@ Engine &Engine::GetInstance()
 }
 
 bool Engine::Init(int width, int height)
+{
+    EngineInitOptions options;
+    options.width = width;
+    options.height = height;
+    return Init(options);
+}
+
+bool Engine::Init(const EngineInitOptions &options)
 {
     if (!m_application)
     {
         return false;
     }
 
+    m_initOptions = options;
+
+    ENG_PROFILE_THREAD("Main");
+    m_jobSystem.Init(m_initOptions.workerThreads);
+    m_graphicsAPI.GetGpuProfiler().SetReportInterval(m_initOptions.gpuReportInterval);
+
+    glfwSetErrorCallback(errorCallback);
+
+    if (m_initOptions.headless)
+    {
+        // The null platform needs no display server; the context is rendered offscreen by OSMesa.
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    }
 #if defined(__linux__)
-    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_X11);
+    else
+    {
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_X11);
+    }
 #endif
 
     if (!glfwInit())
@@ -72,7 +105,13 @@ bool Engine::Init(int width, int height)
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
-    m_window = glfwCreateWindow(width, height, "DefinEngine", nullptr, nullptr);
+    if (m_initOptions.headless)
+    {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+    }
+
+    m_window = glfwCreateWindow(m_initOptions.width, m_initOptions.height, "DefinEngine", nullptr, nullptr);
 
     if (m_window == nullptr)
     {
@@ -94,8 +133,45 @@ bool Engine::Init(int width, int height)
         return false;
     }
 
-    m_graphicsAPI.Init();
-    return m_application->Init();
+    if (m_initOptions.threadedRendering)
+    {
+        // The render thread takes over the window's context. The main thread keeps a hidden context
+        // sharing its objects, so applications can keep creating meshes and shaders from Init/Update.
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        m_uploadWindow = glfwCreateWindow(1, 1, "DefinEngine Upload", nullptr, m_window);
+        if (m_uploadWindow == nullptr)
+        {
+            std::cout << "Error creating upload context, falling back to single-threaded rendering" << std::endl;
+            m_initOptions.threadedRendering = false;
+        }
+    }
+
+    if (m_initOptions.threadedRendering)
+    {
+        glfwMakeContextCurrent(m_uploadWindow);
+        m_renderThread.Start(
+            m_window,
+            [this]() {
+                ENG_PROFILE_THREAD("Render");
+                m_graphicsAPI.Init();
+            },
+            [this]() { RenderFrame(); });
+    }
+    else
+    {
+        m_graphicsAPI.Init();
+    }
+
+    if (!m_application->Init())
+    {
+        return false;
+    }
+
+    if (m_frameGraph.GetTaskCount() == 0)
+    {
+        BuildFrameGraph();
+    }
+    return true;
 }
 
 void Engine::Run()
@@ -105,60 +181,326 @@ void Engine::Run()
         return;
     }
 
-    m_lastTimePoint = std::chrono::steady_clock::now();
+    m_frameCount = 0;
+    m_simulatedTime = 0.0;
+    m_fixedAccumulator = 0.0f;
+    m_frameTimes.clear();
+    m_frameTimes.reserve(m_initOptions.maxFrames);
+
+    const auto startTimePoint = std::chrono::steady_clock::now();
+    m_lastTimePoint = startTimePoint;
 
-    while (!glfwWindowShouldClose(m_window) && !m_application->NeedsToBeClosed())
+    while (!glfwWindowShouldClose(m_window) && !m_application->NeedsToBeClosed() && !IsRunLimitReached())
     {
-        glfwPollEvents();
+        ENG_PROFILE_SCOPE("Engine::Run::Frame");
 
         auto now = std::chrono::steady_clock::now();
-        float deltaTime = std::chrono::duration<float>(now - m_lastTimePoint).count();
+        float wallDeltaTime = std::chrono::duration<float>(now - m_lastTimePoint).count();
         m_lastTimePoint = now;
 
-        m_application->Update(deltaTime);
+        if (m_frameCount > 0)
+        {
+            m_frameTimes.push_back(wallDeltaTime);
+        }
 
-        m_graphicsAPI.SetClearColor(1.0f, 1.0f, 1.0f, 1.0f);
-        m_graphicsAPI.ClearBuffers();
+        m_deltaTime = m_initOptions.simulatedDeltaTime > 0.0f ? m_initOptions.simulatedDeltaTime : wallDeltaTime;
+        m_simulatedTime += m_deltaTime;
+        ++m_frameCount;
 
-        CameraData cameraData;
-        cameraData.viewMatrix = glm::mat4(1.0f);
-        cameraData.projectionMatrix = glm::mat4(1.0f);
+        m_frameGraph.Run(m_jobSystem);
+        ENG_PROFILE_COUNTER("Engine::FrameGraph::CriticalPathMs", m_frameGraph.GetCriticalPathMs());
 
-        int width = 0;
-        int height = 0;
-        glfwGetWindowSize(m_window, &width, &height);
-        float aspect = (height > 0) ? static_cast<float>(width) / static_cast<float>(height) : 1.0f;
+        ENG_PROFILE_FRAME();
+    }
 
+    if (m_renderThread.IsRunning())
+    {
+        m_renderThread.Wait();
+        if (m_frameCount > 0)
+        {
+            m_graphicsAPI.EndStatsFrame(static_cast<uint32_t>(m_renderQueue.GetDrawCommandCount()));
+        }
+    }
+
+    auto endTimePoint = std::chrono::steady_clock::now();
+    if (m_frameCount > 0)
+    {
+        m_frameTimes.push_back(std::chrono::duration<float>(endTimePoint - m_lastTimePoint).count());
+    }
+
+    PrintTimingSummary(std::chrono::duration<double>(endTimePoint - startTimePoint).count());
+}
+
+void Engine::BuildFrameGraph()
+{
+    auto &graph = m_frameGraph;
+    const TaskId input = graph.AddTask(StringId("Input"), [this]() { PollInput(); }, TaskAffinity::MainThread);
+    const TaskId fixedUpdate =
+        graph.AddTask(StringId("FixedUpdate"), [this]() { RunFixedSteps(); }, TaskAffinity::MainThread);
+    const TaskId update = graph.AddTask(
+        StringId("Update"), [this]() { m_application->Update(m_deltaTime); }, TaskAffinity::MainThread);
+    const TaskId lateUpdate = graph.AddTask(
+        StringId("LateUpdate"), [this]() { m_application->LateUpdate(m_deltaTime); }, TaskAffinity::MainThread);
+    const TaskId transformPropagation = graph.AddTask(StringId("TransformPropagation"), [this]() {
         if (m_currentScene)
         {
-            if (auto cameraObject = m_currentScene->GetMainCamera())
+            m_currentScene->UpdateWorldTransforms();
+        }
+    });
+    const TaskId camera = graph.AddTask(StringId("Camera"), [this]() { UpdateCamera(); });
+    const TaskId culling = graph.AddTask(StringId("Culling"), [this]() { m_renderQueue.Cull(); });
+    const TaskId commandBuild =
+        graph.AddTask(StringId("RenderCommandBuild"), [this]() { m_renderQueue.BuildCommands(); });
+    const TaskId renderSubmit =
+        graph.AddTask(StringId("RenderSubmit"), [this]() { SubmitFrame(); }, TaskAffinity::MainThread);
+    const TaskId inputEndFrame = graph.AddTask(StringId("InputEndFrame"), [this]() {
+        m_inputManager.SetMousePositionOld(m_inputManager.GetMousePositionCurrent());
+    });
+
+    graph.AddDependency(input, fixedUpdate);
+    graph.AddDependency(fixedUpdate, update);
+    graph.AddDependency(update, lateUpdate);
+    graph.AddDependency(lateUpdate, transformPropagation);
+    graph.AddDependency(lateUpdate, inputEndFrame);
+    graph.AddDependency(transformPropagation, camera);
+    graph.AddDependency(transformPropagation, culling);
+    graph.AddDependency(camera, culling);
+    graph.AddDependency(culling, commandBuild);
+    graph.AddDependency(commandBuild, renderSubmit);
+
+    m_application->BuildFrameGraph(graph);
+}
+
+void Engine::PollInput()
+{
+    glfwPollEvents();
+
+    int width = 0;
+    int height = 0;
+    glfwGetWindowSize(m_window, &width, &height);
+    m_aspectRatio = (height > 0) ? static_cast<float>(width) / static_cast<float>(height) : 1.0f;
+}
+
+void Engine::RunFixedSteps()
+{
+    float fixedDeltaTime = GetFixedDeltaTime();
+    if (fixedDeltaTime <= 0.0f)
+    {
+        m_interpolationAlpha = 1.0f;
+        return;
+    }
+
+    m_fixedAccumulator += m_deltaTime;
+
+    uint32_t subSteps = 0;
+    while (m_fixedAccumulator >= fixedDeltaTime && subSteps < m_initOptions.maxSubSteps)
+    {
+        ENG_PROFILE_SCOPE("Application::FixedUpdate");
+        m_application->FixedUpdate(fixedDeltaTime);
+        m_fixedAccumulator -= fixedDeltaTime;
+        ++subSteps;
+    }
+
+    // Too far behind: drop the remaining whole steps instead of trying to catch up next frame
+    if (m_fixedAccumulator >= fixedDeltaTime)
+    {
+        m_fixedAccumulator = std::fmod(m_fixedAccumulator, fixedDeltaTime);
+    }
+
+    m_interpolationAlpha = m_fixedAccumulator / fixedDeltaTime;
+}
+
+void Engine::UpdateCamera()
+{
+    CameraData cameraData;
+    cameraData.viewMatrix = glm::mat4(1.0f);
+    cameraData.projectionMatrix = glm::mat4(1.0f);
+
+    if (m_currentScene)
+    {
+        if (auto cameraObject = m_currentScene->GetMainCamera())
+        {
+            auto cameraComponent = cameraObject->GetComponent<CameraComponent>();
+            if (cameraComponent)
             {
-                // logic for matrices
-                auto cameraComponent = cameraObject->GetComponent<CameraComponent>();
-                if (cameraComponent)
-                {
-                    cameraData.viewMatrix = cameraComponent->GetViewMatrix();
-                    cameraData.projectionMatrix = cameraComponent->GetProjectionMatrix(aspect);
-                }
+                cameraData.viewMatrix = cameraComponent->GetViewMatrix();
+                cameraData.projectionMatrix = cameraComponent->GetProjectionMatrix(m_aspectRatio);
             }
         }
+    }
 
-        m_renderQueue.Draw(m_graphicsAPI, cameraData);
+    m_renderQueue.SetCameraData(cameraData);
+}
 
-        glfwSwapBuffers(m_window);
+void Engine::SubmitFrame()
+{
+    if (m_renderThread.IsRunning())
+    {
+        // Frame N is drawn while the next iteration simulates frame N + 1
+        {
+            ENG_PROFILE_SCOPE("Engine::Run::WaitForRenderThread");
+            m_renderThread.Wait();
+        }
+        if (m_frameCount > 1)
+        {
+            m_graphicsAPI.EndStatsFrame(static_cast<uint32_t>(m_renderQueue.GetDrawCommandCount()));
+        }
+        m_renderQueue.Flip();
 
-        m_inputManager.SetMousePositionOld(m_inputManager.GetMousePositionCurrent());
+        // A flush only submits this context's uploads; the render thread's context waits on the fence before
+        // drawing, so it sees every buffer, texture and shader finished up to here
+        m_uploadFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush();
+        m_renderThread.Kick();
+    }
+    else
+    {
+        m_renderQueue.Flip();
+        RenderFrame();
+        m_graphicsAPI.EndStatsFrame(static_cast<uint32_t>(m_renderQueue.GetDrawCommandCount()));
+    }
+}
+
+void Engine::RenderFrame()
+{
+    ENG_PROFILE_SCOPE("Engine::RenderFrame");
+
+    if (m_uploadFence)
+    {
+        glWaitSync(m_uploadFence, 0, GL_TIMEOUT_IGNORED);
+        glDeleteSync(m_uploadFence);
+        m_uploadFence = nullptr;
+    }
+
+    auto &gpuProfiler = m_graphicsAPI.GetGpuProfiler();
+    gpuProfiler.BeginFrame();
+
+    m_graphicsAPI.SetClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+    m_graphicsAPI.ClearBuffers();
+
+    m_renderQueue.Draw(m_graphicsAPI);
+
+    gpuProfiler.EndFrame();
+
+    ENG_PROFILE_SCOPE("Engine::RenderFrame::SwapBuffers");
+    glfwSwapBuffers(m_window);
+}
+
+bool Engine::IsRunLimitReached() const
+{
+    if (m_initOptions.maxFrames > 0 && m_frameCount >= m_initOptions.maxFrames)
+    {
+        return true;
+    }
+
+    if (m_initOptions.maxSimulatedTime > 0.0f && m_simulatedTime >= m_initOptions.maxSimulatedTime)
+    {
+        return true;
+    }
+
+    return false;
+}
+
+void Engine::PrintTimingSummary(double wallTime) const
+{
+    std::cout << "Frames: " << m_frameCount << ", wall time: " << wallTime << " s, simulated time: " << m_simulatedTime
+              << " s" << std::endl;
+
+    if (m_frameTimes.empty())
+    {
+        return;
+    }
+
+    std::vector<float> sorted = m_frameTimes;
+    std::sort(sorted.begin(), sorted.end());
+
+    double total = 0.0;
+    for (float frameTime : sorted)
+    {
+        total += frameTime;
+    }
+
+    auto percentile = [&sorted](double p) {
+        size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+        return sorted[index] * 1000.0f;
+    };
+
+    double averageMs = total * 1000.0 / static_cast<double>(sorted.size());
+
+    std::cout << std::fixed << std::setprecision(3) << "Frame time (ms): avg " << averageMs << ", min "
+              << sorted.front() * 1000.0f << ", p50 " << percentile(0.50) << ", p95 " << percentile(0.95) << ", p99 "
+              << percentile(0.99) << ", max " << sorted.back() * 1000.0f << ", fps "
+              << (averageMs > 0.0 ? 1000.0 / averageMs : 0.0) << std::defaultfloat << std::endl;
+
+    const auto &statsHistory = m_graphicsAPI.GetRenderStatsHistory();
+    const RenderStats averageStats = statsHistory.GetAverage();
+    const RenderStats maxStats = statsHistory.GetMax();
+    std::cout << "Render stats (avg/max per frame over last " << statsHistory.GetSize() << " frames): draws "
+              << averageStats.drawCalls << "/" << maxStats.drawCalls << ", triangles " << averageStats.triangles << "/"
+              << maxStats.triangles << ", program binds " << averageStats.programBinds << "/" << maxStats.programBinds
+              << ", VAO binds " << averageStats.vertexArrayBinds << "/" << maxStats.vertexArrayBinds << ", uniforms "
+              << averageStats.uniformUploads << "/" << maxStats.uniformUploads << ", uploaded bytes "
+              << averageStats.bufferBytesUploaded << "/" << maxStats.bufferBytesUploaded << ", commands "
+              << averageStats.commandsSubmitted << "/" << maxStats.commandsSubmitted << ", visible "
+              << averageStats.commandsVisible << "/" << maxStats.commandsVisible << ", culled "
+              << averageStats.commandsCulled << "/" << maxStats.commandsCulled << ", too small "
+              << averageStats.commandsTooSmall << "/" << maxStats.commandsTooSmall << ", triangles saved by LOD "
+              << averageStats.trianglesSaved << "/" << maxStats.trianglesSaved << std::endl;
+
+    for (const auto &pass : m_graphicsAPI.GetGpuProfiler().GetPassTimings())
+    {
+        std::cout << std::fixed << std::setprecision(3) << "GPU pass " << pass.name << " (ms): avg " << pass.averageMs
+                  << ", last " << pass.lastMs << ", samples " << pass.samples << std::defaultfloat << std::endl;
+    }
+
+    const uint32_t graphRuns = m_frameGraph.GetRunCount();
+    if (graphRuns == 0)
+    {
+        return;
+    }
+
+    // Work well above the critical path means the frame has parallelism; the path itself bounds the frame time
+    const double runs = static_cast<double>(graphRuns);
+    std::cout << std::fixed << std::setprecision(3) << "Frame graph (ms, avg per frame): critical path "
+              << m_frameGraph.GetTotalCriticalPathMs() / runs << ", work " << m_frameGraph.GetTotalWorkMs() / runs
+              << std::defaultfloat << std::endl;
+    for (TaskId task = 0; task < m_frameGraph.GetTaskCount(); ++task)
+    {
+        const TaskStats &stats = m_frameGraph.GetTaskStats(task);
+        std::cout << std::fixed << std::setprecision(3) << "Frame task " << m_frameGraph.GetTaskName(task).GetString()
+                  << " (ms): avg " << stats.totalMs / runs << ", on critical path "
+                  << 100.0 * static_cast<double>(stats.criticalPathRuns) / runs << "%" << std::defaultfloat
+                  << std::endl;
     }
 }
 
 void Engine::Destroy()
 {
+    m_renderThread.Stop();
+
+#if ENG_PROFILER_ENABLED
+    if (!m_initOptions.traceOutputPath.empty())
+    {
+        if (Profiler::WriteChromeTrace(m_initOptions.traceOutputPath))
+        {
+            std::cout << "Wrote profiler trace to " << m_initOptions.traceOutputPath << std::endl;
+        }
+        else
+        {
+            std::cerr << "Failed to write profiler trace to " << m_initOptions.traceOutputPath << std::endl;
+        }
+    }
+#endif
+
     if (m_application)
     {
         m_application->Destroy();
         m_application.reset();
+        m_renderQueue.Clear();
+        m_jobSystem.Shutdown();
         glfwTerminate();
         m_window = nullptr;
+        m_uploadWindow = nullptr;
     }
 }
 
@@ -182,6 +524,11 @@ GraphicsAPI &Engine::GetGraphicsAPI()
     return m_graphicsAPI;
 }
 
+JobSystem &Engine::GetJobSystem()
+{
+    return m_jobSystem;
+}
+
 RenderQueue &Engine::GetRenderQueue()
 {
     return m_renderQueue;
@@ -190,10 +537,44 @@ RenderQueue &Engine::GetRenderQueue()
 void Engine::SetScene(std::unique_ptr<Scene> scene)
 {
     m_currentScene = std::move(scene);
+    if (m_currentScene)
+    {
+        m_currentScene->SetJobSystem(&m_jobSystem);
+    }
 }
 
 Scene *Engine::GetScene()
 {
     return m_currentScene.get();
 }
+
+void Engine::SetFixedTickRate(float ticksPerSecond)
+{
+    m_initOptions.fixedTickRate = ticksPerSecond > 0.0f ? ticksPerSecond : 0.0f;
+}
+
+void Engine::SetMaxSubSteps(uint32_t maxSubSteps)
+{
+    m_initOptions.maxSubSteps = maxSubSteps;
+}
+
+float Engine::GetFixedDeltaTime() const
+{
+    return m_initOptions.fixedTickRate > 0.0f ? 1.0f / m_initOptions.fixedTickRate : 0.0f;
+}
+
+float Engine::GetInterpolationAlpha() const
+{
+    return m_interpolationAlpha;
+}
+
+TaskGraph &Engine::GetFrameGraph()
+{
+    return m_frameGraph;
+}
+
+const EngineInitOptions &Engine::GetInitOptions() const
+{
+    return m_initOptions;
+}
 } // namespace eng
\ No newline at end of file
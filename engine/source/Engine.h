@@ -1,16 +1,45 @@
 #pragma once
 #include "graphics/GraphicsAPI.h"
 #include "input/InputManager.h"
+#include "jobs/JobSystem.h"
+#include "jobs/TaskGraph.h"
 #include "render/RenderQueue.h"
+#include "render/RenderThread.h"
 #include "scene/Scene.h"
 #include <chrono>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 
 struct GLFWwindow;
 namespace eng
 {
 class Application;
 
+/**
+ * @struct EngineInitOptions
+ * @brief Options controlling how the engine creates its context and how long Run() keeps going.
+ */
+struct EngineInitOptions
+{
+    static constexpr int DEFAULT_WIDTH = 1280;
+    static constexpr int DEFAULT_HEIGHT = 720;
+
+    int width = DEFAULT_WIDTH;       ///< Width of the window (or of the offscreen framebuffer when headless).
+    int height = DEFAULT_HEIGHT;     ///< Height of the window (or of the offscreen framebuffer when headless).
+    bool headless = false;           ///< Use the GLFW null platform with an offscreen OSMesa context.
+    uint32_t maxFrames = 0;          ///< Stop Run() after this many frames (0 means no limit).
+    float maxSimulatedTime = 0.0f;   ///< Stop Run() after this much simulated time in seconds (0 means no limit).
+    float simulatedDeltaTime = 0.0f; ///< If > 0, every frame advances by this step instead of the wall clock.
+    float fixedTickRate = 60.0f;     ///< Rate of Application::FixedUpdate in Hz (0 disables fixed steps).
+    uint32_t maxSubSteps = 5;        ///< Maximum fixed steps run per frame; older backlog is dropped.
+    bool threadedRendering = true;   ///< Draw on a dedicated render thread; false renders on the main thread.
+    int workerThreads = -1;          ///< Job system workers (-1 means one less than the hardware threads).
+    std::string traceOutputPath;     ///< Profiler builds write a Chrome trace here on Destroy() (empty = off).
+    float gpuReportInterval = 0.0f;  ///< Seconds between printed GPU pass timings (0 means only at exit).
+};
+
 /**
  * @class Engine
  * @brief The core engine class managing subsystems and the application lifecycle.
@@ -41,8 +70,18 @@ class Engine
      */
     bool Init(int width, int height);
 
+    /**
+     * @brief Initializes the engine and its subsystems with explicit options.
+     * @param options Window, headless and run-limit options.
+     * @return true if initialization was successful, false otherwise.
+     */
+    bool Init(const EngineInitOptions &options);
+
     /**
      * @brief Runs the main engine loop.
+     *
+     * The loop ends when the window is closed, the application requests it, or one of the
+     * run limits from EngineInitOptions is reached. A timing summary is printed on exit.
      */
     void Run();
 
@@ -75,6 +114,12 @@ class Engine
      */
     GraphicsAPI &GetGraphicsAPI();
 
+    /**
+     * @brief Gets the job system shared by all engine subsystems.
+     * @return Reference to the job system.
+     */
+    JobSystem &GetJobSystem();
+
     /**
      * @brief Gets the render queue.
      * @return Reference to the render queue.
@@ -82,7 +127,7 @@ class Engine
     RenderQueue &GetRenderQueue();
 
     /**
-     * @brief Sets the current scene.
+     * @brief Sets the current scene, which runs its component systems on the engine's job system.
      * @param scene Pointer to the scene.
      */
     void SetScene(std::unique_ptr<Scene> scene);
@@ -93,13 +138,109 @@ class Engine
      */
     Scene *GetScene();
 
+    /**
+     * @brief Changes the rate at which Application::FixedUpdate is called.
+     * @param ticksPerSecond The new tick rate in Hz, or 0 to disable fixed steps.
+     */
+    void SetFixedTickRate(float ticksPerSecond);
+
+    /**
+     * @brief Sets the maximum number of fixed steps run per frame.
+     * @param maxSubSteps The new clamp. Time beyond it is dropped to avoid a spiral of death.
+     */
+    void SetMaxSubSteps(uint32_t maxSubSteps);
+
+    /**
+     * @brief Gets the duration of a single fixed step.
+     * @return The fixed delta time in seconds, or 0 if fixed steps are disabled.
+     */
+    [[nodiscard]] float GetFixedDeltaTime() const;
+
+    /**
+     * @brief Gets how far the current frame lies between the last two fixed steps.
+     * @return A value in [0, 1) used to interpolate transforms for rendering.
+     */
+    [[nodiscard]] float GetInterpolationAlpha() const;
+
+    /**
+     * @brief Gets the graph of tasks run every frame.
+     * @return Reference to the frame graph.
+     */
+    TaskGraph &GetFrameGraph();
+
+    /**
+     * @brief Gets the options the engine was initialized with.
+     * @return Reference to the init options.
+     */
+    [[nodiscard]] const EngineInitOptions &GetInitOptions() const;
+
+  private:
+    /**
+     * @brief Adds the engine's per-frame tasks to the frame graph, then lets the application add its own.
+     */
+    void BuildFrameGraph();
+
+    /**
+     * @brief Processes window events and reads the window's aspect ratio.
+     */
+    void PollInput();
+
+    /**
+     * @brief Runs the fixed steps the frame's delta time has accumulated and updates the interpolation alpha.
+     */
+    void RunFixedSteps();
+
+    /**
+     * @brief Hands the main camera's matrices to the render queue.
+     */
+    void UpdateCamera();
+
+    /**
+     * @brief Passes the recorded frame to the render thread, or draws it on the main thread.
+     *
+     * Before a kick, a fence is inserted after the main thread's uploads for RenderFrame() to wait on.
+     */
+    void SubmitFrame();
+
+    /**
+     * @brief Clears the framebuffer, draws the flipped render queue frame and presents it.
+     *
+     * Runs on the render thread when threaded rendering is enabled, otherwise on the main thread.
+     */
+    void RenderFrame();
+
+    /**
+     * @brief Checks whether one of the configured run limits has been reached.
+     * @return true if Run() should stop.
+     */
+    [[nodiscard]] bool IsRunLimitReached() const;
+
+    /**
+     * @brief Prints frame count, wall/simulated time and frame time percentiles to stdout.
+     * @param wallTime Total wall clock time spent in Run() in seconds.
+     */
+    void PrintTimingSummary(double wallTime) const;
+
   private:
     std::unique_ptr<Application> m_application;            ///< The managed application instance.
     std::chrono::steady_clock::time_point m_lastTimePoint; ///< Timestamp of the last frame.
+    EngineInitOptions m_initOptions;                       ///< Options passed to Init().
+    uint32_t m_frameCount = 0;                             ///< Number of frames run so far.
+    double m_simulatedTime = 0.0;                          ///< Total simulated time in seconds.
+    std::vector<float> m_frameTimes;                       ///< Wall clock duration of every frame in seconds.
+    float m_fixedAccumulator = 0.0f;                       ///< Time not yet consumed by fixed steps.
+    float m_interpolationAlpha = 1.0f;                     ///< Blend factor between the last two fixed steps.
+    float m_deltaTime = 0.0f;                              ///< Delta time of the current frame in seconds.
+    float m_aspectRatio = 1.0f;                            ///< Aspect ratio of the window this frame.
+    TaskGraph m_frameGraph;                                ///< Tasks run every frame.
     GLFWwindow *m_window = nullptr;                        ///< Pointer to the GLFW window.
+    GLFWwindow *m_uploadWindow = nullptr;                  ///< Hidden window sharing objects with m_window.
+    GLsync m_uploadFence = nullptr;                        ///< Uploads of the kicked frame, waited on by RenderFrame().
     InputManager m_inputManager;                           ///< The input manager subsystem.
     GraphicsAPI m_graphicsAPI;                             ///< The graphics API subsystem.
+    JobSystem m_jobSystem;                                 ///< The work-stealing job system.
     RenderQueue m_renderQueue;                             ///< The rendering queue.
+    RenderThread m_renderThread;                           ///< Thread owning m_window's context, if threaded.
     std::unique_ptr<Scene> m_currentScene;                 ///< The current scene.
 };
 } // namespace eng
\ No newline at end of file
@@ -0,0 +1,181 @@
+#include "core/Bounds.h"
+#include <algorithm>
+#include <cmath>
+#include <glm/glm.hpp>
+#include <utility>
+
+namespace eng
+{
+bool BoundingBox::IsValid() const
+{
+    return min.x <= max.x && min.y <= max.y && min.z <= max.z;
+}
+
+glm::vec3 BoundingBox::GetCenter() const
+{
+    return (min + max) * 0.5f;
+}
+
+glm::vec3 BoundingBox::GetExtents() const
+{
+    return (max - min) * 0.5f;
+}
+
+void BoundingBox::Expand(const glm::vec3 &point)
+{
+    min = glm::min(min, point);
+    max = glm::max(max, point);
+}
+
+void BoundingBox::Expand(const BoundingBox &other)
+{
+    min = glm::min(min, other.min);
+    max = glm::max(max, other.max);
+}
+
+bool BoundingBox::Overlaps(const BoundingBox &other) const
+{
+    return min.x <= other.max.x && max.x >= other.min.x && min.y <= other.max.y && max.y >= other.min.y &&
+           min.z <= other.max.z && max.z >= other.min.z;
+}
+
+bool BoundingBox::Contains(const BoundingBox &other) const
+{
+    return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z && max.x >= other.max.x &&
+           max.y >= other.max.y && max.z >= other.max.z;
+}
+
+float BoundingBox::DistanceSquared(const glm::vec3 &point) const
+{
+    const glm::vec3 offset = glm::max(min - point, glm::vec3(0.0f)) + glm::max(point - max, glm::vec3(0.0f));
+    return glm::dot(offset, offset);
+}
+
+bool BoundingBox::IntersectsRay(const glm::vec3 &origin, const glm::vec3 &inverseDirection, float maxDistance,
+                                float &outDistance) const
+{
+    // Slab test: the ray is inside the box where it is between the planes of all three axes
+    float entry = 0.0f;
+    float exit = maxDistance;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        float slabEntry = (min[axis] - origin[axis]) * inverseDirection[axis];
+        float slabExit = (max[axis] - origin[axis]) * inverseDirection[axis];
+        if (slabEntry > slabExit)
+        {
+            std::swap(slabEntry, slabExit);
+        }
+
+        // Written so NaN from 0 * infinity (a ray in the plane of a face) leaves the interval unchanged
+        entry = slabEntry > entry ? slabEntry : entry;
+        exit = slabExit < exit ? slabExit : exit;
+        if (entry > exit)
+        {
+            return false;
+        }
+    }
+
+    outDistance = entry;
+    return true;
+}
+
+BoundingBox BoundingBox::Transform(const glm::mat4 &matrix) const
+{
+    if (!IsValid())
+    {
+        return *this;
+    }
+
+    // Transform the center, then project the extents onto each world axis through the absolute matrix
+    const glm::vec3 center = glm::vec3(matrix * glm::vec4(GetCenter(), 1.0f));
+    const glm::vec3 extents = GetExtents();
+    glm::vec3 worldExtents(0.0f);
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        worldExtents += glm::abs(glm::vec3(matrix[axis])) * extents[axis];
+    }
+
+    BoundingBox box;
+    box.min = center - worldExtents;
+    box.max = center + worldExtents;
+    return box;
+}
+
+bool BoundingSphere::IsValid() const
+{
+    return radius >= 0.0f;
+}
+
+BoundingSphere BoundingSphere::Transform(const glm::mat4 &matrix) const
+{
+    if (!IsValid())
+    {
+        return *this;
+    }
+
+    const float scale = std::max({glm::length(glm::vec3(matrix[0])), glm::length(glm::vec3(matrix[1])),
+                                  glm::length(glm::vec3(matrix[2]))});
+
+    BoundingSphere sphere;
+    sphere.center = glm::vec3(matrix * glm::vec4(center, 1.0f));
+    sphere.radius = radius * scale;
+    return sphere;
+}
+
+Frustum Frustum::FromMatrix(const glm::mat4 &viewProjection)
+{
+    // Gribb/Hartmann: a clip space point is inside when -w <= x, y, z <= w, and each of those six
+    // inequalities is a plane made of the matrix rows
+    glm::vec4 rows[4];
+    for (int row = 0; row < 4; ++row)
+    {
+        rows[row] = glm::vec4(viewProjection[0][row], viewProjection[1][row], viewProjection[2][row],
+                              viewProjection[3][row]);
+    }
+
+    Frustum frustum;
+    frustum.planes[0] = rows[3] + rows[0];
+    frustum.planes[1] = rows[3] - rows[0];
+    frustum.planes[2] = rows[3] + rows[1];
+    frustum.planes[3] = rows[3] - rows[1];
+    frustum.planes[4] = rows[3] + rows[2];
+    frustum.planes[5] = rows[3] - rows[2];
+
+    for (auto &plane : frustum.planes)
+    {
+        const float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f)
+        {
+            plane = plane / length;
+        }
+    }
+    return frustum;
+}
+
+bool Frustum::Intersects(const BoundingSphere &sphere) const
+{
+    for (const auto &plane : planes)
+    {
+        if (glm::dot(glm::vec3(plane), sphere.center) + plane.w < -sphere.radius)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Frustum::Intersects(const BoundingBox &box) const
+{
+    const glm::vec3 center = box.GetCenter();
+    const glm::vec3 extents = box.GetExtents();
+    for (const auto &plane : planes)
+    {
+        const glm::vec3 normal(plane);
+        if (glm::dot(normal, center) + plane.w < -glm::dot(glm::abs(normal), extents))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace eng
\ No newline at end of file
@@ -0,0 +1,146 @@
+#pragma once
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <limits>
+
+namespace eng
+{
+/**
+ * @struct BoundingBox
+ * @brief Axis-aligned bounding box. The default box is empty: min is above max on every axis.
+ */
+struct BoundingBox
+{
+    glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());  ///< Smallest corner.
+    glm::vec3 max = glm::vec3(-std::numeric_limits<float>::max()); ///< Largest corner.
+
+    /**
+     * @brief Checks if the box contains at least one point.
+     * @return true if min <= max on every axis.
+     */
+    [[nodiscard]] bool IsValid() const;
+
+    /**
+     * @brief Gets the center of the box.
+     * @return The center.
+     */
+    [[nodiscard]] glm::vec3 GetCenter() const;
+
+    /**
+     * @brief Gets the half size of the box along each axis.
+     * @return The extents.
+     */
+    [[nodiscard]] glm::vec3 GetExtents() const;
+
+    /**
+     * @brief Grows the box to contain a point.
+     * @param point The point.
+     */
+    void Expand(const glm::vec3 &point);
+
+    /**
+     * @brief Grows the box to contain another box.
+     * @param other The other box.
+     */
+    void Expand(const BoundingBox &other);
+
+    /**
+     * @brief Checks if the box overlaps another box, touching included.
+     * @param other The other box.
+     * @return true if they overlap.
+     */
+    [[nodiscard]] bool Overlaps(const BoundingBox &other) const;
+
+    /**
+     * @brief Checks if the box contains another box entirely.
+     * @param other The other box.
+     * @return true if other lies inside this box.
+     */
+    [[nodiscard]] bool Contains(const BoundingBox &other) const;
+
+    /**
+     * @brief Gets the squared distance from a point to the box.
+     * @param point The point.
+     * @return 0 for points inside the box.
+     */
+    [[nodiscard]] float DistanceSquared(const glm::vec3 &point) const;
+
+    /**
+     * @brief Intersects a ray with the box.
+     * @param origin Start of the ray.
+     * @param inverseDirection 1 / direction per axis, precomputed since one ray is usually tested against many
+     * boxes; infinities for zero components are fine.
+     * @param maxDistance Length of the ray, in units of the direction's length.
+     * @param outDistance Receives where the ray enters the box, 0 if it starts inside.
+     * @return true if the ray hits the box within maxDistance.
+     */
+    bool IntersectsRay(const glm::vec3 &origin, const glm::vec3 &inverseDirection, float maxDistance,
+                       float &outDistance) const;
+
+    /**
+     * @brief Gets the box around this box after a transformation.
+     * @param matrix The transformation, e.g. a model matrix.
+     * @return The transformed box; an empty box stays empty.
+     */
+    [[nodiscard]] BoundingBox Transform(const glm::mat4 &matrix) const;
+};
+
+/**
+ * @struct BoundingSphere
+ * @brief Sphere around a set of points. A negative radius marks an empty sphere.
+ */
+struct BoundingSphere
+{
+    glm::vec3 center = glm::vec3(0.0f); ///< Center.
+    float radius = -1.0f;               ///< Radius, negative if empty.
+
+    /**
+     * @brief Checks if the sphere contains at least one point.
+     * @return true if the radius is not negative.
+     */
+    [[nodiscard]] bool IsValid() const;
+
+    /**
+     * @brief Gets the sphere around this sphere after a transformation.
+     * @param matrix The transformation; non-uniform scale grows the radius by the largest axis scale.
+     * @return The transformed sphere.
+     */
+    [[nodiscard]] BoundingSphere Transform(const glm::mat4 &matrix) const;
+};
+
+/**
+ * @struct Frustum
+ * @brief The six planes bounding the volume a camera sees.
+ *
+ * Planes are stored as (normal, distance) with normals of unit length pointing inside, so a point p is on the
+ * inner side of a plane when dot(normal, p) + distance >= 0.
+ */
+struct Frustum
+{
+    static constexpr int PLANE_COUNT = 6;
+
+    glm::vec4 planes[PLANE_COUNT]; ///< Left, right, bottom, top, near and far planes.
+
+    /**
+     * @brief Extracts the planes of a view-projection matrix with OpenGL clip space conventions.
+     * @param viewProjection projection * view; planes come out in world space.
+     * @return The frustum.
+     */
+    static Frustum FromMatrix(const glm::mat4 &viewProjection);
+
+    /**
+     * @brief Checks if a sphere is at least partly inside.
+     * @param sphere The sphere.
+     * @return false only if the sphere is entirely outside one of the planes.
+     */
+    [[nodiscard]] bool Intersects(const BoundingSphere &sphere) const;
+
+    /**
+     * @brief Checks if a box is at least partly inside.
+     * @param box The box.
+     * @return false only if the box is entirely outside one of the planes.
+     */
+    [[nodiscard]] bool Intersects(const BoundingBox &box) const;
+};
+} // namespace eng
\ No newline at end of file
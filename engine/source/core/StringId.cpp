@@ -0,0 +1,183 @@
+#include "core/StringId.h"
+#include <array>
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace eng
+{
+namespace
+{
+/**
+ * @class StringTable
+ * @brief Storage behind StringId.
+ *
+ * Entries live in fixed-size blocks that never move, reached through a fixed array of block pointers, so
+ * reading the text or hash of an ID needs no lock: an ID is only handed out after its entry is complete.
+ */
+class StringTable
+{
+  public:
+    /**
+     * @brief Creates the table with the empty string as ID 0.
+     */
+    StringTable()
+    {
+        Add(std::string_view());
+    }
+
+    ~StringTable()
+    {
+        for (auto &block : m_blocks)
+        {
+            delete[] block.load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Gets the process-wide table.
+     */
+    static StringTable &GetInstance()
+    {
+        static StringTable instance;
+        return instance;
+    }
+
+    /**
+     * @brief Gets the ID of a text, adding it on first use. The common hit only takes the shared lock.
+     */
+    uint32_t Intern(std::string_view text)
+    {
+        {
+            std::shared_lock lock(m_mutex);
+            auto it = m_ids.find(text);
+            if (it != m_ids.end())
+            {
+                return it->second;
+            }
+        }
+
+        std::unique_lock lock(m_mutex);
+        auto it = m_ids.find(text);
+        return it != m_ids.end() ? it->second : Add(text);
+    }
+
+    /**
+     * @brief Gets the ID of a text without adding it.
+     */
+    bool Find(std::string_view text, uint32_t &id) const
+    {
+        std::shared_lock lock(m_mutex);
+        auto it = m_ids.find(text);
+        if (it == m_ids.end())
+        {
+            return false;
+        }
+        id = it->second;
+        return true;
+    }
+
+    /**
+     * @brief Gets the text of an ID.
+     */
+    const std::string &GetString(uint32_t id) const
+    {
+        return GetEntry(id).text;
+    }
+
+    /**
+     * @brief Gets the hash of an ID.
+     */
+    uint64_t GetHash(uint32_t id) const
+    {
+        return GetEntry(id).hash;
+    }
+
+  private:
+    /**
+     * @struct Entry
+     * @brief One interned string.
+     */
+    struct Entry
+    {
+        std::string text;  ///< The interned text.
+        uint64_t hash = 0; ///< FNV-1a hash of the text.
+    };
+
+    static constexpr uint32_t BLOCK_SIZE = 1024;
+    static constexpr uint32_t MAX_BLOCKS = 4096;
+
+    /**
+     * @brief Gets the entry of an ID handed out before.
+     */
+    const Entry &GetEntry(uint32_t id) const
+    {
+        return m_blocks[id / BLOCK_SIZE].load(std::memory_order_acquire)[id % BLOCK_SIZE];
+    }
+
+    /**
+     * @brief Appends a new entry; the caller holds the exclusive lock.
+     */
+    uint32_t Add(std::string_view text)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (char c : text)
+        {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+        }
+
+        const uint32_t id = m_count;
+        if (id / BLOCK_SIZE >= MAX_BLOCKS)
+        {
+            std::cerr << "Error: StringId table is full, interning \"" << text << "\" as the empty string" << std::endl;
+            return 0;
+        }
+
+        auto &block = m_blocks[id / BLOCK_SIZE];
+        if (id % BLOCK_SIZE == 0)
+        {
+            block.store(new Entry[BLOCK_SIZE], std::memory_order_release);
+        }
+
+        Entry &entry = block.load(std::memory_order_relaxed)[id % BLOCK_SIZE];
+        entry.text = text;
+        entry.hash = hash;
+        m_ids.emplace(entry.text, id);
+        ++m_count;
+        return id;
+    }
+
+    mutable std::shared_mutex m_mutex;                       ///< Guards m_ids and adding entries.
+    std::array<std::atomic<Entry *>, MAX_BLOCKS> m_blocks{}; ///< Blocks of BLOCK_SIZE entries, indexed by ID.
+    uint32_t m_count = 0;                                    ///< Number of entries.
+    std::unordered_map<std::string_view, uint32_t> m_ids;    ///< ID per text; keys point into the blocks.
+};
+} // namespace
+
+StringId::StringId(std::string_view text) : m_id(text.empty() ? 0 : StringTable::GetInstance().Intern(text))
+{
+}
+
+bool StringId::Find(std::string_view text, StringId &id)
+{
+    uint32_t value = 0;
+    if (!StringTable::GetInstance().Find(text, value))
+    {
+        return false;
+    }
+    id.m_id = value;
+    return true;
+}
+
+const std::string &StringId::GetString() const
+{
+    return StringTable::GetInstance().GetString(m_id);
+}
+
+uint64_t StringId::GetHash() const
+{
+    return StringTable::GetInstance().GetHash(m_id);
+}
+} // namespace eng
\ No newline at end of file
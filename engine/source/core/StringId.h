@@ -0,0 +1,113 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace eng
+{
+/**
+ * @class StringId
+ * @brief A string interned in a process-wide table, stored as a 4-byte ID.
+ *
+ * Interning the same text always gives the same ID, so IDs compare and hash as integers and equal names
+ * never need a string comparison. The ID of a string is stable for the lifetime of the process; the table
+ * also keeps a precomputed 64-bit FNV-1a hash of the text, which does not depend on interning order.
+ * Interning takes a lock and hashes the text once, so hot paths should keep their StringIds instead of
+ * interning the same text every time. ID 0 is the empty string. The table is thread-safe and never shrinks.
+ */
+class StringId
+{
+  public:
+    /**
+     * @brief Creates the ID of the empty string.
+     */
+    StringId() = default;
+
+    /**
+     * @brief Interns a string.
+     * @param text The text.
+     */
+    explicit StringId(std::string_view text);
+
+    /**
+     * @brief Finds the ID of a string without interning it.
+     * @param text The text.
+     * @param id Receives the ID if the text is interned.
+     * @return true if the text was interned before.
+     */
+    static bool Find(std::string_view text, StringId &id);
+
+    /**
+     * @brief Gets the interned text.
+     * @return Reference to the text, valid for the lifetime of the process.
+     */
+    [[nodiscard]] const std::string &GetString() const;
+
+    /**
+     * @brief Gets the precomputed FNV-1a hash of the text.
+     * @return The hash.
+     */
+    [[nodiscard]] uint64_t GetHash() const;
+
+    /**
+     * @brief Gets the numeric ID.
+     * @return The ID, 0 for the empty string.
+     */
+    [[nodiscard]] uint32_t GetId() const
+    {
+        return m_id;
+    }
+
+    /**
+     * @brief Checks if this is the empty string.
+     * @return true for ID 0.
+     */
+    [[nodiscard]] bool IsEmpty() const
+    {
+        return m_id == 0;
+    }
+
+    /**
+     * @brief Checks if two IDs name the same text.
+     */
+    bool operator==(StringId other) const
+    {
+        return m_id == other.m_id;
+    }
+
+    /**
+     * @brief Negation of operator==.
+     */
+    bool operator!=(StringId other) const
+    {
+        return m_id != other.m_id;
+    }
+
+    /**
+     * @brief Orders by ID (interning order, not alphabetical).
+     */
+    bool operator<(StringId other) const
+    {
+        return m_id < other.m_id;
+    }
+
+  private:
+    uint32_t m_id = 0; ///< Index in the string table.
+};
+} // namespace eng
+
+namespace std
+{
+/**
+ * @brief Hashes a StringId by its ID, which is already unique.
+ */
+template <> struct hash<eng::StringId>
+{
+    size_t operator()(eng::StringId id) const noexcept
+    {
+        return id.GetId();
+    }
+};
+} // namespace std
\ No newline at end of file
@@ -6,16 +6,26 @@
 
 #include "Application.h"
 #include "Engine.h"
+#include "core/Bounds.h"
+#include "core/StringId.h"
 #include "graphics/GraphicsAPI.h"
 #include "graphics/ShaderProgram.h"
 #include "graphics/VertexLayout.h"
 #include "input/InputManager.h"
+#include "jobs/JobSystem.h"
+#include "jobs/TaskGraph.h"
+#include "profiling/Profiler.h"
+#include "render/FrustumCuller.h"
 #include "render/Material.h"
 #include "render/Mesh.h"
+#include "render/MeshLodChain.h"
 #include "render/RenderQueue.h"
+#include "scene/BoundingVolumeTree.h"
 #include "scene/Component.h"
 #include "scene/GameObject.h"
 #include "scene/Scene.h"
+#include "scene/SpatialHashGrid.h"
+#include "scene/SystemAccess.h"
 #include "scene/components/CameraComponent.h"
 #include "scene/components/MeshComponent.h"
 #include "scene/components/PlayerControllerComponent.h"
\ No newline at end of file
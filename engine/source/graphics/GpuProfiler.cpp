@@ -0,0 +1,185 @@
+#include "graphics/GpuProfiler.h"
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+namespace eng
+{
+namespace
+{
+double NowSeconds()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool HasDebugGroups()
+{
+    return GLEW_KHR_debug && glPushDebugGroup && glPopDebugGroup;
+}
+} // namespace
+
+void GpuProfiler::BeginFrame()
+{
+    // The slot reused this frame was last issued FRAME_LATENCY frames ago, so its result is usually ready.
+    const size_t slot = m_frameIndex % FRAME_LATENCY;
+
+    std::lock_guard<std::mutex> lock(m_timingsMutex);
+    for (size_t i = 0; i < m_passes.size(); ++i)
+    {
+        auto &pass = m_passes[i];
+        if (!pass.pending[slot])
+        {
+            continue;
+        }
+        pass.pending[slot] = false;
+
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(pass.queries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+        {
+            // Dropping the sample is cheaper than stalling; the query object is simply reissued.
+            continue;
+        }
+
+        GLuint64 elapsedNs = 0;
+        glGetQueryObjectui64v(pass.queries[slot], GL_QUERY_RESULT, &elapsedNs);
+        const double elapsedMs = static_cast<double>(elapsedNs) / 1.0e6;
+
+        auto &timing = m_timings[i];
+        timing.lastMs = elapsedMs;
+        timing.averageMs += (elapsedMs - timing.averageMs) / static_cast<double>(++timing.samples);
+        pass.intervalMs += elapsedMs;
+        ++pass.intervalSamples;
+    }
+}
+
+void GpuProfiler::EndFrame()
+{
+    if (m_activePass >= 0)
+    {
+        EndPass();
+    }
+    ++m_frameIndex;
+
+    if (m_reportInterval <= 0.0f)
+    {
+        return;
+    }
+
+    const double now = NowSeconds();
+    if (m_lastReportTime == 0.0)
+    {
+        m_lastReportTime = now;
+    }
+    else if (now - m_lastReportTime >= m_reportInterval)
+    {
+        PrintSummary();
+        m_lastReportTime = now;
+    }
+}
+
+void GpuProfiler::BeginPass(const char *name)
+{
+    if (m_activePass >= 0)
+    {
+        EndPass();
+    }
+
+    size_t index = 0;
+    while (index < m_passes.size() && m_passes[index].name != name && std::strcmp(m_passes[index].name, name) != 0)
+    {
+        ++index;
+    }
+
+    if (index == m_passes.size())
+    {
+        PassQueries pass;
+        pass.name = name;
+        glGenQueries(static_cast<GLsizei>(FRAME_LATENCY), pass.queries.data());
+
+        std::lock_guard<std::mutex> lock(m_timingsMutex);
+        m_passes.push_back(pass);
+        GpuPassTiming timing;
+        timing.name = name;
+        m_timings.push_back(timing);
+    }
+
+    auto &pass = m_passes[index];
+    const size_t slot = m_frameIndex % FRAME_LATENCY;
+    if (pass.pending[slot])
+    {
+        // The same pass ran twice this frame; only the first run is timed.
+        m_activePass = -2;
+    }
+    else
+    {
+        glBeginQuery(GL_TIME_ELAPSED, pass.queries[slot]);
+        pass.pending[slot] = true;
+        m_activePass = static_cast<int>(index);
+    }
+
+    if (HasDebugGroups())
+    {
+        glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, static_cast<GLuint>(index), -1, name);
+    }
+}
+
+void GpuProfiler::EndPass()
+{
+    if (m_activePass == -1)
+    {
+        return;
+    }
+
+    if (m_activePass >= 0)
+    {
+        glEndQuery(GL_TIME_ELAPSED);
+    }
+    m_activePass = -1;
+
+    if (HasDebugGroups())
+    {
+        glPopDebugGroup();
+    }
+}
+
+void GpuProfiler::SetReportInterval(float seconds)
+{
+    m_reportInterval = seconds;
+    m_lastReportTime = 0.0;
+}
+
+double GpuProfiler::GetPassTimeMs(const std::string &name) const
+{
+    std::lock_guard<std::mutex> lock(m_timingsMutex);
+    for (const auto &timing : m_timings)
+    {
+        if (timing.name == name)
+        {
+            return timing.averageMs;
+        }
+    }
+    return 0.0;
+}
+
+std::vector<GpuPassTiming> GpuProfiler::GetPassTimings() const
+{
+    std::lock_guard<std::mutex> lock(m_timingsMutex);
+    return m_timings;
+}
+
+void GpuProfiler::PrintSummary()
+{
+    std::cout << "GPU passes (avg ms over last " << m_reportInterval << " s):";
+    for (auto &pass : m_passes)
+    {
+        const double averageMs =
+            pass.intervalSamples > 0 ? pass.intervalMs / static_cast<double>(pass.intervalSamples) : 0.0;
+        std::cout << " " << pass.name << "=" << std::fixed << std::setprecision(3) << averageMs;
+        pass.intervalMs = 0.0;
+        pass.intervalSamples = 0;
+    }
+    std::cout << std::defaultfloat << std::endl;
+}
+} // namespace eng
\ No newline at end of file
@@ -0,0 +1,140 @@
+#pragma once
+#include <GL/glew.h>
+#include <array>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace eng
+{
+/**
+ * @struct GpuPassTiming
+ * @brief GPU time measured for one named pass.
+ */
+struct GpuPassTiming
+{
+    std::string name;       ///< Name of the pass.
+    double lastMs = 0.0;    ///< Most recent resolved GPU time in milliseconds.
+    double averageMs = 0.0; ///< Average GPU time over all resolved frames in milliseconds.
+    uint64_t samples = 0;   ///< Number of resolved frames.
+};
+
+/**
+ * @class GpuProfiler
+ * @brief Measures per-pass GPU time with GL_TIME_ELAPSED queries and labels passes with KHR_debug groups.
+ *
+ * Every pass owns a small ring of query objects, one per frame in flight. Results are read back
+ * FRAME_LATENCY frames after they were issued and only if already available, so the CPU never waits
+ * for the GPU. Time-elapsed queries cannot nest, so passes must not overlap. All calls except the
+ * getters must happen on the thread that owns the GL context; the queries are released with that context.
+ */
+class GpuProfiler
+{
+  public:
+    static constexpr size_t FRAME_LATENCY = 4;
+
+    GpuProfiler() = default;
+    GpuProfiler(const GpuProfiler &) = delete;
+    GpuProfiler &operator=(const GpuProfiler &) = delete;
+
+    /**
+     * @brief Starts a frame and resolves the queries issued FRAME_LATENCY frames ago.
+     */
+    void BeginFrame();
+
+    /**
+     * @brief Ends a frame and prints a summary if the report interval has elapsed.
+     */
+    void EndFrame();
+
+    /**
+     * @brief Starts timing a pass and opens a debug group with its name.
+     * @param name Static name of the pass.
+     */
+    void BeginPass(const char *name);
+
+    /**
+     * @brief Stops timing the current pass and closes its debug group.
+     */
+    void EndPass();
+
+    /**
+     * @brief Sets how often a summary of all passes is printed.
+     * @param seconds Interval in seconds, or 0 to disable the periodic summary.
+     */
+    void SetReportInterval(float seconds);
+
+    /**
+     * @brief Gets the average GPU time of a pass.
+     * @param name Name of the pass.
+     * @return Average milliseconds, or 0 if the pass has not been resolved yet.
+     */
+    [[nodiscard]] double GetPassTimeMs(const std::string &name) const;
+
+    /**
+     * @brief Gets the timings of all passes. Safe to call from any thread.
+     * @return A copy of the per-pass timings.
+     */
+    [[nodiscard]] std::vector<GpuPassTiming> GetPassTimings() const;
+
+  private:
+    /**
+     * @struct PassQueries
+     * @brief Query ring and accumulated results of one pass.
+     */
+    struct PassQueries
+    {
+        const char *name = nullptr;                     ///< Static name of the pass.
+        std::array<GLuint, FRAME_LATENCY> queries = {}; ///< One query object per frame in flight.
+        std::array<bool, FRAME_LATENCY> pending = {};   ///< Whether the query was issued and not read.
+        double intervalMs = 0.0;                        ///< Sum since the last periodic summary.
+        uint64_t intervalSamples = 0;                   ///< Samples since the last periodic summary.
+    };
+
+    /**
+     * @brief Prints the averages accumulated since the last summary and resets them.
+     */
+    void PrintSummary();
+
+  private:
+    std::vector<PassQueries> m_passes;    ///< Passes seen so far, in first-use order.
+    std::vector<GpuPassTiming> m_timings; ///< Results, parallel to m_passes.
+    mutable std::mutex m_timingsMutex;    ///< Guards m_timings for readers on other threads.
+    size_t m_frameIndex = 0;              ///< Number of frames begun so far.
+    int m_activePass = -1;                ///< Index of the pass being timed, or -1.
+    float m_reportInterval = 0.0f;        ///< Seconds between periodic summaries (0 = off).
+    double m_lastReportTime = 0.0;        ///< Time of the last summary in seconds.
+};
+
+/**
+ * @class GpuPassScope
+ * @brief Times a GPU pass for the lifetime of the scope.
+ */
+class GpuPassScope
+{
+  public:
+    /**
+     * @brief Begins the pass.
+     * @param profiler The profiler to record into.
+     * @param name Static name of the pass.
+     */
+    GpuPassScope(GpuProfiler &profiler, const char *name) : m_profiler(profiler)
+    {
+        m_profiler.BeginPass(name);
+    }
+
+    /**
+     * @brief Ends the pass.
+     */
+    ~GpuPassScope()
+    {
+        m_profiler.EndPass();
+    }
+
+    GpuPassScope(const GpuPassScope &) = delete;
+    GpuPassScope &operator=(const GpuPassScope &) = delete;
+
+  private:
+    GpuProfiler &m_profiler; ///< The profiler the pass is recorded into.
+};
+} // namespace eng
\ No newline at end of file
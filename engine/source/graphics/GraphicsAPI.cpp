@@ -1,5 +1,6 @@
 #include "graphics/GraphicsAPI.h"
 #include "graphics/ShaderProgram.h"
+#include "profiling/Profiler.h"
 #include "render/Material.h"
 #include "render/Mesh.h"
 #include <iostream>
@@ -14,6 +15,8 @@ void GraphicsAPI::Init()
 std::shared_ptr<ShaderProgram> GraphicsAPI::CreateShaderProgram(const std::string &vertexSource,
                                                                 const std::string &fragmentSource)
 {
+    ENG_PROFILE_SCOPE("GraphicsAPI::CreateShaderProgram");
+
     GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
     const char *vertexShaderCStr = vertexSource.c_str();
     glShaderSource(vertexShader, 1, &vertexShaderCStr, nullptr);
@@ -69,6 +72,7 @@ GLuint GraphicsAPI::CreateVertexBuffer(const std::vector<float> &vertices)
     glGenBuffers(1, &VBO);
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    m_renderStats.bufferBytesUploaded += vertices.size() * sizeof(float);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     return VBO;
 }
@@ -79,6 +83,7 @@ GLuint GraphicsAPI::CreateIndexBuffer(const std::vector<uint32_t> &indices)
     glGenBuffers(1, &EBO);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+    m_renderStats.bufferBytesUploaded += indices.size() * sizeof(uint32_t);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     return EBO;
 }
@@ -90,6 +95,7 @@ void GraphicsAPI::SetClearColor(float r, float g, float b, float a)
 
 void GraphicsAPI::ClearBuffers()
 {
+    GpuPassScope gpuPass(m_gpuProfiler, "Clear");
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
@@ -124,4 +130,31 @@ void GraphicsAPI::DrawMesh(Mesh *mesh)
         mesh->Draw();
     }
 }
+
+GpuProfiler &GraphicsAPI::GetGpuProfiler()
+{
+    return m_gpuProfiler;
+}
+
+const GpuProfiler &GraphicsAPI::GetGpuProfiler() const
+{
+    return m_gpuProfiler;
+}
+
+RenderStats &GraphicsAPI::GetRenderStats()
+{
+    return m_renderStats;
+}
+
+void GraphicsAPI::EndStatsFrame(uint32_t commandsSubmitted)
+{
+    m_renderStats.commandsSubmitted = commandsSubmitted;
+    m_renderStatsHistory.Push(m_renderStats);
+    m_renderStats = RenderStats();
+}
+
+const RenderStatsHistory &GraphicsAPI::GetRenderStatsHistory() const
+{
+    return m_renderStatsHistory;
+}
 } // namespace eng
\ No newline at end of file
@@ -1,4 +1,6 @@
 #pragma once
+#include "graphics/GpuProfiler.h"
+#include "graphics/RenderStats.h"
 #include <GL/glew.h>
 #include <memory>
 #include <string>
@@ -82,5 +84,36 @@ class GraphicsAPI
      * @param mesh Pointer to the mesh to draw.
      */
     void DrawMesh(Mesh *mesh);
+
+    /**
+     * @brief Gets the GPU pass profiler. Its timing calls must be made on the rendering thread.
+     * @return Reference to the GpuProfiler.
+     */
+    GpuProfiler &GetGpuProfiler();
+    const GpuProfiler &GetGpuProfiler() const;
+
+    /**
+     * @brief Gets the counters of the frame being recorded.
+     * @return Reference to the in-progress RenderStats.
+     */
+    RenderStats &GetRenderStats();
+
+    /**
+     * @brief Closes the current stats frame: stores it in the history and resets the counters.
+     * Must be called while no other thread is recording.
+     * @param commandsSubmitted Number of RenderQueue commands in the frame that was drawn.
+     */
+    void EndStatsFrame(uint32_t commandsSubmitted);
+
+    /**
+     * @brief Gets the stats of the most recent frames.
+     * @return Reference to the RenderStatsHistory.
+     */
+    const RenderStatsHistory &GetRenderStatsHistory() const;
+
+  private:
+    GpuProfiler m_gpuProfiler;               ///< GPU timer queries for the render passes.
+    RenderStats m_renderStats;               ///< Counters of the frame being recorded.
+    RenderStatsHistory m_renderStatsHistory; ///< Counters of the last completed frames.
 };
 } // namespace eng
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "graphics/RenderStats.h"
+#include <algorithm>
+
+namespace eng
+{
+RenderStats &RenderStats::operator+=(const RenderStats &other)
+{
+    drawCalls += other.drawCalls;
+    triangles += other.triangles;
+    programBinds += other.programBinds;
+    materialBinds += other.materialBinds;
+    vertexArrayBinds += other.vertexArrayBinds;
+    uniformUploads += other.uniformUploads;
+    bufferBytesUploaded += other.bufferBytesUploaded;
+    commandsSubmitted += other.commandsSubmitted;
+    commandsVisible += other.commandsVisible;
+    commandsCulled += other.commandsCulled;
+    commandsTooSmall += other.commandsTooSmall;
+    trianglesSaved += other.trianglesSaved;
+    return *this;
+}
+
+void RenderStatsHistory::Push(const RenderStats &stats)
+{
+    m_frames[m_next] = stats;
+    m_next = (m_next + 1) % CAPACITY;
+    m_size = std::min(m_size + 1, CAPACITY);
+}
+
+size_t RenderStatsHistory::GetSize() const
+{
+    return m_size;
+}
+
+const RenderStats &RenderStatsHistory::Get(size_t index) const
+{
+    return m_frames[(m_next + CAPACITY - m_size + index) % CAPACITY];
+}
+
+RenderStats RenderStatsHistory::GetLatest() const
+{
+    if (m_size == 0)
+    {
+        return {};
+    }
+    return Get(m_size - 1);
+}
+
+RenderStats RenderStatsHistory::GetAverage() const
+{
+    RenderStats average;
+    if (m_size == 0)
+    {
+        return average;
+    }
+
+    RenderStats total;
+    for (size_t i = 0; i < m_size; ++i)
+    {
+        total += Get(i);
+    }
+
+    const auto count = static_cast<uint32_t>(m_size);
+    average.drawCalls = total.drawCalls / count;
+    average.triangles = total.triangles / count;
+    average.programBinds = total.programBinds / count;
+    average.materialBinds = total.materialBinds / count;
+    average.vertexArrayBinds = total.vertexArrayBinds / count;
+    average.uniformUploads = total.uniformUploads / count;
+    average.bufferBytesUploaded = total.bufferBytesUploaded / count;
+    average.commandsSubmitted = total.commandsSubmitted / count;
+    average.commandsVisible = total.commandsVisible / count;
+    average.commandsCulled = total.commandsCulled / count;
+    average.commandsTooSmall = total.commandsTooSmall / count;
+    average.trianglesSaved = total.trianglesSaved / count;
+    return average;
+}
+
+RenderStats RenderStatsHistory::GetMax() const
+{
+    RenderStats maximum;
+    for (size_t i = 0; i < m_size; ++i)
+    {
+        const auto &frame = Get(i);
+        maximum.drawCalls = std::max(maximum.drawCalls, frame.drawCalls);
+        maximum.triangles = std::max(maximum.triangles, frame.triangles);
+        maximum.programBinds = std::max(maximum.programBinds, frame.programBinds);
+        maximum.materialBinds = std::max(maximum.materialBinds, frame.materialBinds);
+        maximum.vertexArrayBinds = std::max(maximum.vertexArrayBinds, frame.vertexArrayBinds);
+        maximum.uniformUploads = std::max(maximum.uniformUploads, frame.uniformUploads);
+        maximum.bufferBytesUploaded = std::max(maximum.bufferBytesUploaded, frame.bufferBytesUploaded);
+        maximum.commandsSubmitted = std::max(maximum.commandsSubmitted, frame.commandsSubmitted);
+        maximum.commandsVisible = std::max(maximum.commandsVisible, frame.commandsVisible);
+        maximum.commandsCulled = std::max(maximum.commandsCulled, frame.commandsCulled);
+        maximum.commandsTooSmall = std::max(maximum.commandsTooSmall, frame.commandsTooSmall);
+        maximum.trianglesSaved = std::max(maximum.trianglesSaved, frame.trianglesSaved);
+    }
+    return maximum;
+}
+
+void RenderStatsHistory::Clear()
+{
+    m_next = 0;
+    m_size = 0;
+}
+} // namespace eng
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace eng
+{
+/**
+ * @struct RenderStats
+ * @brief Counters describing the GPU work of one frame.
+ *
+ * The draw-side counters are incremented by the thread that executes the render queue; buffer uploads are
+ * counted by the thread that creates the buffers. The fields are plain integers: Engine reads and resets them
+ * at the frame sync point, when neither side is recording.
+ */
+struct RenderStats
+{
+    uint32_t drawCalls = 0;           ///< glDrawElements / glDrawArrays calls.
+    uint64_t triangles = 0;           ///< Triangles submitted by those draw calls.
+    uint32_t programBinds = 0;        ///< glUseProgram calls.
+    uint32_t materialBinds = 0;       ///< Material::Bind calls.
+    uint32_t vertexArrayBinds = 0;    ///< glBindVertexArray calls for drawing.
+    uint32_t uniformUploads = 0;      ///< glUniform* calls.
+    uint64_t bufferBytesUploaded = 0; ///< Bytes passed to glBufferData.
+    uint32_t commandsSubmitted = 0;   ///< Commands in the RenderQueue frame that was drawn.
+    uint32_t commandsVisible = 0;     ///< Commands of that frame that passed frustum culling.
+    uint32_t commandsCulled = 0;      ///< Commands of that frame skipped by frustum culling.
+    uint32_t commandsTooSmall = 0;    ///< Visible commands skipped because they cover too little of the screen.
+    uint64_t trianglesSaved = 0;      ///< Triangles of the most detailed levels minus those of the levels drawn.
+
+    /**
+     * @brief Adds the counters of another frame to this one.
+     * @param other The counters to add.
+     * @return Reference to this object.
+     */
+    RenderStats &operator+=(const RenderStats &other);
+};
+
+/**
+ * @class RenderStatsHistory
+ * @brief Fixed-size ring of the RenderStats of the most recent frames.
+ */
+class RenderStatsHistory
+{
+  public:
+    static constexpr size_t CAPACITY = 240;
+
+    /**
+     * @brief Appends a frame, overwriting the oldest one once the ring is full.
+     * @param stats The counters of the frame.
+     */
+    void Push(const RenderStats &stats);
+
+    /**
+     * @brief Gets the number of frames stored.
+     * @return Number of frames, at most CAPACITY.
+     */
+    [[nodiscard]] size_t GetSize() const;
+
+    /**
+     * @brief Gets a stored frame.
+     * @param index 0 for the oldest stored frame, GetSize() - 1 for the latest.
+     * @return The counters of that frame.
+     */
+    [[nodiscard]] const RenderStats &Get(size_t index) const;
+
+    /**
+     * @brief Gets the latest frame.
+     * @return The counters of the latest frame, or zeroed counters if the history is empty.
+     */
+    [[nodiscard]] RenderStats GetLatest() const;
+
+    /**
+     * @brief Gets the per-frame average over the stored frames (integer division).
+     * @return The averaged counters, or zeroed counters if the history is empty.
+     */
+    [[nodiscard]] RenderStats GetAverage() const;
+
+    /**
+     * @brief Gets the per-field maximum over the stored frames.
+     * @return The maximum of each counter, or zeroed counters if the history is empty.
+     */
+    [[nodiscard]] RenderStats GetMax() const;
+
+    /**
+     * @brief Removes all stored frames.
+     */
+    void Clear();
+
+  private:
+    std::array<RenderStats, CAPACITY> m_frames; ///< Ring storage.
+    size_t m_next = 0;                          ///< Slot written by the next Push().
+    size_t m_size = 0;                          ///< Number of valid frames.
+};
+} // namespace eng
\ No newline at end of file
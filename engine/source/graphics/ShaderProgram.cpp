@@ -1,4 +1,5 @@
 #include "graphics/ShaderProgram.h"
+#include "Engine.h"
 #include <glm/gtc/type_ptr.hpp>
 
 namespace eng
@@ -15,35 +16,59 @@ ShaderProgram::~ShaderProgram()
 void ShaderProgram::Bind() const
 {
     glUseProgram(m_shaderProgramID);
+    ++Engine::GetInstance().GetGraphicsAPI().GetRenderStats().programBinds;
 }
 
-GLint ShaderProgram::GetUniformLocation(const std::string &name)
+GLint ShaderProgram::GetUniformLocation(StringId name)
 {
     auto it = m_uniformLocationCache.find(name);
     if (it != m_uniformLocationCache.end())
     {
         return it->second;
     }
-    GLint location = glGetUniformLocation(m_shaderProgramID, name.c_str());
+    GLint location = glGetUniformLocation(m_shaderProgramID, name.GetString().c_str());
     m_uniformLocationCache[name] = location;
     return location;
 }
 
-void ShaderProgram::SetUniform(const std::string &name, float value)
+GLint ShaderProgram::GetUniformLocation(const std::string &name)
+{
+    return GetUniformLocation(StringId(name));
+}
+
+void ShaderProgram::SetUniform(StringId name, float value)
 {
     auto location = GetUniformLocation(name);
     glUniform1f(location, value);
+    ++Engine::GetInstance().GetGraphicsAPI().GetRenderStats().uniformUploads;
 }
 
-void ShaderProgram::SetUniform(const std::string &name, float v0, float v1)
+void ShaderProgram::SetUniform(StringId name, float v0, float v1)
 {
     auto location = GetUniformLocation(name);
     glUniform2f(location, v0, v1);
+    ++Engine::GetInstance().GetGraphicsAPI().GetRenderStats().uniformUploads;
 }
 
-void ShaderProgram::SetUniform(const std::string &name, const glm::mat4 &mat)
+void ShaderProgram::SetUniform(StringId name, const glm::mat4 &mat)
 {
     auto location = GetUniformLocation(name);
     glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(mat));
+    ++Engine::GetInstance().GetGraphicsAPI().GetRenderStats().uniformUploads;
+}
+
+void ShaderProgram::SetUniform(const std::string &name, float value)
+{
+    SetUniform(StringId(name), value);
+}
+
+void ShaderProgram::SetUniform(const std::string &name, float v0, float v1)
+{
+    SetUniform(StringId(name), v0, v1);
+}
+
+void ShaderProgram::SetUniform(const std::string &name, const glm::mat4 &mat)
+{
+    SetUniform(StringId(name), mat);
 }
 } // namespace eng
\ No newline at end of file
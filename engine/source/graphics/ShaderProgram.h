@@ -1,4 +1,5 @@
 #pragma once
+#include "core/StringId.h"
 #include <GL/glew.h>
 #include <glm/mat4x4.hpp>
 #include <string>
@@ -34,10 +35,17 @@ class ShaderProgram
     void Bind() const;
 
     /**
-     * @brief Gets the location of a uniform variable.
+     * @brief Gets the location of a uniform variable, cached by interned name.
      * @param name The name of the uniform variable.
      * @return The location of the uniform, or -1 if not found.
      */
+    GLint GetUniformLocation(StringId name);
+
+    /**
+     * @brief Gets the location of a uniform variable.
+     * @param name The name of the uniform variable; interned on every call.
+     * @return The location of the uniform, or -1 if not found.
+     */
     GLint GetUniformLocation(const std::string &name);
 
     /**
@@ -45,7 +53,7 @@ class ShaderProgram
      * @param name The name of the uniform.
      * @param value The value to set.
      */
-    void SetUniform(const std::string &name, float value);
+    void SetUniform(StringId name, float value);
 
     /**
      * @brief Sets a vec2 uniform (two floats).
@@ -53,17 +61,39 @@ class ShaderProgram
      * @param v0 The first component.
      * @param v1 The second component.
      */
-    void SetUniform(const std::string &name, float v0, float v1);
+    void SetUniform(StringId name, float v0, float v1);
 
     /**
      * @brief Sets a mat4 uniform.
      * @param name The name of the uniform.
      * @param mat The 4x4 matrix to set.
      */
+    void SetUniform(StringId name, const glm::mat4 &mat);
+
+    /**
+     * @brief Sets a float uniform.
+     * @param name The name of the uniform; interned on every call.
+     * @param value The value to set.
+     */
+    void SetUniform(const std::string &name, float value);
+
+    /**
+     * @brief Sets a vec2 uniform (two floats).
+     * @param name The name of the uniform; interned on every call.
+     * @param v0 The first component.
+     * @param v1 The second component.
+     */
+    void SetUniform(const std::string &name, float v0, float v1);
+
+    /**
+     * @brief Sets a mat4 uniform.
+     * @param name The name of the uniform; interned on every call.
+     * @param mat The 4x4 matrix to set.
+     */
     void SetUniform(const std::string &name, const glm::mat4 &mat);
 
   private:
-    std::unordered_map<std::string, GLint> m_uniformLocationCache; ///< Cache for uniform locations.
-    GLuint m_shaderProgramID = 0;                                  ///< The OpenGL ID of the shader program.
+    std::unordered_map<StringId, GLint> m_uniformLocationCache; ///< Cache for uniform locations.
+    GLuint m_shaderProgramID = 0;                               ///< The OpenGL ID of the shader program.
 };
 } // namespace eng
\ No newline at end of file
@@ -0,0 +1,298 @@
+#include "jobs/JobSystem.h"
+#include "profiling/Profiler.h"
+#include <utility>
+
+namespace eng
+{
+namespace
+{
+thread_local const JobSystem *t_jobSystem = nullptr; ///< Job system the current thread is a worker of.
+thread_local size_t t_queueIndex = 0;                ///< Queue index of the current worker thread.
+} // namespace
+
+bool JobCounter::IsDone() const
+{
+    return m_value.load(std::memory_order_acquire) == 0;
+}
+
+JobSystem::~JobSystem()
+{
+    Shutdown();
+}
+
+void JobSystem::Init(int workerCount)
+{
+    if (!m_queues.empty())
+    {
+        return;
+    }
+
+    if (workerCount < 0)
+    {
+        int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+        workerCount = std::max(hardwareThreads - 1, 0);
+    }
+
+    m_stopRequested = false;
+    for (int i = 0; i <= workerCount; ++i)
+    {
+        m_queues.push_back(std::make_unique<JobQueue>());
+    }
+
+    for (int i = 1; i <= workerCount; ++i)
+    {
+        m_workers.emplace_back(&JobSystem::WorkerMain, this, static_cast<size_t>(i));
+    }
+}
+
+void JobSystem::Shutdown()
+{
+    if (m_queues.empty())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopRequested = true;
+    }
+    m_wakeCondition.notify_all();
+
+    for (auto &worker : m_workers)
+    {
+        worker.join();
+    }
+
+    m_workers.clear();
+    m_queues.clear();
+    m_queuedJobs = 0;
+}
+
+uint32_t JobSystem::GetWorkerCount() const
+{
+    return static_cast<uint32_t>(m_workers.size());
+}
+
+void JobSystem::Run(Job job, JobCounter *counter)
+{
+    if (counter)
+    {
+        counter->m_value.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    QueuedJob queuedJob;
+    queuedJob.job = std::move(job);
+    queuedJob.counter = counter;
+
+    if (m_queues.empty())
+    {
+        // Not initialized: behave like a job system without workers
+        Execute(queuedJob);
+        return;
+    }
+
+    Push(std::move(queuedJob));
+}
+
+void JobSystem::RunAfter(JobCounter &dependency, Job job, JobCounter *counter)
+{
+    if (counter)
+    {
+        counter->m_value.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(dependency.m_mutex);
+        if (dependency.m_value.load(std::memory_order_acquire) > 0)
+        {
+            dependency.m_continuations.push_back({std::move(job), counter});
+            return;
+        }
+    }
+
+    // The dependency is already satisfied. The counter was incremented above, so hand it over as is.
+    QueuedJob queuedJob;
+    queuedJob.job = std::move(job);
+    queuedJob.counter = counter;
+
+    if (m_queues.empty())
+    {
+        Execute(queuedJob);
+        return;
+    }
+
+    Push(std::move(queuedJob));
+}
+
+void JobSystem::Wait(JobCounter &counter)
+{
+    size_t index = GetCurrentQueueIndex();
+
+    while (!counter.IsDone())
+    {
+        QueuedJob job;
+        if (!m_queues.empty() && TryPop(index, job))
+        {
+            Execute(job);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // The last job releases the counter's lock after reaching zero; acquire it so the caller can
+    // safely destroy the counter once Wait() returns.
+    std::lock_guard<std::mutex> lock(counter.m_mutex);
+}
+
+bool JobSystem::RunPendingJob()
+{
+    QueuedJob job;
+    if (m_queues.empty() || !TryPop(GetCurrentQueueIndex(), job))
+    {
+        return false;
+    }
+
+    Execute(job);
+    return true;
+}
+
+void JobSystem::Push(QueuedJob job)
+{
+    auto &queue = *m_queues[GetCurrentQueueIndex()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+
+    m_queuedJobs.fetch_add(1);
+    if (m_sleepingWorkers.load() > 0)
+    {
+        // Taking the lock orders this wake-up after a worker's predicate check
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+        m_wakeCondition.notify_one();
+    }
+}
+
+bool JobSystem::TryPop(size_t index, QueuedJob &outJob)
+{
+    if (m_queuedJobs.load(std::memory_order_relaxed) <= 0)
+    {
+        return false;
+    }
+
+    // Own queue first, newest job first for cache locality
+    {
+        auto &queue = *m_queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty())
+        {
+            outJob = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+            m_queuedJobs.fetch_sub(1);
+            return true;
+        }
+    }
+
+    // Steal the oldest job from the other queues
+    size_t queueCount = m_queues.size();
+    for (size_t offset = 1; offset < queueCount; ++offset)
+    {
+        auto &queue = *m_queues[(index + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty())
+        {
+            outJob = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            m_queuedJobs.fetch_sub(1);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void JobSystem::Execute(QueuedJob &job)
+{
+    if (job.job)
+    {
+        job.job();
+    }
+
+    if (job.counter)
+    {
+        Finish(job.counter);
+    }
+}
+
+void JobSystem::Finish(JobCounter *counter)
+{
+    // Not the last job: nobody can be released or destroy the counter, so skip the lock
+    int value = counter->m_value.load(std::memory_order_relaxed);
+    while (value > 1)
+    {
+        if (counter->m_value.compare_exchange_weak(value, value - 1, std::memory_order_acq_rel))
+        {
+            return;
+        }
+    }
+
+    std::vector<JobCounter::PendingJob> continuations;
+    {
+        std::lock_guard<std::mutex> lock(counter->m_mutex);
+        if (counter->m_value.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            continuations.swap(counter->m_continuations);
+        }
+    }
+
+    // A waiter may destroy the counter from here on
+    for (auto &pending : continuations)
+    {
+        QueuedJob queuedJob;
+        queuedJob.job = std::move(pending.job);
+        queuedJob.counter = pending.counter;
+
+        if (m_queues.empty())
+        {
+            Execute(queuedJob);
+        }
+        else
+        {
+            Push(std::move(queuedJob));
+        }
+    }
+}
+
+void JobSystem::WorkerMain(size_t index)
+{
+    t_jobSystem = this;
+    t_queueIndex = index;
+    ENG_PROFILE_THREAD("Worker " + std::to_string(index));
+
+    while (!m_stopRequested.load())
+    {
+        QueuedJob job;
+        if (TryPop(index, job))
+        {
+            Execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleepingWorkers.fetch_add(1);
+        m_wakeCondition.wait(lock, [this]() { return m_queuedJobs.load() > 0 || m_stopRequested.load(); });
+        m_sleepingWorkers.fetch_sub(1);
+    }
+
+    t_jobSystem = nullptr;
+}
+
+size_t JobSystem::GetCurrentQueueIndex() const
+{
+    return t_jobSystem == this ? t_queueIndex : 0;
+}
+} // namespace eng
\ No newline at end of file
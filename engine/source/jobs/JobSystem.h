@@ -0,0 +1,221 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace eng
+{
+using Job = std::function<void()>;
+
+/**
+ * @class JobCounter
+ * @brief Counts outstanding jobs. Jobs can wait on a counter or be scheduled to run once it reaches zero.
+ *
+ * A counter must outlive its jobs; destroy it only after JobSystem::Wait() on it has returned.
+ */
+class JobCounter
+{
+  public:
+    JobCounter() = default;
+    JobCounter(const JobCounter &) = delete;
+    JobCounter &operator=(const JobCounter &) = delete;
+
+    /**
+     * @brief Checks if all jobs tracked by the counter have finished.
+     * @return true if the counter is zero, false otherwise.
+     */
+    [[nodiscard]] bool IsDone() const;
+
+  private:
+    /**
+     * @struct PendingJob
+     * @brief A job waiting for this counter to reach zero.
+     */
+    struct PendingJob
+    {
+        Job job;             ///< The job to schedule.
+        JobCounter *counter; ///< Counter decremented when the job finishes.
+    };
+
+    std::atomic<int> m_value = 0;            ///< Number of unfinished jobs.
+    std::mutex m_mutex;                      ///< Guards m_continuations.
+    std::vector<PendingJob> m_continuations; ///< Jobs released when m_value reaches zero.
+
+    friend class JobSystem;
+};
+
+/**
+ * @class JobSystem
+ * @brief Work-stealing thread pool.
+ *
+ * Every worker owns a deque: it pushes and pops its own jobs from the back and steals from the front
+ * of the other deques when it runs dry. The thread that called Init() owns deque 0 and takes part in
+ * the work whenever it waits on a counter, so a system with zero workers runs everything inline.
+ */
+class JobSystem
+{
+  public:
+    JobSystem() = default;
+    JobSystem(const JobSystem &) = delete;
+    JobSystem(JobSystem &&) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+    JobSystem &operator=(JobSystem &&) = delete;
+
+    /**
+     * @brief Destructor. Stops the workers.
+     */
+    ~JobSystem();
+
+    /**
+     * @brief Starts the worker threads.
+     * @param workerCount Number of background workers, or -1 for one less than the hardware thread count.
+     */
+    void Init(int workerCount = -1);
+
+    /**
+     * @brief Stops and joins the worker threads. Jobs that have not started are dropped.
+     */
+    void Shutdown();
+
+    /**
+     * @brief Gets the number of background worker threads.
+     * @return The worker count, not including the thread that called Init().
+     */
+    [[nodiscard]] uint32_t GetWorkerCount() const;
+
+    /**
+     * @brief Schedules a job.
+     * @param job The job to run.
+     * @param counter Optional counter incremented now and decremented when the job finishes.
+     */
+    void Run(Job job, JobCounter *counter = nullptr);
+
+    /**
+     * @brief Schedules a job that only starts once another counter has reached zero.
+     * @param job The job to run.
+     * @param counter Optional counter incremented now and decremented when the job finishes.
+     * @param dependency Counter that must reach zero before the job is started.
+     */
+    void RunAfter(JobCounter &dependency, Job job, JobCounter *counter = nullptr);
+
+    /**
+     * @brief Waits until the counter reaches zero, running queued jobs in the meantime.
+     * @param counter The counter to wait for.
+     */
+    void Wait(JobCounter &counter);
+
+    /**
+     * @brief Runs one queued job on the calling thread, if there is one.
+     * @return true if a job was run, false if nothing was queued.
+     */
+    bool RunPendingJob();
+
+    /**
+     * @brief Calls func(begin, end) over [0, count) split into ranges of at most grainSize, and waits.
+     * @param count Number of elements.
+     * @param grainSize Maximum number of elements handled by one job.
+     * @param func Callable taking (size_t begin, size_t end).
+     */
+    template <typename Func> void ParallelFor(size_t count, size_t grainSize, Func &&func)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        grainSize = std::max<size_t>(grainSize, 1);
+        if (count <= grainSize || m_workers.empty())
+        {
+            func(size_t(0), count);
+            return;
+        }
+
+        JobCounter counter;
+        size_t begin = grainSize;
+        for (; begin < count; begin += grainSize)
+        {
+            size_t end = std::min(begin + grainSize, count);
+            Run([&func, begin, end]() { func(begin, end); }, &counter);
+        }
+
+        // The calling thread takes the first range itself instead of idling
+        func(size_t(0), grainSize);
+        Wait(counter);
+    }
+
+  private:
+    /**
+     * @struct QueuedJob
+     * @brief A job together with the counter it reports to.
+     */
+    struct QueuedJob
+    {
+        Job job;                       ///< The job to run.
+        JobCounter *counter = nullptr; ///< Counter decremented when the job finishes.
+    };
+
+    /**
+     * @struct JobQueue
+     * @brief A deque of jobs owned by one thread and open to stealing by the others.
+     */
+    struct JobQueue
+    {
+        std::mutex mutex;           ///< Guards jobs.
+        std::deque<QueuedJob> jobs; ///< Owner pops from the back, thieves from the front.
+    };
+
+    /**
+     * @brief Pushes a job onto the calling thread's queue and wakes a sleeping worker.
+     * @param job The job to push.
+     */
+    void Push(QueuedJob job);
+
+    /**
+     * @brief Pops a job from the queue at index, or steals one from another queue.
+     * @param index Index of the calling thread's queue.
+     * @param outJob Receives the job.
+     * @return true if a job was found, false otherwise.
+     */
+    bool TryPop(size_t index, QueuedJob &outJob);
+
+    /**
+     * @brief Runs a job and reports its completion to its counter.
+     * @param job The job to run.
+     */
+    void Execute(QueuedJob &job);
+
+    /**
+     * @brief Decrements a counter and schedules its continuations when it reaches zero.
+     * @param counter The counter to decrement.
+     */
+    void Finish(JobCounter *counter);
+
+    /**
+     * @brief Main loop of a worker thread.
+     * @param index Index of the worker's queue.
+     */
+    void WorkerMain(size_t index);
+
+    /**
+     * @brief Gets the queue index of the calling thread (0 for threads that are not workers).
+     * @return The queue index.
+     */
+    size_t GetCurrentQueueIndex() const;
+
+  private:
+    std::vector<std::unique_ptr<JobQueue>> m_queues; ///< One queue per worker plus one for the owner thread.
+    std::vector<std::thread> m_workers;              ///< Background worker threads.
+    std::atomic<int> m_queuedJobs = 0;               ///< Jobs currently sitting in any queue.
+    std::atomic<int> m_sleepingWorkers = 0;          ///< Workers blocked on m_wakeCondition.
+    std::atomic<bool> m_stopRequested = false;       ///< Whether the workers should exit.
+    std::mutex m_sleepMutex;                         ///< Mutex paired with m_wakeCondition.
+    std::condition_variable m_wakeCondition;         ///< Wakes sleeping workers when jobs are pushed.
+};
+} // namespace eng
\ No newline at end of file
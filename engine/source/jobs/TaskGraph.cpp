@@ -0,0 +1,321 @@
+#include "jobs/TaskGraph.h"
+#include "profiling/Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+namespace eng
+{
+namespace
+{
+/**
+ * @brief Gets the current time of the steady clock.
+ * @return Nanoseconds since the clock's epoch.
+ */
+int64_t NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+} // namespace
+
+TaskId TaskGraph::AddTask(StringId name, Job function, TaskAffinity affinity)
+{
+    if (FindTask(name) != INVALID_TASK)
+    {
+        std::cerr << "Error: the task graph already has a task named " << name.GetString() << std::endl;
+        return INVALID_TASK;
+    }
+
+    auto task = std::make_unique<Task>();
+    task->name = name;
+    task->function = std::move(function);
+    task->affinity = affinity;
+    m_tasks.push_back(std::move(task));
+    m_orderDirty = true;
+    return static_cast<TaskId>(m_tasks.size() - 1);
+}
+
+bool TaskGraph::AddDependency(TaskId before, TaskId after)
+{
+    if (before >= m_tasks.size() || after >= m_tasks.size())
+    {
+        std::cerr << "Error: task graph dependency between unknown tasks " << before << " and " << after
+                  << std::endl;
+        return false;
+    }
+
+    auto &successors = m_tasks[before]->successors;
+    if (std::find(successors.begin(), successors.end(), after) != successors.end())
+    {
+        return true;
+    }
+
+    if (before == after || IsReachable(after, before))
+    {
+        std::cerr << "Error: making " << m_tasks[after]->name.GetString() << " wait for "
+                  << m_tasks[before]->name.GetString() << " would create a cycle in the task graph" << std::endl;
+        return false;
+    }
+
+    successors.push_back(after);
+    m_tasks[after]->predecessors.push_back(before);
+    m_orderDirty = true;
+    return true;
+}
+
+TaskId TaskGraph::FindTask(StringId name) const
+{
+    for (size_t i = 0; i < m_tasks.size(); ++i)
+    {
+        if (m_tasks[i]->name == name)
+        {
+            return static_cast<TaskId>(i);
+        }
+    }
+    return INVALID_TASK;
+}
+
+TaskId TaskGraph::FindTask(std::string_view name) const
+{
+    StringId id;
+    return StringId::Find(name, id) ? FindTask(id) : INVALID_TASK;
+}
+
+void TaskGraph::Run(JobSystem &jobSystem)
+{
+    if (m_tasks.empty())
+    {
+        return;
+    }
+
+    if (m_orderDirty)
+    {
+        SortTopologically();
+    }
+
+    JobCounter counter;
+    m_jobSystem = &jobSystem;
+    m_jobCounter = &counter;
+    m_remaining.store(static_cast<uint32_t>(m_tasks.size()), std::memory_order_relaxed);
+    for (auto &task : m_tasks)
+    {
+        task->pending.store(static_cast<uint32_t>(task->predecessors.size()), std::memory_order_relaxed);
+    }
+
+    m_runStartNs = NowNs();
+    for (TaskId id : m_order)
+    {
+        if (m_tasks[id]->predecessors.empty())
+        {
+            Schedule(id);
+        }
+    }
+
+    // MainThread tasks only ever run here; between them this thread helps with the queued AnyThread tasks
+    std::vector<TaskId> ready;
+    while (m_remaining.load(std::memory_order_acquire) > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mainThreadMutex);
+            ready.swap(m_mainThreadReady);
+        }
+
+        if (!ready.empty())
+        {
+            for (TaskId id : ready)
+            {
+                Execute(id);
+            }
+            ready.clear();
+        }
+        else if (!jobSystem.RunPendingJob())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // Every task has finished, but the jobs that ran them may still be reporting to the counter
+    jobSystem.Wait(counter);
+    m_jobSystem = nullptr;
+    m_jobCounter = nullptr;
+
+    RecordRun();
+}
+
+size_t TaskGraph::GetTaskCount() const
+{
+    return m_tasks.size();
+}
+
+StringId TaskGraph::GetTaskName(TaskId task) const
+{
+    return m_tasks[task]->name;
+}
+
+const TaskStats &TaskGraph::GetTaskStats(TaskId task) const
+{
+    return m_tasks[task]->stats;
+}
+
+const std::vector<TaskId> &TaskGraph::GetCriticalPath() const
+{
+    return m_criticalPath;
+}
+
+double TaskGraph::GetCriticalPathMs() const
+{
+    return m_criticalPathMs;
+}
+
+uint32_t TaskGraph::GetRunCount() const
+{
+    return m_runCount;
+}
+
+double TaskGraph::GetTotalCriticalPathMs() const
+{
+    return m_totalCriticalPathMs;
+}
+
+double TaskGraph::GetTotalWorkMs() const
+{
+    return m_totalWorkMs;
+}
+
+void TaskGraph::Schedule(TaskId task)
+{
+    if (m_tasks[task]->affinity == TaskAffinity::MainThread)
+    {
+        std::lock_guard<std::mutex> lock(m_mainThreadMutex);
+        m_mainThreadReady.push_back(task);
+        return;
+    }
+
+    m_jobSystem->Run([this, task]() { Execute(task); }, m_jobCounter);
+}
+
+void TaskGraph::Execute(TaskId id)
+{
+    Task &task = *m_tasks[id];
+    task.startNs = NowNs() - m_runStartNs;
+    {
+        // Interned text lives as long as the process, so the profiler may keep the pointer
+        ENG_PROFILE_SCOPE(task.name.GetString().c_str());
+        if (task.function)
+        {
+            task.function();
+        }
+    }
+    task.endNs = NowNs() - m_runStartNs;
+
+    for (TaskId successor : task.successors)
+    {
+        if (m_tasks[successor]->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            Schedule(successor);
+        }
+    }
+
+    m_remaining.fetch_sub(1, std::memory_order_release);
+}
+
+bool TaskGraph::IsReachable(TaskId from, TaskId to) const
+{
+    std::vector<bool> visited(m_tasks.size(), false);
+    std::vector<TaskId> stack{from};
+    while (!stack.empty())
+    {
+        TaskId id = stack.back();
+        stack.pop_back();
+        if (id == to)
+        {
+            return true;
+        }
+
+        for (TaskId successor : m_tasks[id]->successors)
+        {
+            if (!visited[successor])
+            {
+                visited[successor] = true;
+                stack.push_back(successor);
+            }
+        }
+    }
+    return false;
+}
+
+void TaskGraph::SortTopologically()
+{
+    // Kahn's algorithm; AddDependency() rejects cycles, so every task ends up in the order
+    std::vector<uint32_t> inDegree(m_tasks.size());
+    m_order.clear();
+    for (size_t i = 0; i < m_tasks.size(); ++i)
+    {
+        inDegree[i] = static_cast<uint32_t>(m_tasks[i]->predecessors.size());
+        if (inDegree[i] == 0)
+        {
+            m_order.push_back(static_cast<TaskId>(i));
+        }
+    }
+
+    for (size_t i = 0; i < m_order.size(); ++i)
+    {
+        for (TaskId successor : m_tasks[m_order[i]]->successors)
+        {
+            if (--inDegree[successor] == 0)
+            {
+                m_order.push_back(successor);
+            }
+        }
+    }
+
+    m_orderDirty = false;
+}
+
+void TaskGraph::RecordRun()
+{
+    // Longest path by duration: in topological order, a task's path extends the longest path of its predecessors
+    std::vector<double> pathMs(m_tasks.size(), 0.0);
+    std::vector<TaskId> previous(m_tasks.size(), INVALID_TASK);
+    TaskId last = INVALID_TASK;
+    double workMs = 0.0;
+    for (TaskId id : m_order)
+    {
+        Task &task = *m_tasks[id];
+        const double durationMs = static_cast<double>(task.endNs - task.startNs) / 1.0e6;
+        task.stats.lastMs = durationMs;
+        task.stats.totalMs += durationMs;
+        workMs += durationMs;
+
+        for (TaskId predecessor : task.predecessors)
+        {
+            if (previous[id] == INVALID_TASK || pathMs[predecessor] > pathMs[previous[id]])
+            {
+                previous[id] = predecessor;
+            }
+        }
+        pathMs[id] = durationMs + (previous[id] != INVALID_TASK ? pathMs[previous[id]] : 0.0);
+
+        if (last == INVALID_TASK || pathMs[id] > pathMs[last])
+        {
+            last = id;
+        }
+    }
+
+    m_criticalPath.clear();
+    for (TaskId id = last; id != INVALID_TASK; id = previous[id])
+    {
+        m_criticalPath.push_back(id);
+        ++m_tasks[id]->stats.criticalPathRuns;
+    }
+    std::reverse(m_criticalPath.begin(), m_criticalPath.end());
+
+    m_criticalPathMs = pathMs[last];
+    m_totalCriticalPathMs += m_criticalPathMs;
+    m_totalWorkMs += workMs;
+    ++m_runCount;
+}
+} // namespace eng
\ No newline at end of file
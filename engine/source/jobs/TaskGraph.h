@@ -0,0 +1,207 @@
+#pragma once
+#include "core/StringId.h"
+#include "jobs/JobSystem.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace eng
+{
+using TaskId = uint32_t;
+
+/**
+ * @enum TaskAffinity
+ * @brief Where a task may run.
+ */
+enum class TaskAffinity
+{
+    AnyThread, ///< On any worker of the job system, or on the thread running the graph.
+    MainThread ///< Only on the thread that calls TaskGraph::Run(), e.g. for window or GL context calls.
+};
+
+/**
+ * @struct TaskStats
+ * @brief Timings of one task, accumulated over all runs of its graph.
+ */
+struct TaskStats
+{
+    double lastMs = 0.0;           ///< Duration in the last run.
+    double totalMs = 0.0;          ///< Summed duration over all runs.
+    uint32_t criticalPathRuns = 0; ///< Number of runs in which the task was on the critical path.
+};
+
+/**
+ * @class TaskGraph
+ * @brief A set of named tasks with explicit dependencies, run once per call to Run().
+ *
+ * A task starts as soon as all tasks it depends on have finished. Tasks without a path between them run at
+ * the same time on the job system's workers, while MainThread tasks are kept on the calling thread, which
+ * otherwise helps with the queued jobs. Every run measures each task and finds the critical path: the chain
+ * of dependent tasks with the largest summed duration, which bounds the run time however many threads there
+ * are. Tasks and dependencies are meant to be set up once and must not change during Run().
+ */
+class TaskGraph
+{
+  public:
+    static constexpr TaskId INVALID_TASK = UINT32_MAX;
+
+    TaskGraph() = default;
+    TaskGraph(const TaskGraph &) = delete;
+    TaskGraph &operator=(const TaskGraph &) = delete;
+
+    /**
+     * @brief Adds a task.
+     * @param name Unique name, used to find the task and to label it in profiles and reports.
+     * @param function The work of the task.
+     * @param affinity Where the task may run.
+     * @return The ID of the task, or INVALID_TASK if the name is taken.
+     */
+    TaskId AddTask(StringId name, Job function, TaskAffinity affinity = TaskAffinity::AnyThread);
+
+    /**
+     * @brief Makes a task wait for another one.
+     * @param before The task that must finish first.
+     * @param after The task that waits.
+     * @return false if an ID is invalid or the dependency would create a cycle.
+     */
+    bool AddDependency(TaskId before, TaskId after);
+
+    /**
+     * @brief Finds a task by name.
+     * @param name The name.
+     * @return The ID of the task, or INVALID_TASK.
+     */
+    [[nodiscard]] TaskId FindTask(StringId name) const;
+
+    /**
+     * @brief Finds a task by name without interning it.
+     * @param name The name.
+     * @return The ID of the task, or INVALID_TASK.
+     */
+    [[nodiscard]] TaskId FindTask(std::string_view name) const;
+
+    /**
+     * @brief Runs every task once and waits for all of them.
+     * @param jobSystem Runs the AnyThread tasks; without workers everything runs on the calling thread.
+     */
+    void Run(JobSystem &jobSystem);
+
+    /**
+     * @brief Gets the number of tasks.
+     * @return The task count.
+     */
+    [[nodiscard]] size_t GetTaskCount() const;
+
+    /**
+     * @brief Gets the name of a task.
+     * @param task The task.
+     * @return The name.
+     */
+    [[nodiscard]] StringId GetTaskName(TaskId task) const;
+
+    /**
+     * @brief Gets the timings of a task.
+     * @param task The task.
+     * @return The timings.
+     */
+    [[nodiscard]] const TaskStats &GetTaskStats(TaskId task) const;
+
+    /**
+     * @brief Gets the critical path of the last run.
+     * @return The tasks of the path, first to last.
+     */
+    [[nodiscard]] const std::vector<TaskId> &GetCriticalPath() const;
+
+    /**
+     * @brief Gets the summed duration of the critical path of the last run.
+     * @return The duration in milliseconds.
+     */
+    [[nodiscard]] double GetCriticalPathMs() const;
+
+    /**
+     * @brief Gets the number of completed runs.
+     * @return The run count.
+     */
+    [[nodiscard]] uint32_t GetRunCount() const;
+
+    /**
+     * @brief Gets the summed duration of the critical paths of all runs.
+     * @return The duration in milliseconds.
+     */
+    [[nodiscard]] double GetTotalCriticalPathMs() const;
+
+    /**
+     * @brief Gets the summed duration of all tasks of all runs.
+     * @return The duration in milliseconds.
+     */
+    [[nodiscard]] double GetTotalWorkMs() const;
+
+  private:
+    /**
+     * @struct Task
+     * @brief A node of the graph.
+     */
+    struct Task
+    {
+        StringId name;                                   ///< Unique name; its text lives as long as the process.
+        Job function;                                    ///< The work.
+        TaskAffinity affinity = TaskAffinity::AnyThread; ///< Where the task may run.
+        std::vector<TaskId> successors;                  ///< Tasks waiting for this one.
+        std::vector<TaskId> predecessors;                ///< Tasks this one waits for.
+        std::atomic<uint32_t> pending = 0;               ///< Unfinished predecessors in the current run.
+        int64_t startNs = 0;                             ///< Start in the current run, relative to the run start.
+        int64_t endNs = 0;                               ///< End in the current run, relative to the run start.
+        TaskStats stats;                                 ///< Accumulated timings.
+    };
+
+    /**
+     * @brief Hands a task whose predecessors have finished to the thread that may run it.
+     * @param task The task.
+     */
+    void Schedule(TaskId task);
+
+    /**
+     * @brief Runs a task, then schedules the successors it was the last predecessor of.
+     * @param task The task.
+     */
+    void Execute(TaskId task);
+
+    /**
+     * @brief Checks if a task can be reached from another one through successors.
+     * @param from The start task.
+     * @param to The task looked for.
+     * @return true if there is a path.
+     */
+    [[nodiscard]] bool IsReachable(TaskId from, TaskId to) const;
+
+    /**
+     * @brief Orders the tasks so that every task comes after its predecessors.
+     */
+    void SortTopologically();
+
+    /**
+     * @brief Finds the critical path of the run that just finished and accumulates the timings.
+     */
+    void RecordRun();
+
+  private:
+    std::vector<std::unique_ptr<Task>> m_tasks; ///< Tasks by ID; heap-allocated for their atomic counter.
+    std::vector<TaskId> m_order;                ///< Tasks in topological order.
+    bool m_orderDirty = false;                  ///< Whether m_order must be rebuilt.
+    std::vector<TaskId> m_criticalPath;         ///< Critical path of the last run.
+    double m_criticalPathMs = 0.0;              ///< Duration of the critical path of the last run.
+    double m_totalCriticalPathMs = 0.0;         ///< Summed critical path durations.
+    double m_totalWorkMs = 0.0;                 ///< Summed task durations.
+    uint32_t m_runCount = 0;                    ///< Completed runs.
+
+    JobSystem *m_jobSystem = nullptr;           ///< Job system of the current run.
+    JobCounter *m_jobCounter = nullptr;         ///< Counts the AnyThread tasks of the current run.
+    int64_t m_runStartNs = 0;                   ///< Start of the current run.
+    std::atomic<uint32_t> m_remaining = 0;      ///< Unfinished tasks of the current run.
+    std::mutex m_mainThreadMutex;               ///< Guards m_mainThreadReady.
+    std::vector<TaskId> m_mainThreadReady;      ///< MainThread tasks ready to run.
+};
+} // namespace eng
\ No newline at end of file
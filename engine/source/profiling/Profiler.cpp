@@ -0,0 +1,209 @@
+#include "profiling/Profiler.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace eng
+{
+namespace
+{
+constexpr size_t EVENTS_PER_THREAD = 1 << 16;
+
+/**
+ * @struct ThreadBuffer
+ * @brief Single-producer ring buffer of events recorded by one thread.
+ */
+struct ThreadBuffer
+{
+    std::array<ProfileEvent, EVENTS_PER_THREAD> events; ///< Ring storage.
+    std::atomic<uint64_t> head = 0;                     ///< Total number of events ever written.
+    uint32_t threadId = 0;                              ///< Id used for the thread in traces.
+    std::string name;                                   ///< Name of the thread, if set.
+};
+
+/**
+ * @struct ProfilerState
+ * @brief Global registry of thread buffers.
+ */
+struct ProfilerState
+{
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now(); ///< Time zero.
+    std::mutex mutex;                                                              ///< Guards buffers.
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;                            ///< All thread buffers.
+};
+
+ProfilerState &GetState()
+{
+    static ProfilerState state;
+    return state;
+}
+
+ThreadBuffer &GetThreadBuffer()
+{
+    // Buffers are owned by the registry so they outlive their threads and can still be exported
+    thread_local ThreadBuffer *buffer = nullptr;
+    if (!buffer)
+    {
+        auto &state = GetState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.buffers.push_back(std::make_unique<ThreadBuffer>());
+        buffer = state.buffers.back().get();
+        buffer->threadId = static_cast<uint32_t>(state.buffers.size());
+    }
+    return *buffer;
+}
+
+void Push(const ProfileEvent &event)
+{
+    auto &buffer = GetThreadBuffer();
+    uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    buffer.events[head % EVENTS_PER_THREAD] = event;
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void WriteEscaped(std::ofstream &out, const char *text)
+{
+    for (const char *c = text; *c; ++c)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            out << '\\';
+        }
+        out << *c;
+    }
+}
+
+void WriteMicroseconds(std::ofstream &out, uint64_t nanoseconds)
+{
+    // Exact integer formatting: a double at the default stream precision keeps only six digits, which rounds
+    // timestamps a few seconds into a run to tens of microseconds
+    const uint64_t fraction = nanoseconds % 1000;
+    out << nanoseconds / 1000 << '.' << static_cast<char>('0' + fraction / 100)
+        << static_cast<char>('0' + fraction / 10 % 10) << static_cast<char>('0' + fraction % 10);
+}
+} // namespace
+
+uint64_t Profiler::Now()
+{
+    auto elapsed = std::chrono::steady_clock::now() - GetState().epoch;
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+void Profiler::RecordZone(const char *name, uint64_t startNs, uint64_t endNs)
+{
+    ProfileEvent event;
+    event.name = name;
+    event.startNs = startNs;
+    event.durationNs = endNs - startNs;
+    event.type = ProfileEvent::Type::Zone;
+    Push(event);
+}
+
+void Profiler::RecordCounter(const char *name, double value)
+{
+    ProfileEvent event;
+    event.name = name;
+    event.startNs = Now();
+    event.value = value;
+    event.type = ProfileEvent::Type::Counter;
+    Push(event);
+}
+
+void Profiler::MarkFrame()
+{
+    ProfileEvent event;
+    event.name = "Frame";
+    event.startNs = Now();
+    event.type = ProfileEvent::Type::Frame;
+    Push(event);
+}
+
+void Profiler::SetThreadName(const std::string &name)
+{
+    auto &buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(GetState().mutex);
+    buffer.name = name;
+}
+
+bool Profiler::WriteChromeTrace(const std::string &path)
+{
+    std::ofstream out(path);
+    if (!out)
+    {
+        return false;
+    }
+
+    auto &state = GetState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    auto separator = [&out, &first]() {
+        if (!first)
+        {
+            out << ",\n";
+        }
+        first = false;
+    };
+
+    std::vector<ProfileEvent> events;
+    for (auto &buffer : state.buffers)
+    {
+        if (!buffer->name.empty())
+        {
+            separator();
+            out << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->threadId
+                << ",\"args\":{\"name\":\"";
+            WriteEscaped(out, buffer->name.c_str());
+            out << "\"}}";
+        }
+
+        // Copy the live window, then drop whatever the writer overwrote while we were copying
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t begin = head > EVENTS_PER_THREAD ? head - EVENTS_PER_THREAD : 0;
+        events.clear();
+        for (uint64_t i = begin; i < head; ++i)
+        {
+            events.push_back(buffer->events[i % EVENTS_PER_THREAD]);
+        }
+        uint64_t newHead = buffer->head.load(std::memory_order_acquire);
+        size_t skip = 0;
+        if (newHead > EVENTS_PER_THREAD && newHead - EVENTS_PER_THREAD > begin)
+        {
+            skip = static_cast<size_t>(std::min<uint64_t>(newHead - EVENTS_PER_THREAD - begin, events.size()));
+        }
+
+        for (size_t i = skip; i < events.size(); ++i)
+        {
+            const auto &event = events[i];
+            separator();
+            out << "{\"name\":\"";
+            WriteEscaped(out, event.name ? event.name : "");
+            out << "\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"ts\":";
+            WriteMicroseconds(out, event.startNs);
+            switch (event.type)
+            {
+            case ProfileEvent::Type::Zone:
+                out << ",\"ph\":\"X\",\"dur\":";
+                WriteMicroseconds(out, event.durationNs);
+                out << "}";
+                break;
+            case ProfileEvent::Type::Counter:
+                out << ",\"ph\":\"C\",\"args\":{\"value\":" << event.value << "}}";
+                break;
+            case ProfileEvent::Type::Frame:
+                out << ",\"ph\":\"i\",\"s\":\"g\"}";
+                break;
+            }
+        }
+    }
+
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
+} // namespace eng
\ No newline at end of file
@@ -0,0 +1,149 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+#ifndef ENG_PROFILER_ENABLED
+#define ENG_PROFILER_ENABLED 0
+#endif
+
+namespace eng
+{
+/**
+ * @struct ProfileEvent
+ * @brief A single recorded zone, counter sample or frame marker.
+ */
+struct ProfileEvent
+{
+    /**
+     * @enum Type
+     * @brief Kind of the recorded event.
+     */
+    enum class Type : uint32_t
+    {
+        Zone,    ///< A timed scope with a start and a duration.
+        Counter, ///< A sampled value.
+        Frame    ///< End of a frame.
+    };
+
+    const char *name = nullptr; ///< Static name of the event.
+    uint64_t startNs = 0;       ///< Start (or sample) time in nanoseconds since profiler start.
+    uint64_t durationNs = 0;    ///< Duration of a zone in nanoseconds.
+    double value = 0.0;         ///< Value of a counter sample.
+    Type type = Type::Zone;     ///< Kind of the event.
+};
+
+/**
+ * @class Profiler
+ * @brief Low-overhead CPU instrumentation recorded into per-thread ring buffers.
+ *
+ * Each thread writes into its own fixed-size ring buffer without locks; once full, the oldest events
+ * are overwritten. WriteChromeTrace() can be called at any time from any thread and exports the
+ * events still in the buffers as Chrome trace JSON, readable by chrome://tracing and Perfetto.
+ * Use the ENG_PROFILE_* macros, which compile to nothing unless ENG_PROFILER_ENABLED is set.
+ */
+class Profiler
+{
+  public:
+    /**
+     * @brief Gets the current profiler time.
+     * @return Nanoseconds since the profiler's epoch.
+     */
+    static uint64_t Now();
+
+    /**
+     * @brief Records a finished zone on the calling thread.
+     * @param name Static name of the zone.
+     * @param startNs Start time returned by Now().
+     * @param endNs End time returned by Now().
+     */
+    static void RecordZone(const char *name, uint64_t startNs, uint64_t endNs);
+
+    /**
+     * @brief Records a counter sample on the calling thread.
+     * @param name Static name of the counter.
+     * @param value The sampled value.
+     */
+    static void RecordCounter(const char *name, double value);
+
+    /**
+     * @brief Records the end of a frame.
+     */
+    static void MarkFrame();
+
+    /**
+     * @brief Names the calling thread in exported traces.
+     * @param name The thread name.
+     */
+    static void SetThreadName(const std::string &name);
+
+    /**
+     * @brief Writes all buffered events as Chrome trace / Perfetto JSON.
+     * @param path Output file path.
+     * @return true if the file was written, false otherwise.
+     */
+    static bool WriteChromeTrace(const std::string &path);
+};
+
+/**
+ * @class ProfileScope
+ * @brief Records a zone covering its own lifetime.
+ */
+class ProfileScope
+{
+  public:
+    /**
+     * @brief Starts the zone.
+     * @param name Static name of the zone.
+     */
+    explicit ProfileScope(const char *name) : m_name(name), m_startNs(Profiler::Now())
+    {
+    }
+
+    /**
+     * @brief Ends and records the zone.
+     */
+    ~ProfileScope()
+    {
+        Profiler::RecordZone(m_name, m_startNs, Profiler::Now());
+    }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+  private:
+    const char *m_name; ///< Static name of the zone.
+    uint64_t m_startNs; ///< Start time of the zone.
+};
+} // namespace eng
+
+#define ENG_PROFILE_CONCAT_INNER(a, b) a##b
+#define ENG_PROFILE_CONCAT(a, b) ENG_PROFILE_CONCAT_INNER(a, b)
+
+#if ENG_PROFILER_ENABLED
+/**
+ * @brief Times the enclosing scope under a static name.
+ */
+#define ENG_PROFILE_SCOPE(name) ::eng::ProfileScope ENG_PROFILE_CONCAT(profileScope, __LINE__)(name)
+/**
+ * @brief Times the enclosing function.
+ */
+#define ENG_PROFILE_FUNCTION() ENG_PROFILE_SCOPE(__func__)
+/**
+ * @brief Records a counter sample.
+ */
+#define ENG_PROFILE_COUNTER(name, value) ::eng::Profiler::RecordCounter(name, static_cast<double>(value))
+/**
+ * @brief Marks the end of a frame.
+ */
+#define ENG_PROFILE_FRAME() ::eng::Profiler::MarkFrame()
+/**
+ * @brief Names the calling thread in traces.
+ */
+#define ENG_PROFILE_THREAD(name) ::eng::Profiler::SetThreadName(name)
+#else
+#define ENG_PROFILE_SCOPE(name) ((void)0)
+#define ENG_PROFILE_FUNCTION() ((void)0)
+#define ENG_PROFILE_COUNTER(name, value) ((void)0)
+#define ENG_PROFILE_FRAME() ((void)0)
+#define ENG_PROFILE_THREAD(name) ((void)0)
+#endif
\ No newline at end of file
@@ -0,0 +1,201 @@
+#include "render/FrustumCuller.h"
+#include <algorithm>
+#include <cmath>
+#include <glm/glm.hpp>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENG_CULLING_SSE 1
+#include <xmmintrin.h>
+#else
+#define ENG_CULLING_SSE 0
+#endif
+
+namespace eng
+{
+void FrustumCuller::Clear()
+{
+    m_blocks.clear();
+    m_count = 0;
+}
+
+void FrustumCuller::Reserve(size_t count)
+{
+    m_blocks.reserve((count + 3) / 4);
+}
+
+void FrustumCuller::Add(const glm::mat4 &modelMatrix, const BoundingBox &box, const BoundingSphere &sphere)
+{
+    if (!box.IsValid() || !sphere.IsValid())
+    {
+        AddUnbounded();
+        return;
+    }
+
+    // Same results as BoundingBox::Transform() and BoundingSphere::Transform(), written out so the
+    // matrix columns are read once and the sphere needs a single square root
+    const glm::vec3 column0(modelMatrix[0]);
+    const glm::vec3 column1(modelMatrix[1]);
+    const glm::vec3 column2(modelMatrix[2]);
+    const glm::vec3 translation(modelMatrix[3]);
+
+    const glm::vec3 localCenter = box.GetCenter();
+    const glm::vec3 localExtents = box.GetExtents();
+    const glm::vec3 boxCenter =
+        column0 * localCenter.x + column1 * localCenter.y + column2 * localCenter.z + translation;
+    const glm::vec3 boxExtents = glm::abs(column0) * localExtents.x + glm::abs(column1) * localExtents.y +
+                                 glm::abs(column2) * localExtents.z;
+
+    const glm::vec3 sphereCenter =
+        column0 * sphere.center.x + column1 * sphere.center.y + column2 * sphere.center.z + translation;
+    const float scaleSquared =
+        std::max({glm::dot(column0, column0), glm::dot(column1, column1), glm::dot(column2, column2)});
+
+    size_t lane = 0;
+    Block &block = NextSlot(lane);
+    block.boxCenterX[lane] = boxCenter.x;
+    block.boxCenterY[lane] = boxCenter.y;
+    block.boxCenterZ[lane] = boxCenter.z;
+    block.boxExtentX[lane] = boxExtents.x;
+    block.boxExtentY[lane] = boxExtents.y;
+    block.boxExtentZ[lane] = boxExtents.z;
+    block.sphereCenterX[lane] = sphereCenter.x;
+    block.sphereCenterY[lane] = sphereCenter.y;
+    block.sphereCenterZ[lane] = sphereCenter.z;
+    block.sphereRadius[lane] = sphere.radius * std::sqrt(scaleSquared);
+}
+
+void FrustumCuller::AddUnbounded()
+{
+    // Volumes as large as a float allows reach across every plane
+    constexpr float HUGE_EXTENT = std::numeric_limits<float>::max();
+
+    size_t lane = 0;
+    Block &block = NextSlot(lane);
+    block.boxCenterX[lane] = 0.0f;
+    block.boxCenterY[lane] = 0.0f;
+    block.boxCenterZ[lane] = 0.0f;
+    block.boxExtentX[lane] = HUGE_EXTENT;
+    block.boxExtentY[lane] = HUGE_EXTENT;
+    block.boxExtentZ[lane] = HUGE_EXTENT;
+    block.sphereCenterX[lane] = 0.0f;
+    block.sphereCenterY[lane] = 0.0f;
+    block.sphereCenterZ[lane] = 0.0f;
+    block.sphereRadius[lane] = HUGE_EXTENT;
+}
+
+size_t FrustumCuller::GetCount() const
+{
+    return m_count;
+}
+
+size_t FrustumCuller::Cull(const Frustum &frustum, std::vector<uint32_t> &outVisible) const
+{
+    outVisible.clear();
+
+#if ENG_CULLING_SSE
+    __m128 normalX[Frustum::PLANE_COUNT];
+    __m128 normalY[Frustum::PLANE_COUNT];
+    __m128 normalZ[Frustum::PLANE_COUNT];
+    __m128 distance[Frustum::PLANE_COUNT];
+    __m128 absNormalX[Frustum::PLANE_COUNT];
+    __m128 absNormalY[Frustum::PLANE_COUNT];
+    __m128 absNormalZ[Frustum::PLANE_COUNT];
+    for (int i = 0; i < Frustum::PLANE_COUNT; ++i)
+    {
+        const glm::vec4 &plane = frustum.planes[i];
+        normalX[i] = _mm_set1_ps(plane.x);
+        normalY[i] = _mm_set1_ps(plane.y);
+        normalZ[i] = _mm_set1_ps(plane.z);
+        distance[i] = _mm_set1_ps(plane.w);
+        absNormalX[i] = _mm_set1_ps(std::fabs(plane.x));
+        absNormalY[i] = _mm_set1_ps(std::fabs(plane.y));
+        absNormalZ[i] = _mm_set1_ps(std::fabs(plane.z));
+    }
+    const __m128 zero = _mm_setzero_ps();
+#endif
+
+    for (size_t blockIndex = 0; blockIndex < m_blocks.size(); ++blockIndex)
+    {
+        const Block &block = m_blocks[blockIndex];
+        const size_t first = blockIndex * 4;
+        const size_t laneCount = std::min<size_t>(4, m_count - first);
+
+#if ENG_CULLING_SSE
+        const __m128 boxCenterX = _mm_load_ps(block.boxCenterX);
+        const __m128 boxCenterY = _mm_load_ps(block.boxCenterY);
+        const __m128 boxCenterZ = _mm_load_ps(block.boxCenterZ);
+        const __m128 boxExtentX = _mm_load_ps(block.boxExtentX);
+        const __m128 boxExtentY = _mm_load_ps(block.boxExtentY);
+        const __m128 boxExtentZ = _mm_load_ps(block.boxExtentZ);
+        const __m128 sphereCenterX = _mm_load_ps(block.sphereCenterX);
+        const __m128 sphereCenterY = _mm_load_ps(block.sphereCenterY);
+        const __m128 sphereCenterZ = _mm_load_ps(block.sphereCenterZ);
+        const __m128 sphereRadius = _mm_load_ps(block.sphereRadius);
+
+        __m128 outside = zero;
+        for (int i = 0; i < Frustum::PLANE_COUNT; ++i)
+        {
+            // Box: signed distance of the center plus the extents projected onto the normal
+            __m128 boxDistance = _mm_add_ps(_mm_mul_ps(normalX[i], boxCenterX), distance[i]);
+            boxDistance = _mm_add_ps(boxDistance, _mm_mul_ps(normalY[i], boxCenterY));
+            boxDistance = _mm_add_ps(boxDistance, _mm_mul_ps(normalZ[i], boxCenterZ));
+            __m128 boxRadius = _mm_mul_ps(absNormalX[i], boxExtentX);
+            boxRadius = _mm_add_ps(boxRadius, _mm_mul_ps(absNormalY[i], boxExtentY));
+            boxRadius = _mm_add_ps(boxRadius, _mm_mul_ps(absNormalZ[i], boxExtentZ));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(boxDistance, boxRadius), zero));
+
+            __m128 sphereDistance = _mm_add_ps(_mm_mul_ps(normalX[i], sphereCenterX), distance[i]);
+            sphereDistance = _mm_add_ps(sphereDistance, _mm_mul_ps(normalY[i], sphereCenterY));
+            sphereDistance = _mm_add_ps(sphereDistance, _mm_mul_ps(normalZ[i], sphereCenterZ));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(sphereDistance, sphereRadius), zero));
+        }
+
+        const int outsideMask = _mm_movemask_ps(outside);
+        for (size_t lane = 0; lane < laneCount; ++lane)
+        {
+            if ((outsideMask & (1 << lane)) == 0)
+            {
+                outVisible.push_back(static_cast<uint32_t>(first + lane));
+            }
+        }
+#else
+        for (size_t lane = 0; lane < laneCount; ++lane)
+        {
+            bool isOutside = false;
+            for (int i = 0; i < Frustum::PLANE_COUNT && !isOutside; ++i)
+            {
+                const glm::vec4 &plane = frustum.planes[i];
+                const float boxDistance = plane.x * block.boxCenterX[lane] + plane.y * block.boxCenterY[lane] +
+                                          plane.z * block.boxCenterZ[lane] + plane.w;
+                const float boxRadius = std::fabs(plane.x) * block.boxExtentX[lane] +
+                                        std::fabs(plane.y) * block.boxExtentY[lane] +
+                                        std::fabs(plane.z) * block.boxExtentZ[lane];
+                const float sphereDistance = plane.x * block.sphereCenterX[lane] +
+                                             plane.y * block.sphereCenterY[lane] +
+                                             plane.z * block.sphereCenterZ[lane] + plane.w;
+                isOutside = boxDistance + boxRadius < 0.0f || sphereDistance + block.sphereRadius[lane] < 0.0f;
+            }
+
+            if (!isOutside)
+            {
+                outVisible.push_back(static_cast<uint32_t>(first + lane));
+            }
+        }
+#endif
+    }
+
+    return outVisible.size();
+}
+
+FrustumCuller::Block &FrustumCuller::NextSlot(size_t &lane)
+{
+    lane = m_count % 4;
+    if (lane == 0)
+    {
+        m_blocks.emplace_back();
+    }
+    ++m_count;
+    return m_blocks.back();
+}
+} // namespace eng
\ No newline at end of file
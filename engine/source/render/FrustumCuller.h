@@ -0,0 +1,89 @@
+#pragma once
+#include "core/Bounds.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace eng
+{
+/**
+ * @class FrustumCuller
+ * @brief Tests many transformed bounding volumes against a frustum at once.
+ *
+ * Add() transforms an object's local box and sphere to world space and stores them in blocks of four, one
+ * array per component, so Cull() can test four objects per plane with SSE. An object is culled when its box
+ * or its sphere lies entirely outside one of the planes; each volume is the tighter fit for different shapes
+ * and rotations, so together they cull more than either alone.
+ */
+class FrustumCuller
+{
+  public:
+    /**
+     * @brief Removes all objects.
+     */
+    void Clear();
+
+    /**
+     * @brief Reserves storage for a number of objects.
+     * @param count Number of objects.
+     */
+    void Reserve(size_t count);
+
+    /**
+     * @brief Adds an object.
+     * @param modelMatrix Local to world transformation of the object.
+     * @param box Local bounding box.
+     * @param sphere Local bounding sphere.
+     */
+    void Add(const glm::mat4 &modelMatrix, const BoundingBox &box, const BoundingSphere &sphere);
+
+    /**
+     * @brief Adds an object without bounds, which is never culled.
+     */
+    void AddUnbounded();
+
+    /**
+     * @brief Gets the number of objects added since the last Clear().
+     * @return The object count.
+     */
+    [[nodiscard]] size_t GetCount() const;
+
+    /**
+     * @brief Tests all objects against a frustum.
+     * @param frustum The frustum.
+     * @param outVisible Cleared, then receives the indices of the visible objects in the order they were added.
+     * @return Number of visible objects.
+     */
+    size_t Cull(const Frustum &frustum, std::vector<uint32_t> &outVisible) const;
+
+  private:
+    /**
+     * @struct Block
+     * @brief World space bounds of four objects, one array per component.
+     */
+    struct alignas(16) Block
+    {
+        float boxCenterX[4];    ///< Box centers.
+        float boxCenterY[4];    ///< Box centers.
+        float boxCenterZ[4];    ///< Box centers.
+        float boxExtentX[4];    ///< Box half sizes.
+        float boxExtentY[4];    ///< Box half sizes.
+        float boxExtentZ[4];    ///< Box half sizes.
+        float sphereCenterX[4]; ///< Sphere centers.
+        float sphereCenterY[4]; ///< Sphere centers.
+        float sphereCenterZ[4]; ///< Sphere centers.
+        float sphereRadius[4];  ///< Sphere radii.
+    };
+
+    /**
+     * @brief Gets the block and lane of the next object, adding a block when needed.
+     * @param lane Receives the lane within the block.
+     * @return The block.
+     */
+    Block &NextSlot(size_t &lane);
+
+  private:
+    std::vector<Block> m_blocks; ///< Bounds, four objects per block.
+    size_t m_count = 0;          ///< Number of objects added.
+};
+} // namespace eng
\ No newline at end of file
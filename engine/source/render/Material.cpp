@@ -1,4 +1,5 @@
 #include "render/Material.h"
+#include "Engine.h"
 #include "graphics/ShaderProgram.h"
 
 namespace eng
@@ -13,14 +14,38 @@ ShaderProgram *Material::GetShaderProgram()
     return m_shaderProgram.get();
 }
 
-void Material::SetParam(const std::string &name, float value)
+void Material::SetParam(StringId name, float value)
 {
     m_floatParams[name] = value;
+    m_paramsDirty = true;
 }
 
-void Material::SetParam(const std::string &name, float v0, float v1)
+void Material::SetParam(StringId name, float v0, float v1)
 {
     m_float2Params[name] = {v0, v1};
+    m_paramsDirty = true;
+}
+
+void Material::SetParam(const std::string &name, float value)
+{
+    SetParam(StringId(name), value);
+}
+
+void Material::SetParam(const std::string &name, float v0, float v1)
+{
+    SetParam(StringId(name), v0, v1);
+}
+
+void Material::CommitParams()
+{
+    if (!m_paramsDirty)
+    {
+        return;
+    }
+
+    m_committedFloatParams = m_floatParams;
+    m_committedFloat2Params = m_float2Params;
+    m_paramsDirty = false;
 }
 
 void Material::Bind()
@@ -30,14 +55,15 @@ void Material::Bind()
         return;
     }
 
+    ++Engine::GetInstance().GetGraphicsAPI().GetRenderStats().materialBinds;
     m_shaderProgram->Bind();
 
-    for (auto &param : m_floatParams)
+    for (auto &param : m_committedFloatParams)
     {
         m_shaderProgram->SetUniform(param.first, param.second);
     }
 
-    for (auto &param : m_float2Params)
+    for (auto &param : m_committedFloat2Params)
     {
         m_shaderProgram->SetUniform(param.first, param.second.first, param.second.second);
     }
@@ -1,4 +1,5 @@
 #pragma once
+#include "core/StringId.h"
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -28,27 +29,54 @@ class Material
 
     /**
      * @brief Sets a float parameter (uniform) for the material.
-     * @param name The name of the parameter.
+     * @param name The interned name of the parameter.
+     * @param value The value to set.
+     */
+    void SetParam(StringId name, float value);
+
+    /**
+     * @brief Sets a vec2 parameter (two floats) for the material.
+     * @param name The interned name of the parameter.
+     * @param v0 The first component.
+     * @param v1 The second component.
+     */
+    void SetParam(StringId name, float v0, float v1);
+
+    /**
+     * @brief Sets a float parameter (uniform) for the material.
+     * @param name The name of the parameter; interned on every call.
      * @param value The value to set.
      */
     void SetParam(const std::string &name, float value);
 
     /**
      * @brief Sets a vec2 parameter (two floats) for the material.
-     * @param name The name of the parameter.
+     * @param name The name of the parameter; interned on every call.
      * @param v0 The first component.
      * @param v1 The second component.
      */
     void SetParam(const std::string &name, float v0, float v1);
 
     /**
-     * @brief Binds the material (shader and parameters) for rendering.
+     * @brief Copies the parameters set so far to the render side, used by Bind().
+     *
+     * Called by RenderQueue::Flip() while the renderer is idle, so SetParam() and Bind() can run on
+     * different threads.
+     */
+    void CommitParams();
+
+    /**
+     * @brief Binds the material (shader and committed parameters) for rendering.
      */
     void Bind();
 
   private:
-    std::shared_ptr<ShaderProgram> m_shaderProgram;       ///< The shader program linked to this material.
-    std::unordered_map<std::string, float> m_floatParams; ///< Cached float parameters.
-    std::unordered_map<std::string, std::pair<float, float>> m_float2Params; ///< Cached vec2 parameters.
+    std::shared_ptr<ShaderProgram> m_shaderProgram;    ///< The shader program linked to this material.
+    std::unordered_map<StringId, float> m_floatParams; ///< Cached float parameters.
+    std::unordered_map<StringId, std::pair<float, float>> m_float2Params; ///< Cached vec2 parameters.
+    bool m_paramsDirty = false; ///< Whether parameters changed since the last commit.
+
+    std::unordered_map<StringId, float> m_committedFloatParams;                    ///< Float params for Bind().
+    std::unordered_map<StringId, std::pair<float, float>> m_committedFloat2Params; ///< Vec2 params for Bind().
 };
 } // namespace eng
\ No newline at end of file
@@ -1,6 +1,10 @@
 #include "render/Mesh.h"
 #include "Engine.h"
 #include "graphics/GraphicsAPI.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <glm/glm.hpp>
 
 namespace eng
 {
@@ -13,24 +17,6 @@ Mesh::Mesh(const VertexLayout &layout, const std::vector<float> &vertices, const
     m_VBO = graphicsAPI.CreateVertexBuffer(vertices);
     m_EBO = graphicsAPI.CreateIndexBuffer(indices);
 
-    glGenVertexArrays(1, &m_VAO);
-    glBindVertexArray(m_VAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-
-    for (auto &element : m_vertexLayout.elements)
-    {
-        glVertexAttribPointer(element.index, element.size, element.type, GL_FALSE, m_vertexLayout.stride,
-                              (void *)(uintptr_t)element.offset);
-        glEnableVertexAttribArray(element.index);
-    }
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
-
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
     if (m_vertexLayout.stride > 0)
     {
         m_vertexCount = (vertices.size() * sizeof(float)) / m_vertexLayout.stride;
@@ -40,6 +26,8 @@ Mesh::Mesh(const VertexLayout &layout, const std::vector<float> &vertices, const
         m_vertexCount = 0;
     }
     m_indexCount = indices.size();
+
+    ComputeBounds(vertices);
 }
 
 Mesh::Mesh(const VertexLayout &layout, const std::vector<float> &vertices)
@@ -50,6 +38,20 @@ Mesh::Mesh(const VertexLayout &layout, const std::vector<float> &vertices)
 
     m_VBO = graphicsAPI.CreateVertexBuffer(vertices);
 
+    if (m_vertexLayout.stride > 0)
+    {
+        m_vertexCount = (vertices.size() * sizeof(float)) / m_vertexLayout.stride;
+    }
+    else
+    {
+        m_vertexCount = 0;
+    }
+
+    ComputeBounds(vertices);
+}
+
+void Mesh::CreateVertexArray() const
+{
     glGenVertexArrays(1, &m_VAO);
     glBindVertexArray(m_VAO);
 
@@ -62,33 +64,98 @@ Mesh::Mesh(const VertexLayout &layout, const std::vector<float> &vertices)
         glEnableVertexAttribArray(element.index);
     }
 
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-    if (m_vertexLayout.stride > 0)
-    {
-        m_vertexCount = (vertices.size() * sizeof(float)) / m_vertexLayout.stride;
-    }
-    else
+    if (m_EBO != 0)
     {
-        m_vertexCount = 0;
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
     }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
 void Mesh::Bind() const
 {
+    if (m_VAO == 0)
+    {
+        CreateVertexArray();
+    }
     glBindVertexArray(m_VAO);
+    ++Engine::GetInstance().GetGraphicsAPI().GetRenderStats().vertexArrayBinds;
 }
 
 void Mesh::Draw() const
 {
+    auto &stats = Engine::GetInstance().GetGraphicsAPI().GetRenderStats();
+    ++stats.drawCalls;
+
     if (m_indexCount > 0)
     {
         glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(m_indexCount), GL_UNSIGNED_INT, 0);
+        stats.triangles += m_indexCount / 3;
     }
     else
     {
         glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_vertexCount));
+        stats.triangles += m_vertexCount / 3;
+    }
+}
+
+const BoundingBox &Mesh::GetBoundingBox() const
+{
+    return m_boundingBox;
+}
+
+const BoundingSphere &Mesh::GetBoundingSphere() const
+{
+    return m_boundingSphere;
+}
+
+size_t Mesh::GetTriangleCount() const
+{
+    return (m_indexCount > 0 ? m_indexCount : m_vertexCount) / 3;
+}
+
+void Mesh::ComputeBounds(const std::vector<float> &vertices)
+{
+    auto position = std::find_if(m_vertexLayout.elements.begin(), m_vertexLayout.elements.end(),
+                                 [](const VertexElement &element) { return element.index == 0; });
+    if (position == m_vertexLayout.elements.end() || position->type != GL_FLOAT || position->size < 2 ||
+        m_vertexLayout.stride == 0)
+    {
+        return;
+    }
+
+    const size_t components = std::min<size_t>(position->size, 3);
+    if (position->offset + components * sizeof(float) > m_vertexLayout.stride)
+    {
+        return;
+    }
+
+    const auto *bytes = reinterpret_cast<const uint8_t *>(vertices.data());
+    auto readPosition = [&](size_t vertex) {
+        glm::vec3 point(0.0f);
+        std::memcpy(&point.x, bytes + vertex * m_vertexLayout.stride + position->offset, components * sizeof(float));
+        return point;
+    };
+
+    for (size_t vertex = 0; vertex < m_vertexCount; ++vertex)
+    {
+        m_boundingBox.Expand(readPosition(vertex));
+    }
+    if (!m_boundingBox.IsValid())
+    {
+        return;
+    }
+
+    // Centered on the box rather than a minimal sphere: one pass, and never worse than the box's own sphere
+    m_boundingSphere.center = m_boundingBox.GetCenter();
+    float radiusSquared = 0.0f;
+    for (size_t vertex = 0; vertex < m_vertexCount; ++vertex)
+    {
+        const glm::vec3 offset = readPosition(vertex) - m_boundingSphere.center;
+        radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
     }
+    m_boundingSphere.radius = std::sqrt(radiusSquared);
 }
 } // namespace eng
\ No newline at end of file
@@ -1,4 +1,5 @@
 #pragma once
+#include "core/Bounds.h"
 #include "graphics/VertexLayout.h"
 #include <GL/glew.h>
 #include <vector>
@@ -8,6 +9,11 @@ namespace eng
 /**
  * @class Mesh
  * @brief Represents a 3D geometry consisting of vertices and optional indices.
+ *
+ * Buffers are created in the constructor and can be shared between GL contexts. The vertex array
+ * object is not shareable, so it is created on first Bind() in the context that renders the mesh.
+ * The constructor also computes local bounds from the position attribute, which is the float element at
+ * attribute location 0; a layout without one gives empty bounds, and such a mesh is never culled.
  */
 class Mesh
 {
@@ -31,7 +37,7 @@ class Mesh
     Mesh &operator=(const Mesh &) = delete;
 
     /**
-     * @brief Binds the mesh's VAO for rendering.
+     * @brief Binds the mesh's VAO for rendering, creating it on first use.
      */
     void Bind() const;
 
@@ -40,13 +46,46 @@ class Mesh
      */
     void Draw() const;
 
+    /**
+     * @brief Gets the local space box around the vertices.
+     * @return The box, empty if the layout has no position attribute.
+     */
+    [[nodiscard]] const BoundingBox &GetBoundingBox() const;
+
+    /**
+     * @brief Gets the local space sphere around the vertices, centered on the bounding box.
+     * @return The sphere, empty if the layout has no position attribute.
+     */
+    [[nodiscard]] const BoundingSphere &GetBoundingSphere() const;
+
+    /**
+     * @brief Gets the number of triangles Draw() submits.
+     * @return The index count over three, or the vertex count over three without indices.
+     */
+    [[nodiscard]] size_t GetTriangleCount() const;
+
+  private:
+    /**
+     * @brief Creates the VAO and records the vertex layout in the current context.
+     */
+    void CreateVertexArray() const;
+
+    /**
+     * @brief Computes the bounding box and sphere from the position attribute of the vertices.
+     * @param vertices The vertex data.
+     */
+    void ComputeBounds(const std::vector<float> &vertices);
+
   private:
     VertexLayout m_vertexLayout; ///< The layout information for the vertices.
     GLuint m_VBO = 0;            ///< Vertex Buffer Object ID.
     GLuint m_EBO = 0;            ///< Element Buffer Object ID.
-    GLuint m_VAO = 0;            ///< Vertex Array Object ID.
+    mutable GLuint m_VAO = 0;    ///< Vertex Array Object ID, created lazily by Bind().
 
     size_t m_vertexCount = 0; ///< Number of vertices in the mesh.
     size_t m_indexCount = 0;  ///< Number of indices in the mesh.
+
+    BoundingBox m_boundingBox;       ///< Local bounds of the vertices.
+    BoundingSphere m_boundingSphere; ///< Local bounds of the vertices.
 };
 } // namespace eng
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "render/MeshLodChain.h"
+#include <glm/glm.hpp>
+#include <iostream>
+#include <limits>
+#include <utility>
+
+namespace eng
+{
+MeshLodChain::MeshLodChain(std::vector<MeshLod> levels, float hysteresis)
+    : m_levels(std::move(levels)), m_hysteresis(hysteresis)
+{
+    if (m_levels.empty())
+    {
+        std::cerr << "MeshLodChain: no levels, the object is never drawn" << std::endl;
+        m_currentLevel = CULLED;
+    }
+
+    for (size_t i = 1; i < m_levels.size(); ++i)
+    {
+        if (m_levels[i].minScreenCoverage > m_levels[i - 1].minScreenCoverage)
+        {
+            std::cerr << "MeshLodChain: level " << i << " has a larger minimum screen coverage than level " << i - 1
+                      << ", so it is never drawn" << std::endl;
+        }
+    }
+}
+
+uint32_t MeshLodChain::SelectLevel(float screenCoverage)
+{
+    // CULLED counts as the level after the last one, so leaving it works like switching to a finer level
+    const auto levelCount = static_cast<uint32_t>(m_levels.size());
+    uint32_t level = m_currentLevel == CULLED ? levelCount : m_currentLevel;
+
+    while (level > 0 && screenCoverage >= m_levels[level - 1].minScreenCoverage * (1.0f + m_hysteresis))
+    {
+        --level;
+    }
+    while (level < levelCount && screenCoverage < m_levels[level].minScreenCoverage * (1.0f - m_hysteresis))
+    {
+        ++level;
+    }
+
+    m_currentLevel = level == levelCount ? CULLED : level;
+    return m_currentLevel;
+}
+
+uint32_t MeshLodChain::GetCurrentLevel() const
+{
+    return m_currentLevel;
+}
+
+size_t MeshLodChain::GetLevelCount() const
+{
+    return m_levels.size();
+}
+
+const MeshLod &MeshLodChain::GetLevel(uint32_t index) const
+{
+    return m_levels[index];
+}
+
+float MeshLodChain::GetHysteresis() const
+{
+    return m_hysteresis;
+}
+
+float MeshLodChain::ComputeScreenCoverage(const BoundingSphere &worldSphere, const glm::mat4 &viewProjection,
+                                          float projectionScaleY)
+{
+    // Clip space w is the view depth for a perspective projection and 1 for an orthographic one, so
+    // radius * scale / w is the projected radius in normalized device units, half the screen height
+    const float w = viewProjection[0][3] * worldSphere.center.x + viewProjection[1][3] * worldSphere.center.y +
+                    viewProjection[2][3] * worldSphere.center.z + viewProjection[3][3];
+    if (!worldSphere.IsValid() || w <= 0.0f)
+    {
+        return std::numeric_limits<float>::max();
+    }
+    return worldSphere.radius * projectionScaleY / w;
+}
+} // namespace eng
\ No newline at end of file
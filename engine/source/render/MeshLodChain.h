@@ -0,0 +1,97 @@
+#pragma once
+#include "core/Bounds.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace eng
+{
+class Mesh;
+
+/**
+ * @struct MeshLod
+ * @brief One level of detail of a mesh.
+ */
+struct MeshLod
+{
+    std::shared_ptr<Mesh> mesh;     ///< The mesh drawn at this level.
+    float minScreenCoverage = 0.0f; ///< Smallest screen coverage the level is drawn at.
+};
+
+/**
+ * @class MeshLodChain
+ * @brief Levels of detail of one object, ordered from the most detailed, and the level it currently shows.
+ *
+ * Screen coverage is the projected diameter of the object's bounding sphere divided by the screen height. Each
+ * level is drawn while the coverage is at least its minimum and below the minimum of the level before it; the
+ * minimums must therefore decrease along the chain. If the last level has a minimum above zero, objects that
+ * cover less than that are not drawn at all (contribution culling).
+ *
+ * Switching is delayed by a hysteresis band around each threshold, so an object sitting right at a threshold
+ * does not alternate between two levels every frame. The current level is state of the chain: every object
+ * needs its own chain, although the chains may share their meshes.
+ */
+class MeshLodChain
+{
+  public:
+    static constexpr float DEFAULT_HYSTERESIS = 0.1f;
+    static constexpr uint32_t CULLED = UINT32_MAX;
+
+    /**
+     * @brief Constructor.
+     * @param levels The levels, most detailed first.
+     * @param hysteresis Relative width of the band around each threshold: a level switches to a coarser one
+     * below (1 - hysteresis) times its minimum and back above (1 + hysteresis) times it.
+     */
+    explicit MeshLodChain(std::vector<MeshLod> levels, float hysteresis = DEFAULT_HYSTERESIS);
+
+    /**
+     * @brief Picks the level for a screen coverage and makes it the current level.
+     * @param screenCoverage The coverage, see ComputeScreenCoverage().
+     * @return The index of the level, or CULLED if the object is too small to draw.
+     */
+    uint32_t SelectLevel(float screenCoverage);
+
+    /**
+     * @brief Gets the level picked by the last SelectLevel().
+     * @return The index of the level, or CULLED. 0 before the first selection.
+     */
+    [[nodiscard]] uint32_t GetCurrentLevel() const;
+
+    /**
+     * @brief Gets the number of levels.
+     * @return The level count.
+     */
+    [[nodiscard]] size_t GetLevelCount() const;
+
+    /**
+     * @brief Gets a level.
+     * @param index The index of the level, less than GetLevelCount().
+     * @return The level.
+     */
+    [[nodiscard]] const MeshLod &GetLevel(uint32_t index) const;
+
+    /**
+     * @brief Gets the hysteresis band.
+     * @return The relative width of the band.
+     */
+    [[nodiscard]] float GetHysteresis() const;
+
+    /**
+     * @brief Computes the screen coverage of a sphere.
+     * @param worldSphere The sphere in world space.
+     * @param viewProjection The camera's projection times view matrix.
+     * @param projectionScaleY Element [1][1] of the projection matrix, the vertical scale of clip space.
+     * @return The projected diameter over the screen height; a very large value for a sphere centered at or
+     * behind the camera, or without bounds.
+     */
+    [[nodiscard]] static float ComputeScreenCoverage(const BoundingSphere &worldSphere, const glm::mat4 &viewProjection,
+                                                     float projectionScaleY);
+
+  private:
+    std::vector<MeshLod> m_levels;           ///< Levels, most detailed first.
+    float m_hysteresis = DEFAULT_HYSTERESIS; ///< Relative width of the band around each threshold.
+    uint32_t m_currentLevel = 0;             ///< Level picked by the last SelectLevel(), or CULLED.
+};
+} // namespace eng
\ No newline at end of file
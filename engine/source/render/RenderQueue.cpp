@@ -1,32 +1,246 @@
 #include "render/RenderQueue.h"
 #include "graphics/GraphicsAPI.h"
 #include "graphics/ShaderProgram.h"
+#include "profiling/Profiler.h"
 #include "render/Material.h"
 #include "render/Mesh.h"
+#include "render/MeshLodChain.h"
+#include <algorithm>
+#include <numeric>
 
 namespace eng
 {
+namespace
+{
+// Interned once, so drawing looks the uniforms up by ID instead of hashing their names per command
+const StringId MODEL_UNIFORM("uModel");
+const StringId VIEW_UNIFORM("uView");
+const StringId PROJECTION_UNIFORM("uProjection");
+} // namespace
+
 void RenderQueue::Submit(const RenderCommand &command)
 {
-    m_commands.push_back(command);
+    std::lock_guard<std::mutex> lock(m_submitMutex);
+    auto &frame = m_frames[m_submitIndex];
+    frame.commands.push_back(command);
+    frame.culled = false;
+    frame.built = false;
+}
+
+void RenderQueue::Submit(const RenderCommand *commands, size_t count)
+{
+    std::lock_guard<std::mutex> lock(m_submitMutex);
+    auto &frame = m_frames[m_submitIndex];
+    frame.commands.insert(frame.commands.end(), commands, commands + count);
+    frame.culled = false;
+    frame.built = false;
 }
 
-void RenderQueue::Draw(GraphicsAPI &graphicsAPI, const CameraData &cameraData)
+void RenderQueue::SetCameraData(const CameraData &cameraData)
 {
-    for (auto &command : m_commands)
+    auto &frame = m_frames[m_submitIndex];
+    frame.cameraData = cameraData;
+    frame.culled = false;
+    frame.built = false;
+}
+
+void RenderQueue::Cull()
+{
+    Cull(m_frames[m_submitIndex]);
+}
+
+void RenderQueue::BuildCommands()
+{
+    auto &frame = m_frames[m_submitIndex];
+    if (frame.built)
+    {
+        return;
+    }
+    if (!frame.culled)
+    {
+        Cull(frame);
+    }
+    SelectLods(frame);
+}
+
+void RenderQueue::Flip()
+{
+    BuildCommands();
+
+    auto &frame = m_frames[m_submitIndex];
+    for (auto &command : frame.commands)
     {
-        if (command.material && command.mesh)
+        if (command.material)
+        {
+            command.material->CommitParams();
+        }
+    }
+
+    m_submitIndex = 1 - m_submitIndex;
+    auto &next = m_frames[m_submitIndex];
+    next.commands.clear();
+    next.visibleCommands.clear();
+    next.visibleMeshes.clear();
+    next.culled = false;
+    next.built = false;
+}
+
+void RenderQueue::Draw(GraphicsAPI &graphicsAPI)
+{
+    ENG_PROFILE_SCOPE("RenderQueue::Draw");
+    GpuPassScope gpuPass(graphicsAPI.GetGpuProfiler(), "RenderQueue::Draw");
+
+    const auto &frame = m_frames[1 - m_submitIndex];
+    ENG_PROFILE_COUNTER("RenderQueue::Commands", frame.commands.size());
+    const auto &cameraData = frame.cameraData;
+
+    auto &stats = graphicsAPI.GetRenderStats();
+    stats.commandsVisible += static_cast<uint32_t>(frame.visibleCommands.size()) + frame.commandsTooSmall;
+    stats.commandsCulled += frame.commandsCulled;
+    stats.commandsTooSmall += frame.commandsTooSmall;
+    stats.trianglesSaved += frame.trianglesSaved;
+
+    for (size_t i = 0; i < frame.visibleCommands.size(); ++i)
+    {
+        const auto &command = frame.commands[frame.visibleCommands[i]];
+        Mesh *mesh = frame.visibleMeshes[i];
+        if (command.material && mesh)
         {
             graphicsAPI.BindMaterial(command.material.get());
             auto shaderProgram = command.material->GetShaderProgram();
-            shaderProgram->SetUniform("uModel", command.modelMatrix);
-            shaderProgram->SetUniform("uView", cameraData.viewMatrix);
-            shaderProgram->SetUniform("uProjection", cameraData.projectionMatrix);
-            graphicsAPI.BindMesh(command.mesh.get());
-            graphicsAPI.DrawMesh(command.mesh.get());
+            shaderProgram->SetUniform(MODEL_UNIFORM, command.modelMatrix);
+            shaderProgram->SetUniform(VIEW_UNIFORM, cameraData.viewMatrix);
+            shaderProgram->SetUniform(PROJECTION_UNIFORM, cameraData.projectionMatrix);
+            graphicsAPI.BindMesh(mesh);
+            graphicsAPI.DrawMesh(mesh);
+        }
+    }
+}
+
+size_t RenderQueue::GetDrawCommandCount() const
+{
+    return m_frames[1 - m_submitIndex].commands.size();
+}
+
+void RenderQueue::SetCullingEnabled(bool enabled)
+{
+    m_cullingEnabled = enabled;
+}
+
+bool RenderQueue::IsCullingEnabled() const
+{
+    return m_cullingEnabled;
+}
+
+void RenderQueue::SetContributionCullingEnabled(bool enabled)
+{
+    m_contributionCullingEnabled = enabled;
+}
+
+bool RenderQueue::IsContributionCullingEnabled() const
+{
+    return m_contributionCullingEnabled;
+}
+
+void RenderQueue::Clear()
+{
+    for (auto &frame : m_frames)
+    {
+        frame.commands.clear();
+        frame.visibleCommands.clear();
+        frame.visibleMeshes.clear();
+        frame.culled = false;
+        frame.built = false;
+    }
+    m_culler.Clear();
+}
+
+void RenderQueue::Cull(RenderFrame &frame)
+{
+    ENG_PROFILE_SCOPE("RenderQueue::Cull");
+
+    frame.culled = true;
+    frame.built = false;
+    if (!m_cullingEnabled)
+    {
+        frame.visibleCommands.resize(frame.commands.size());
+        std::iota(frame.visibleCommands.begin(), frame.visibleCommands.end(), 0u);
+        frame.commandsCulled = 0;
+        return;
+    }
+
+    m_culler.Clear();
+    m_culler.Reserve(frame.commands.size());
+    for (const auto &command : frame.commands)
+    {
+        if (command.mesh)
+        {
+            m_culler.Add(command.modelMatrix, command.mesh->GetBoundingBox(), command.mesh->GetBoundingSphere());
+        }
+        else
+        {
+            m_culler.AddUnbounded();
         }
     }
 
-    m_commands.clear();
+    const auto &cameraData = frame.cameraData;
+    m_culler.Cull(Frustum::FromMatrix(cameraData.projectionMatrix * cameraData.viewMatrix), frame.visibleCommands);
+    frame.commandsCulled = static_cast<uint32_t>(frame.commands.size() - frame.visibleCommands.size());
+    ENG_PROFILE_COUNTER("RenderQueue::VisibleCommands", frame.visibleCommands.size());
+}
+
+void RenderQueue::SelectLods(RenderFrame &frame)
+{
+    ENG_PROFILE_SCOPE("RenderQueue::SelectLods");
+
+    const auto &cameraData = frame.cameraData;
+    const glm::mat4 viewProjection = cameraData.projectionMatrix * cameraData.viewMatrix;
+    const float projectionScaleY = cameraData.projectionMatrix[1][1];
+
+    // Compacts the visible list in place, dropping the commands too small to draw
+    size_t visibleCount = 0;
+    uint32_t tooSmallCount = 0;
+    uint64_t trianglesSaved = 0;
+    frame.visibleMeshes.resize(frame.visibleCommands.size());
+    for (uint32_t index : frame.visibleCommands)
+    {
+        const auto &command = frame.commands[index];
+        Mesh *mesh = command.mesh.get();
+        if (command.lods && mesh)
+        {
+            const size_t fullTriangles = mesh->GetTriangleCount();
+            const BoundingSphere sphere = mesh->GetBoundingSphere().Transform(command.modelMatrix);
+            uint32_t level = command.lods->SelectLevel(
+                MeshLodChain::ComputeScreenCoverage(sphere, viewProjection, projectionScaleY));
+            if (level == MeshLodChain::CULLED)
+            {
+                if (m_contributionCullingEnabled || command.lods->GetLevelCount() == 0)
+                {
+                    ++tooSmallCount;
+                    trianglesSaved += fullTriangles;
+                    continue;
+                }
+                // Without contribution culling the coarsest level stands in for an object too small to draw
+                level = static_cast<uint32_t>(command.lods->GetLevelCount() - 1);
+            }
+
+            Mesh *lodMesh = command.lods->GetLevel(level).mesh.get();
+            if (lodMesh && lodMesh != mesh)
+            {
+                trianglesSaved += fullTriangles - std::min(fullTriangles, lodMesh->GetTriangleCount());
+                mesh = lodMesh;
+            }
+        }
+
+        frame.visibleCommands[visibleCount] = index;
+        frame.visibleMeshes[visibleCount] = mesh;
+        ++visibleCount;
+    }
+    frame.visibleCommands.resize(visibleCount);
+    frame.visibleMeshes.resize(visibleCount);
+    frame.commandsTooSmall = tooSmallCount;
+    frame.trianglesSaved = trianglesSaved;
+    frame.built = true;
+    ENG_PROFILE_COUNTER("RenderQueue::CommandsTooSmall", tooSmallCount);
 }
 } // namespace eng
\ No newline at end of file
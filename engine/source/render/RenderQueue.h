@@ -1,11 +1,15 @@
 #pragma once
+#include "render/FrustumCuller.h"
 #include <glm/mat4x4.hpp>
+#include <cstddef>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 namespace eng
 {
 class Mesh;
+class MeshLodChain;
 class Material;
 class GraphicsAPI;
 
@@ -15,9 +19,10 @@ class GraphicsAPI;
  */
 struct RenderCommand
 {
-    std::shared_ptr<Mesh> mesh;         ///< Pointer to the mesh to draw.
+    std::shared_ptr<Mesh> mesh;         ///< Pointer to the mesh to draw, the most detailed level if lods is set.
     std::shared_ptr<Material> material; ///< Pointer to the material to use.
     glm::mat4 modelMatrix;              ///< The transformation matrix of the object.
+    std::shared_ptr<MeshLodChain> lods; ///< Optional levels of detail; Draw() picks the mesh from them.
 };
 
 /**
@@ -30,27 +35,152 @@ struct CameraData
     glm::mat4 projectionMatrix; ///< The projection matrix (field of view, aspect ratio, etc.).
 };
 
+/**
+ * @struct RenderFrame
+ * @brief Everything the renderer needs to draw one frame, snapshotted at submission time, and the draw list
+ * built from it.
+ */
+struct RenderFrame
+{
+    std::vector<RenderCommand> commands;   ///< Commands submitted during the frame.
+    CameraData cameraData;                 ///< Camera the frame is drawn with.
+    std::vector<uint32_t> visibleCommands; ///< Indices of the commands that pass culling, then of those drawn.
+    std::vector<Mesh *> visibleMeshes;     ///< Mesh to draw for each command of the built list.
+    uint32_t commandsCulled = 0;           ///< Commands skipped by frustum culling.
+    uint32_t commandsTooSmall = 0;         ///< Visible commands dropped by their MeshLodChain.
+    uint64_t trianglesSaved = 0;           ///< Triangles saved by levels of detail and contribution culling.
+    bool culled = false;                   ///< Whether RenderQueue::Cull() ran on the frame.
+    bool built = false;                    ///< Whether RenderQueue::BuildCommands() ran on the frame.
+};
+
 /**
  * @class RenderQueue
  * @brief Collects render commands and executes them in order.
+ *
+ * The queue is double-buffered: the simulation fills the submit frame while the renderer draws the
+ * previous one. Flip() hands the submit frame over to the renderer and must only be called while no
+ * Draw() is in progress. Snapshot rules for data shared between the two sides:
+ * - CameraData and the model matrix are copied by value into the frame.
+ * - Meshes and materials are kept alive by the frame's shared pointers. Mesh data is immutable.
+ * - The current level of a MeshLodChain is only read and written by BuildCommands(), on the simulation side.
+ * - Material parameters set during the frame are committed to the render side in Flip(), so the last
+ *   value set before the flip is the one drawn (the same result as drawing on the simulation thread).
+ *
+ * Submit() is thread-safe, so systems running in parallel can submit directly; commands submitted from
+ * different threads at the same time end up in an unspecified order.
+ *
+ * The draw list is built on the simulation side, so it overlaps the drawing of the previous frame. Cull() drops
+ * the commands whose mesh bounds lie entirely outside the frame camera's frustum; commands with meshes without
+ * bounds are always kept. BuildCommands() then picks, once per frame for every visible command with a
+ * MeshLodChain, the level of detail from the screen coverage of the mesh's bounding sphere and drops the
+ * commands whose chain culls them as too small. Flip() runs whichever of the two a frame has not been through,
+ * and Draw() only executes the list.
  */
 class RenderQueue
 {
   public:
     /**
-     * @brief Submits a render command to the queue.
+     * @brief Submits a render command to the current submit frame.
      * @param command The render command to submit.
      */
     void Submit(const RenderCommand &command);
 
     /**
-     * @brief Executes all submitted render commands.
-     * @param graphicsAPI Reference to the graphics API for binding and drawing.
-     * @param cameraData Data about the camera to use for rendering.
+     * @brief Submits a run of render commands to the current submit frame, taking the lock once.
+     * @param commands The first command.
+     * @param count Number of commands.
+     */
+    void Submit(const RenderCommand *commands, size_t count);
+
+    /**
+     * @brief Sets the camera used to draw the current submit frame.
+     * @param cameraData The camera matrices, copied into the frame.
+     */
+    void SetCameraData(const CameraData &cameraData);
+
+    /**
+     * @brief Culls the commands of the submit frame against the frustum of its camera.
+     *
+     * Call after the last Submit() and SetCameraData() of the frame. A later Submit() or SetCameraData()
+     * discards the result, and Flip() culls the frame again.
+     */
+    void Cull();
+
+    /**
+     * @brief Selects the level of detail of every visible command of the submit frame and drops the commands
+     * too small to draw, which fixes the list Draw() executes. Culls the frame first if Cull() was not called;
+     * does nothing if the list is already built.
+     */
+    void BuildCommands();
+
+    /**
+     * @brief Builds the draw list of the submit frame if needed, hands the frame to the renderer and starts a
+     * new, empty submit frame.
+     */
+    void Flip();
+
+    /**
+     * @brief Executes the draw list of the frame handed over by the last Flip().
+     * @param graphicsAPI Reference to the graphics API for binding and drawing; culled and visible command
+     * counts and the triangles saved by levels of detail are added to its RenderStats.
+     */
+    void Draw(GraphicsAPI &graphicsAPI);
+
+    /**
+     * @brief Gets the number of commands in the frame handed over by the last Flip().
+     * @return Number of commands drawn (or about to be drawn) by Draw().
+     */
+    [[nodiscard]] size_t GetDrawCommandCount() const;
+
+    /**
+     * @brief Enables or disables frustum culling. Must not be called while Cull() is in progress.
+     * @param enabled false keeps every command, including those outside the frustum.
+     */
+    void SetCullingEnabled(bool enabled);
+
+    /**
+     * @brief Checks if frustum culling is enabled.
+     * @return true if Cull() culls commands.
+     */
+    [[nodiscard]] bool IsCullingEnabled() const;
+
+    /**
+     * @brief Enables or disables contribution culling. Must not be called while BuildCommands() is in progress.
+     * @param enabled false draws commands whose MeshLodChain culls them as too small with the chain's coarsest
+     * level instead; levels of detail are still selected.
+     */
+    void SetContributionCullingEnabled(bool enabled);
+
+    /**
+     * @brief Checks if contribution culling is enabled.
+     * @return true if BuildCommands() drops commands too small to draw.
+     */
+    [[nodiscard]] bool IsContributionCullingEnabled() const;
+
+    /**
+     * @brief Drops both frames and the resources they keep alive.
+     */
+    void Clear();
+
+  private:
+    /**
+     * @brief Collects the indices of the commands of a frame that pass the frustum test.
+     * @param frame The frame; receives the visible commands and the culled count.
+     */
+    void Cull(RenderFrame &frame);
+
+    /**
+     * @brief Picks the mesh of every visible command and removes the commands too small to draw.
+     * @param frame The frame; receives the draw list, the number of commands removed and the triangles saved.
      */
-    void Draw(GraphicsAPI &graphicsAPI, const CameraData &cameraData);
+    void SelectLods(RenderFrame &frame);
 
   private:
-    std::vector<RenderCommand> m_commands; ///< List of submitted render commands.
+    RenderFrame m_frames[2];                  ///< Submit and draw frames.
+    size_t m_submitIndex = 0;                 ///< Index of the frame currently being filled by Submit().
+    std::mutex m_submitMutex;                 ///< Serializes Submit() calls from parallel systems.
+    bool m_cullingEnabled = true;             ///< Whether Cull() culls commands.
+    bool m_contributionCullingEnabled = true; ///< Whether BuildCommands() drops commands too small to draw.
+    FrustumCuller m_culler;                   ///< World bounds of the submit frame's commands.
 };
 } // namespace eng
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include "render/RenderThread.h"
+#include <GLFW/glfw3.h>
+#include <utility>
+
+namespace eng
+{
+RenderThread::~RenderThread()
+{
+    Stop();
+}
+
+void RenderThread::Start(GLFWwindow *window, RenderFunction initFunction, RenderFunction frameFunction)
+{
+    if (m_thread.joinable())
+    {
+        return;
+    }
+
+    m_window = window;
+    m_initFunction = std::move(initFunction);
+    m_frameFunction = std::move(frameFunction);
+    m_frameInFlight = false;
+    m_stopRequested = false;
+    m_thread = std::thread(&RenderThread::ThreadMain, this);
+}
+
+void RenderThread::Stop()
+{
+    if (!m_thread.joinable())
+    {
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this]() { return !m_frameInFlight; });
+        m_stopRequested = true;
+    }
+    m_condition.notify_all();
+    m_thread.join();
+}
+
+void RenderThread::Kick()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_frameInFlight = true;
+    }
+    m_condition.notify_all();
+}
+
+void RenderThread::Wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [this]() { return !m_frameInFlight; });
+}
+
+bool RenderThread::IsRunning() const
+{
+    return m_thread.joinable();
+}
+
+void RenderThread::ThreadMain()
+{
+    glfwMakeContextCurrent(m_window);
+
+    if (m_initFunction)
+    {
+        m_initFunction();
+    }
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_frameInFlight || m_stopRequested; });
+            if (m_stopRequested)
+            {
+                break;
+            }
+        }
+
+        m_frameFunction();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_frameInFlight = false;
+        }
+        m_condition.notify_all();
+    }
+
+    glfwMakeContextCurrent(nullptr);
+}
+} // namespace eng
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+struct GLFWwindow;
+namespace eng
+{
+/**
+ * @class RenderThread
+ * @brief Dedicated thread that owns a window's GL context and draws one frame per Kick().
+ *
+ * The owner alternates Wait() and Kick(). Between the two calls the render thread is guaranteed to
+ * be idle, which is the only time data read by the render function may be written.
+ */
+class RenderThread
+{
+  public:
+    using RenderFunction = std::function<void()>;
+
+    RenderThread() = default;
+    RenderThread(const RenderThread &) = delete;
+    RenderThread &operator=(const RenderThread &) = delete;
+
+    /**
+     * @brief Destructor. Stops the thread if it is still running.
+     */
+    ~RenderThread();
+
+    /**
+     * @brief Starts the thread and makes the window's context current on it.
+     * @param window The window whose context the thread takes over. It must not be current elsewhere.
+     * @param initFunction Called once on the render thread after the context is made current.
+     * @param frameFunction Called on the render thread for every kicked frame.
+     */
+    void Start(GLFWwindow *window, RenderFunction initFunction, RenderFunction frameFunction);
+
+    /**
+     * @brief Waits for the frame in flight, then joins the thread and releases the context.
+     */
+    void Stop();
+
+    /**
+     * @brief Starts rendering a frame. Must be preceded by Wait() if a frame was kicked before.
+     */
+    void Kick();
+
+    /**
+     * @brief Blocks until the frame in flight (if any) has been rendered.
+     */
+    void Wait();
+
+    /**
+     * @brief Checks if the thread has been started and not stopped.
+     * @return true if running, false otherwise.
+     */
+    [[nodiscard]] bool IsRunning() const;
+
+  private:
+    /**
+     * @brief Entry point of the render thread.
+     */
+    void ThreadMain();
+
+  private:
+    std::thread m_thread;                ///< The render thread.
+    std::mutex m_mutex;                  ///< Guards the state flags below.
+    std::condition_variable m_condition; ///< Signals kicks, finished frames and stop requests.
+    GLFWwindow *m_window = nullptr;      ///< Window whose context is current on the render thread.
+    RenderFunction m_initFunction;       ///< Called once on startup.
+    RenderFunction m_frameFunction;      ///< Called once per kicked frame.
+    bool m_frameInFlight = false;        ///< Whether a kicked frame has not finished yet.
+    bool m_stopRequested = false;        ///< Whether the thread should exit.
+};
+} // namespace eng
\ No newline at end of file
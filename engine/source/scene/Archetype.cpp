@@ -0,0 +1,177 @@
+#include "scene/Archetype.h"
+#include <algorithm>
+
+namespace eng
+{
+namespace
+{
+constexpr size_t CHUNK_ALIGNMENT = 64;
+
+size_t AlignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+} // namespace
+
+Archetype::Archetype(std::vector<ComponentTypeInfo> types) : m_types(std::move(types))
+{
+    size_t rowBytes = sizeof(GameObject *);
+    for (const auto &type : m_types)
+    {
+        rowBytes += type.size;
+    }
+
+    // Start from the unpadded estimate and shrink until the columns and their alignment padding fit
+    auto capacity = static_cast<uint32_t>(std::max<size_t>(1, CHUNK_SIZE / rowBytes));
+    m_columnOffsets.resize(m_types.size());
+    while (true)
+    {
+        size_t offset = sizeof(GameObject *) * capacity;
+        for (size_t i = 0; i < m_types.size(); ++i)
+        {
+            offset = AlignUp(offset, m_types[i].alignment);
+            m_columnOffsets[i] = offset;
+            offset += m_types[i].size * capacity;
+        }
+
+        if (offset <= CHUNK_SIZE || capacity == 1)
+        {
+            m_chunkBytes = AlignUp(std::max(offset, CHUNK_SIZE), CHUNK_ALIGNMENT);
+            break;
+        }
+        --capacity;
+    }
+    m_chunkCapacity = capacity;
+
+    // Type IDs are dense, so a table indexed by ID stays small
+    m_columnByType.assign(m_types.empty() ? 0 : m_types.back().typeId + 1, -1);
+    for (size_t i = 0; i < m_types.size(); ++i)
+    {
+        m_columnByType[m_types[i].typeId] = static_cast<int>(i);
+        if (m_types[i].typeId < MAX_MASKED_COMPONENT_TYPES)
+        {
+            m_mask.set(m_types[i].typeId);
+        }
+    }
+}
+
+Archetype::~Archetype()
+{
+    for (uint32_t row = 0; row < m_rowCount; ++row)
+    {
+        for (size_t column = 0; column < m_types.size(); ++column)
+        {
+            m_types[column].destroy(GetData(column, row));
+        }
+    }
+
+    for (auto &chunk : m_chunks)
+    {
+        ::operator delete(chunk.data, std::align_val_t(CHUNK_ALIGNMENT));
+    }
+    ::operator delete(m_spareChunk, std::align_val_t(CHUNK_ALIGNMENT));
+}
+
+uint32_t Archetype::AddRow(GameObject *owner)
+{
+    if (m_chunks.empty() || m_chunks.back().count == m_chunkCapacity)
+    {
+        Chunk chunk;
+        if (m_spareChunk)
+        {
+            chunk.data = m_spareChunk;
+            m_spareChunk = nullptr;
+        }
+        else
+        {
+            chunk.data = static_cast<std::byte *>(::operator new(m_chunkBytes, std::align_val_t(CHUNK_ALIGNMENT)));
+        }
+        m_chunks.push_back(chunk);
+    }
+
+    Chunk &chunk = m_chunks.back();
+    reinterpret_cast<GameObject **>(chunk.data)[chunk.count] = owner;
+    ++chunk.count;
+
+    return m_rowCount++;
+}
+
+GameObject *Archetype::RemoveRow(uint32_t row, bool destroyComponents)
+{
+    if (destroyComponents)
+    {
+        for (size_t column = 0; column < m_types.size(); ++column)
+        {
+            m_types[column].destroy(GetData(column, row));
+        }
+    }
+
+    const uint32_t last = m_rowCount - 1;
+    GameObject *moved = nullptr;
+    if (row != last)
+    {
+        for (size_t column = 0; column < m_types.size(); ++column)
+        {
+            m_types[column].moveAndDestroy(GetData(column, row), GetData(column, last));
+        }
+
+        moved = reinterpret_cast<GameObject **>(m_chunks[last / m_chunkCapacity].data)[last % m_chunkCapacity];
+        reinterpret_cast<GameObject **>(m_chunks[row / m_chunkCapacity].data)[row % m_chunkCapacity] = moved;
+    }
+
+    --m_rowCount;
+    if (--m_chunks.back().count == 0)
+    {
+        // Keep one empty chunk, so objects spawned and destroyed around a chunk boundary do not allocate
+        if (m_spareChunk)
+        {
+            ::operator delete(m_spareChunk, std::align_val_t(CHUNK_ALIGNMENT));
+        }
+        m_spareChunk = m_chunks.back().data;
+        m_chunks.pop_back();
+    }
+
+    return moved;
+}
+
+const ComponentMask &Archetype::GetMask() const
+{
+    return m_mask;
+}
+
+size_t Archetype::GetChunkCount() const
+{
+    return m_chunks.size();
+}
+
+uint32_t Archetype::GetChunkCapacity() const
+{
+    return m_chunkCapacity;
+}
+
+uint32_t Archetype::GetRowCount() const
+{
+    return m_rowCount;
+}
+
+size_t Archetype::GetColumnCount() const
+{
+    return m_types.size();
+}
+
+const ComponentTypeInfo &Archetype::GetType(size_t column) const
+{
+    return m_types[column];
+}
+
+Archetype *Archetype::GetAddEdge(size_t typeId) const
+{
+    auto it = m_addEdges.find(typeId);
+    return it != m_addEdges.end() ? it->second : nullptr;
+}
+
+void Archetype::SetAddEdge(size_t typeId, Archetype *archetype)
+{
+    m_addEdges[typeId] = archetype;
+}
+} // namespace eng
\ No newline at end of file
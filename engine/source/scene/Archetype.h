@@ -0,0 +1,289 @@
+#pragma once
+#include "scene/Component.h"
+#include "scene/SystemAccess.h"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace eng
+{
+class GameObject;
+
+/**
+ * @brief Runs one of the update functions over a contiguous run of components of the same type.
+ */
+using ComponentBatchFunction = void (*)(void *components, uint32_t count, float deltaTime);
+
+/**
+ * @brief Detects a static void T::UpdateBatch(T *components, uint32_t count, float deltaTime) declared by T itself.
+ */
+template <typename T, typename = void> struct HasUpdateBatch : std::false_type
+{
+};
+
+template <typename T>
+struct HasUpdateBatch<T, std::enable_if_t<std::is_same_v<decltype(&T::UpdateBatch), void (*)(T *, uint32_t, float)>>>
+    : std::true_type
+{
+};
+
+/**
+ * @struct ComponentTypeInfo
+ * @brief Type-erased description of a component class, enough to store it in raw chunk memory.
+ */
+struct ComponentTypeInfo
+{
+    size_t typeId = 0;                                ///< Component::StaticTypeId of the type.
+    size_t size = 0;                                  ///< sizeof the type.
+    size_t alignment = 0;                             ///< alignof the type.
+    void (*moveAndDestroy)(void *, void *) = nullptr; ///< Move-constructs into the first pointer, destroys the second.
+    void (*destroy)(void *) = nullptr;                ///< Calls the destructor.
+    Component *(*toComponent)(void *) = nullptr;      ///< Converts a pointer to the stored type to its base.
+    ComponentBatchFunction update = nullptr;          ///< Batched Update, nullptr if the type does not need it.
+    ComponentBatchFunction fixedUpdate = nullptr;     ///< Batched FixedUpdate, nullptr if not overridden.
+    ComponentBatchFunction lateUpdate = nullptr;      ///< Batched LateUpdate, nullptr if not overridden.
+    const SystemAccess *access = nullptr;             ///< What the batch functions read and write.
+
+    /**
+     * @brief Builds the description of a component class.
+     *
+     * The batch functions call the overrides of T without virtual dispatch, or T::UpdateBatch if T declares
+     * one. Functions T does not override are left null so their systems never run.
+     * @tparam T The component class type.
+     * @return The type description.
+     */
+    template <typename T> static ComponentTypeInfo Create()
+    {
+        ComponentTypeInfo info;
+        info.typeId = Component::StaticTypeId<T>();
+        info.size = sizeof(T);
+        info.alignment = alignof(T);
+        info.moveAndDestroy = [](void *destination, void *source) {
+            T *from = static_cast<T *>(source);
+            new (destination) T(std::move(*from));
+            from->~T();
+        };
+        info.destroy = [](void *component) { static_cast<T *>(component)->~T(); };
+        info.toComponent = [](void *component) -> Component * { return static_cast<T *>(component); };
+        info.access = &SystemAccess::Of<T>();
+
+        if constexpr (HasUpdateBatch<T>::value)
+        {
+            info.update = [](void *components, uint32_t count, float deltaTime) {
+                T::UpdateBatch(static_cast<T *>(components), count, deltaTime);
+            };
+        }
+        else if constexpr (!std::is_same_v<decltype(&T::Update), void (Component::*)(float)>)
+        {
+            info.update = [](void *components, uint32_t count, float deltaTime) {
+                T *first = static_cast<T *>(components);
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    first[i].T::Update(deltaTime);
+                }
+            };
+        }
+
+        if constexpr (!std::is_same_v<decltype(&T::FixedUpdate), void (Component::*)(float)>)
+        {
+            info.fixedUpdate = [](void *components, uint32_t count, float fixedDeltaTime) {
+                T *first = static_cast<T *>(components);
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    first[i].T::FixedUpdate(fixedDeltaTime);
+                }
+            };
+        }
+
+        if constexpr (!std::is_same_v<decltype(&T::LateUpdate), void (Component::*)(float)>)
+        {
+            info.lateUpdate = [](void *components, uint32_t count, float deltaTime) {
+                T *first = static_cast<T *>(components);
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    first[i].T::LateUpdate(deltaTime);
+                }
+            };
+        }
+
+        return info;
+    }
+};
+
+/**
+ * @class Archetype
+ * @brief Stores the components of every object that has exactly the same set of component types.
+ *
+ * Rows are packed into chunks of CHUNK_SIZE bytes. Inside a chunk each component type has its own
+ * contiguous column, preceded by a column of owning objects, so iterating one type touches only its
+ * own memory. Rows are dense: removing a row moves the last row into the hole, and only the last chunk
+ * can be partially filled.
+ */
+class Archetype
+{
+  public:
+    static constexpr size_t CHUNK_SIZE = 16 * 1024;
+
+    /**
+     * @brief Computes the chunk layout for a set of component types.
+     * @param types The component types, sorted by type ID and without duplicates.
+     */
+    explicit Archetype(std::vector<ComponentTypeInfo> types);
+    ~Archetype();
+
+    Archetype(const Archetype &) = delete;
+    Archetype &operator=(const Archetype &) = delete;
+
+    /**
+     * @brief Appends a row. Its component memory is left uninitialized for the caller to construct.
+     * @param owner The object the row belongs to.
+     * @return Index of the new row.
+     */
+    uint32_t AddRow(GameObject *owner);
+
+    /**
+     * @brief Removes a row, moving the last row into its place.
+     * @param row Index of the row.
+     * @param destroyComponents false if the components of the row were already moved out and destroyed.
+     * @return The object whose row was moved into row, or nullptr if row was the last one.
+     */
+    GameObject *RemoveRow(uint32_t row, bool destroyComponents);
+
+    /**
+     * @brief Finds the column of a component type with one table lookup.
+     * @param typeId The component type ID.
+     * @return Index of the column, or -1 if the archetype does not store that type.
+     */
+    [[nodiscard]] int FindColumn(size_t typeId) const
+    {
+        return typeId < m_columnByType.size() ? m_columnByType[typeId] : -1;
+    }
+
+    /**
+     * @brief Gets the bitmask of the stored component types.
+     * @return The mask.
+     */
+    [[nodiscard]] const ComponentMask &GetMask() const;
+
+    /**
+     * @brief Gets the memory of one component.
+     * @param column Index of the column.
+     * @param row Index of the row.
+     * @return Pointer to the component.
+     */
+    [[nodiscard]] void *GetData(size_t column, uint32_t row) const
+    {
+        const Chunk &chunk = m_chunks[row / m_chunkCapacity];
+        return chunk.data + m_columnOffsets[column] + (row % m_chunkCapacity) * m_types[column].size;
+    }
+
+    /**
+     * @brief Gets one component through its base class.
+     * @param column Index of the column.
+     * @param row Index of the row.
+     * @return Pointer to the component.
+     */
+    [[nodiscard]] Component *GetComponent(size_t column, uint32_t row) const
+    {
+        return m_types[column].toComponent(GetData(column, row));
+    }
+
+    /**
+     * @brief Gets the first element of a column inside one chunk.
+     * @param chunk Index of the chunk.
+     * @param column Index of the column.
+     * @return Pointer to the column start.
+     */
+    [[nodiscard]] void *GetColumn(size_t chunk, size_t column) const
+    {
+        return m_chunks[chunk].data + m_columnOffsets[column];
+    }
+
+    /**
+     * @brief Gets the owners of the rows inside one chunk.
+     * @param chunk Index of the chunk.
+     * @return Pointer to the first owner.
+     */
+    [[nodiscard]] GameObject *const *GetOwners(size_t chunk) const
+    {
+        return reinterpret_cast<GameObject *const *>(m_chunks[chunk].data);
+    }
+
+    /**
+     * @brief Gets the number of rows stored in one chunk.
+     * @param chunk Index of the chunk.
+     * @return The row count.
+     */
+    [[nodiscard]] uint32_t GetChunkRowCount(size_t chunk) const
+    {
+        return m_chunks[chunk].count;
+    }
+
+    /**
+     * @brief Gets the number of allocated chunks.
+     * @return The chunk count.
+     */
+    [[nodiscard]] size_t GetChunkCount() const;
+
+    /**
+     * @brief Gets the number of rows that fit in one chunk.
+     * @return The chunk capacity.
+     */
+    [[nodiscard]] uint32_t GetChunkCapacity() const;
+
+    /**
+     * @brief Gets the number of rows over all chunks.
+     * @return The row count.
+     */
+    [[nodiscard]] uint32_t GetRowCount() const;
+
+    /**
+     * @brief Gets the number of component types stored per row.
+     * @return The column count.
+     */
+    [[nodiscard]] size_t GetColumnCount() const;
+
+    /**
+     * @brief Gets the type stored in a column.
+     * @param column Index of the column.
+     * @return The type description.
+     */
+    [[nodiscard]] const ComponentTypeInfo &GetType(size_t column) const;
+
+    /**
+     * @brief Gets the archetype reached by adding a component type, if it was looked up before.
+     * @param typeId The added component type ID.
+     * @return The cached archetype, or nullptr.
+     */
+    [[nodiscard]] Archetype *GetAddEdge(size_t typeId) const;
+
+    /**
+     * @brief Caches the archetype reached by adding a component type.
+     * @param typeId The added component type ID.
+     * @param archetype The destination archetype.
+     */
+    void SetAddEdge(size_t typeId, Archetype *archetype);
+
+  private:
+    struct Chunk
+    {
+        std::byte *data = nullptr; ///< CHUNK_SIZE bytes (more if a single row does not fit).
+        uint32_t count = 0;        ///< Number of rows in use.
+    };
+
+    std::vector<ComponentTypeInfo> m_types;             ///< Stored types, sorted by type ID.
+    std::vector<int> m_columnByType;                    ///< Column per type ID, -1 for absent types.
+    ComponentMask m_mask;                               ///< Stored types with a masked ID.
+    std::vector<size_t> m_columnOffsets;                ///< Byte offset of every column inside a chunk.
+    std::vector<Chunk> m_chunks;                        ///< Chunks, all full except the last one.
+    std::byte *m_spareChunk = nullptr;                  ///< Last emptied chunk, reused by the next AddRow.
+    std::unordered_map<size_t, Archetype *> m_addEdges; ///< Archetype reached by adding a type.
+    size_t m_chunkBytes = CHUNK_SIZE;                   ///< Allocation size of one chunk.
+    uint32_t m_chunkCapacity = 1;                       ///< Rows per chunk.
+    uint32_t m_rowCount = 0;                            ///< Rows in use over all chunks.
+};
+} // namespace eng
\ No newline at end of file
@@ -0,0 +1,423 @@
+#include "scene/BoundingVolumeTree.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <glm/glm.hpp>
+
+namespace eng
+{
+namespace
+{
+/**
+ * @brief Gets the surface area of a box, the insertion cost measure: a random ray or query hits a box with a
+ * probability proportional to it.
+ */
+float SurfaceArea(const BoundingBox &box)
+{
+    const glm::vec3 size = box.max - box.min;
+    return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+/**
+ * @brief Gets the smallest box containing two boxes.
+ */
+BoundingBox Union(const BoundingBox &a, const BoundingBox &b)
+{
+    BoundingBox box;
+    box.min = glm::min(a.min, b.min);
+    box.max = glm::max(a.max, b.max);
+    return box;
+}
+} // namespace
+
+BoundingVolumeTree::BoundingVolumeTree(float margin) : m_margin(margin)
+{
+}
+
+BoundingVolumeTree::ProxyId BoundingVolumeTree::CreateProxy(const BoundingBox &box, void *userData)
+{
+    const uint32_t leaf = AllocateNode();
+    Node &node = m_nodes[leaf];
+    node.box.min = box.min - glm::vec3(m_margin);
+    node.box.max = box.max + glm::vec3(m_margin);
+    node.userData = userData;
+    node.height = 0;
+    m_boxes[leaf] = box;
+
+    InsertLeaf(leaf);
+    ++m_proxyCount;
+    return leaf;
+}
+
+void BoundingVolumeTree::DestroyProxy(ProxyId proxy)
+{
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+    --m_proxyCount;
+}
+
+bool BoundingVolumeTree::MoveProxy(ProxyId proxy, const BoundingBox &box, const glm::vec3 &displacement)
+{
+    m_boxes[proxy] = box;
+
+    // Stretch the fat box along the movement, so a proxy moving steadily is reinserted every few frames
+    // instead of every frame
+    constexpr float DISPLACEMENT_MULTIPLIER = 4.0f;
+    BoundingBox fatBox;
+    fatBox.min = box.min - glm::vec3(m_margin);
+    fatBox.max = box.max + glm::vec3(m_margin);
+    const glm::vec3 stretch = displacement * DISPLACEMENT_MULTIPLIER;
+    fatBox.min += glm::min(stretch, glm::vec3(0.0f));
+    fatBox.max += glm::max(stretch, glm::vec3(0.0f));
+
+    const BoundingBox &treeBox = m_nodes[proxy].box;
+    if (treeBox.Contains(box))
+    {
+        // Still inside, but a box left far larger by a fast move that has since stopped makes every query
+        // around it slower; keep it only while it is within a few margins of the new fat box
+        BoundingBox hugeBox;
+        hugeBox.min = fatBox.min - glm::vec3(4.0f * m_margin);
+        hugeBox.max = fatBox.max + glm::vec3(4.0f * m_margin);
+        if (hugeBox.Contains(treeBox))
+        {
+            return false;
+        }
+    }
+
+    RemoveLeaf(proxy);
+    m_nodes[proxy].box = fatBox;
+    InsertLeaf(proxy);
+    return true;
+}
+
+void *BoundingVolumeTree::GetUserData(ProxyId proxy) const
+{
+    return m_nodes[proxy].userData;
+}
+
+const BoundingBox &BoundingVolumeTree::GetBox(ProxyId proxy) const
+{
+    return m_boxes[proxy];
+}
+
+const BoundingBox &BoundingVolumeTree::GetFatBox(ProxyId proxy) const
+{
+    return m_nodes[proxy].box;
+}
+
+size_t BoundingVolumeTree::GetProxyCount() const
+{
+    return m_proxyCount;
+}
+
+int BoundingVolumeTree::GetHeight() const
+{
+    return m_root == INVALID_PROXY ? 0 : m_nodes[m_root].height;
+}
+
+bool BoundingVolumeTree::Validate() const
+{
+    if (m_root == INVALID_PROXY)
+    {
+        return m_proxyCount == 0;
+    }
+    return m_nodes[m_root].parent == INVALID_PROXY && ValidateNode(m_root);
+}
+
+void BoundingVolumeTree::Clear()
+{
+    m_nodes.clear();
+    m_boxes.clear();
+    m_root = INVALID_PROXY;
+    m_freeList = INVALID_PROXY;
+    m_proxyCount = 0;
+}
+
+void BoundingVolumeTree::QueryNearest(const glm::vec3 &point, size_t count, std::vector<ProxyId> &outProxies,
+                                      float maxDistance) const
+{
+    outProxies.clear();
+    if (count == 0)
+    {
+        return;
+    }
+
+    QueryNearest(
+        point,
+        [&outProxies, count](ProxyId proxy) {
+            outProxies.push_back(proxy);
+            return outProxies.size() < count;
+        },
+        maxDistance);
+}
+
+std::vector<BoundingVolumeTree::NearestEntry> &BoundingVolumeTree::GetNearestScratch()
+{
+    thread_local std::vector<NearestEntry> scratch;
+    return scratch;
+}
+
+uint32_t BoundingVolumeTree::ClassifyAgainstFrustum(const BoundingBox &box, const Frustum &frustum, uint32_t planes)
+{
+    const glm::vec3 center = box.GetCenter();
+    const glm::vec3 extents = box.GetExtents();
+    for (int i = 0; i < Frustum::PLANE_COUNT; ++i)
+    {
+        const uint32_t bit = 1u << i;
+        if ((planes & bit) == 0)
+        {
+            continue;
+        }
+
+        const glm::vec4 &plane = frustum.planes[i];
+        const glm::vec3 normal(plane);
+        const float distance = glm::dot(normal, center) + plane.w;
+        const float radius = glm::dot(glm::abs(normal), extents);
+        if (distance + radius < 0.0f)
+        {
+            return OUTSIDE_FRUSTUM;
+        }
+        if (distance - radius >= 0.0f)
+        {
+            planes &= ~bit;
+        }
+    }
+    return planes;
+}
+
+uint32_t BoundingVolumeTree::AllocateNode()
+{
+    if (m_freeList == INVALID_PROXY)
+    {
+        m_nodes.emplace_back();
+        m_boxes.emplace_back();
+        return static_cast<uint32_t>(m_nodes.size() - 1);
+    }
+
+    const uint32_t index = m_freeList;
+    m_freeList = m_nodes[index].parent;
+    m_nodes[index] = Node();
+    return index;
+}
+
+void BoundingVolumeTree::FreeNode(uint32_t index)
+{
+    m_nodes[index] = Node();
+    m_nodes[index].parent = m_freeList;
+    m_freeList = index;
+}
+
+void BoundingVolumeTree::InsertLeaf(uint32_t leaf)
+{
+    if (m_root == INVALID_PROXY)
+    {
+        m_root = leaf;
+        m_nodes[leaf].parent = INVALID_PROXY;
+        return;
+    }
+
+    // Descend towards the cheapest sibling. Placing the leaf next to a node costs the area of their union, and
+    // every ancestor on the way grows by the area the leaf adds to it
+    const BoundingBox leafBox = m_nodes[leaf].box;
+    uint32_t index = m_root;
+    while (!m_nodes[index].IsLeaf())
+    {
+        const Node &node = m_nodes[index];
+        const float area = SurfaceArea(node.box);
+        const float combinedArea = SurfaceArea(Union(node.box, leafBox));
+
+        const float siblingCost = 2.0f * combinedArea;
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](uint32_t child) {
+            const BoundingBox &childBox = m_nodes[child].box;
+            const float childArea = SurfaceArea(Union(childBox, leafBox));
+            return m_nodes[child].IsLeaf() ? childArea + inheritanceCost
+                                           : childArea - SurfaceArea(childBox) + inheritanceCost;
+        };
+        const float cost1 = descendCost(node.child1);
+        const float cost2 = descendCost(node.child2);
+
+        if (siblingCost < cost1 && siblingCost < cost2)
+        {
+            break;
+        }
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    const uint32_t sibling = index;
+    const uint32_t oldParent = m_nodes[sibling].parent;
+    const uint32_t newParent = AllocateNode();
+
+    Node &parentNode = m_nodes[newParent];
+    parentNode.parent = oldParent;
+    parentNode.box = Union(leafBox, m_nodes[sibling].box);
+    parentNode.height = m_nodes[sibling].height + 1;
+    parentNode.child1 = sibling;
+    parentNode.child2 = leaf;
+    m_nodes[sibling].parent = newParent;
+    m_nodes[leaf].parent = newParent;
+
+    if (oldParent == INVALID_PROXY)
+    {
+        m_root = newParent;
+    }
+    else if (m_nodes[oldParent].child1 == sibling)
+    {
+        m_nodes[oldParent].child1 = newParent;
+    }
+    else
+    {
+        m_nodes[oldParent].child2 = newParent;
+    }
+
+    RefitAncestors(m_nodes[leaf].parent);
+}
+
+void BoundingVolumeTree::RemoveLeaf(uint32_t leaf)
+{
+    if (leaf == m_root)
+    {
+        m_root = INVALID_PROXY;
+        return;
+    }
+
+    const uint32_t parent = m_nodes[leaf].parent;
+    const uint32_t grandParent = m_nodes[parent].parent;
+    const uint32_t sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+    // The sibling takes the parent's place
+    m_nodes[sibling].parent = grandParent;
+    FreeNode(parent);
+    if (grandParent == INVALID_PROXY)
+    {
+        m_root = sibling;
+        return;
+    }
+
+    if (m_nodes[grandParent].child1 == parent)
+    {
+        m_nodes[grandParent].child1 = sibling;
+    }
+    else
+    {
+        m_nodes[grandParent].child2 = sibling;
+    }
+    RefitAncestors(grandParent);
+}
+
+void BoundingVolumeTree::RefitAncestors(uint32_t index)
+{
+    while (index != INVALID_PROXY)
+    {
+        index = Balance(index);
+
+        Node &node = m_nodes[index];
+        const Node &child1 = m_nodes[node.child1];
+        const Node &child2 = m_nodes[node.child2];
+        node.height = 1 + std::max(child1.height, child2.height);
+        node.box = Union(child1.box, child2.box);
+
+        index = node.parent;
+    }
+}
+
+uint32_t BoundingVolumeTree::Balance(uint32_t indexA)
+{
+    Node &a = m_nodes[indexA];
+    if (a.IsLeaf() || a.height < 2)
+    {
+        return indexA;
+    }
+
+    const uint32_t indexB = a.child1;
+    const uint32_t indexC = a.child2;
+    Node &b = m_nodes[indexB];
+    Node &c = m_nodes[indexC];
+    const int balance = c.height - b.height;
+
+    // Rotate the taller child up: it replaces A, A takes its place as a child, and the taller of its two
+    // children stays with it while the shorter one moves under A
+    auto rotateUp = [&](uint32_t indexUp, Node &up, Node &other, bool upIsChild1) {
+        const uint32_t indexF = up.child1;
+        const uint32_t indexG = up.child2;
+        Node &f = m_nodes[indexF];
+        Node &g = m_nodes[indexG];
+
+        up.child1 = indexA;
+        up.parent = a.parent;
+        a.parent = indexUp;
+
+        if (up.parent == INVALID_PROXY)
+        {
+            m_root = indexUp;
+        }
+        else if (m_nodes[up.parent].child1 == indexA)
+        {
+            m_nodes[up.parent].child1 = indexUp;
+        }
+        else
+        {
+            m_nodes[up.parent].child2 = indexUp;
+        }
+
+        const bool keepF = f.height > g.height;
+        const uint32_t indexKept = keepF ? indexF : indexG;
+        const uint32_t indexMoved = keepF ? indexG : indexF;
+        Node &kept = m_nodes[indexKept];
+        Node &moved = m_nodes[indexMoved];
+
+        up.child2 = indexKept;
+        if (upIsChild1)
+        {
+            a.child1 = indexMoved;
+        }
+        else
+        {
+            a.child2 = indexMoved;
+        }
+        moved.parent = indexA;
+
+        a.box = Union(other.box, moved.box);
+        up.box = Union(a.box, kept.box);
+        a.height = 1 + std::max(other.height, moved.height);
+        up.height = 1 + std::max(a.height, kept.height);
+        return indexUp;
+    };
+
+    if (balance > 1)
+    {
+        return rotateUp(indexC, c, b, false);
+    }
+    if (balance < -1)
+    {
+        return rotateUp(indexB, b, c, true);
+    }
+    return indexA;
+}
+
+bool BoundingVolumeTree::ValidateNode(uint32_t index) const
+{
+    const Node &node = m_nodes[index];
+    if (node.IsLeaf())
+    {
+        return node.height == 0 && node.child2 == INVALID_PROXY && node.box.Contains(m_boxes[index]);
+    }
+
+    const Node &child1 = m_nodes[node.child1];
+    const Node &child2 = m_nodes[node.child2];
+    if (child1.parent != index || child2.parent != index)
+    {
+        return false;
+    }
+    if (node.height != 1 + std::max(child1.height, child2.height))
+    {
+        return false;
+    }
+    if (!node.box.Contains(child1.box) || !node.box.Contains(child2.box))
+    {
+        return false;
+    }
+    return ValidateNode(node.child1) && ValidateNode(node.child2);
+}
+} // namespace eng
\ No newline at end of file
@@ -0,0 +1,496 @@
+#pragma once
+#include "core/Bounds.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <glm/vec3.hpp>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace eng
+{
+/**
+ * @class BoundingVolumeTree
+ * @brief Dynamic bounding volume hierarchy of axis-aligned boxes, updated incrementally as proxies move.
+ *
+ * Every proxy is a leaf holding its exact box and a fattened copy grown by a margin and by the predicted
+ * displacement. Internal nodes bound the fat boxes of their subtrees. Moving a proxy within its fat box
+ * costs nothing; a proxy that leaves it is removed and reinserted next to the sibling that grows the tree's
+ * surface area least, and the nodes on the way back to the root are refit and rebalanced with rotations, so
+ * the tree stays shallow however objects move.
+ *
+ * Queries report proxies whose exact box passes the test. They are const and may run on several threads at
+ * once, but not while the tree is modified. Query callbacks return false to stop a query early.
+ */
+class BoundingVolumeTree
+{
+  public:
+    using ProxyId = uint32_t;
+
+    static constexpr ProxyId INVALID_PROXY = UINT32_MAX;
+    static constexpr float DEFAULT_MARGIN = 0.1f;
+
+    /**
+     * @brief Constructor.
+     * @param margin Distance the fat boxes extend beyond the exact boxes on every side.
+     */
+    explicit BoundingVolumeTree(float margin = DEFAULT_MARGIN);
+
+    /**
+     * @brief Adds a proxy.
+     * @param box Exact box of the proxy.
+     * @param userData Value returned by GetUserData(), e.g. the object the proxy stands for.
+     * @return The ID of the proxy, stable until it is destroyed.
+     */
+    ProxyId CreateProxy(const BoundingBox &box, void *userData);
+
+    /**
+     * @brief Removes a proxy.
+     * @param proxy The proxy.
+     */
+    void DestroyProxy(ProxyId proxy);
+
+    /**
+     * @brief Updates the box of a proxy.
+     * @param proxy The proxy.
+     * @param box The new exact box.
+     * @param displacement Movement since the last update, used to stretch the fat box ahead of the proxy.
+     * @return true if the proxy had to be reinserted, false if its fat box still fit.
+     */
+    bool MoveProxy(ProxyId proxy, const BoundingBox &box, const glm::vec3 &displacement = glm::vec3(0.0f));
+
+    /**
+     * @brief Gets the user data of a proxy.
+     * @param proxy The proxy.
+     * @return The value passed to CreateProxy().
+     */
+    [[nodiscard]] void *GetUserData(ProxyId proxy) const;
+
+    /**
+     * @brief Gets the exact box of a proxy.
+     * @param proxy The proxy.
+     * @return The box last passed to CreateProxy() or MoveProxy().
+     */
+    [[nodiscard]] const BoundingBox &GetBox(ProxyId proxy) const;
+
+    /**
+     * @brief Gets the fat box of a proxy.
+     * @param proxy The proxy.
+     * @return The box the proxy is stored with.
+     */
+    [[nodiscard]] const BoundingBox &GetFatBox(ProxyId proxy) const;
+
+    /**
+     * @brief Gets the number of proxies.
+     * @return The proxy count.
+     */
+    [[nodiscard]] size_t GetProxyCount() const;
+
+    /**
+     * @brief Gets the height of the tree.
+     * @return 0 for an empty tree or a single proxy, otherwise the number of edges on the longest root-leaf path.
+     */
+    [[nodiscard]] int GetHeight() const;
+
+    /**
+     * @brief Checks the links, heights and boxes of every node.
+     * @return true if the tree is consistent.
+     */
+    [[nodiscard]] bool Validate() const;
+
+    /**
+     * @brief Removes all proxies.
+     */
+    void Clear();
+
+    /**
+     * @brief Calls callback(ProxyId) for every proxy whose box overlaps a box.
+     * @param box The box.
+     * @param callback Returns false to stop.
+     */
+    template <typename Callback> void QueryBox(const BoundingBox &box, Callback &&callback) const
+    {
+        Traverse([&box](const BoundingBox &nodeBox) { return nodeBox.Overlaps(box); }, callback);
+    }
+
+    /**
+     * @brief Calls callback(ProxyId) for every proxy whose box overlaps a sphere.
+     * @param sphere The sphere.
+     * @param callback Returns false to stop.
+     */
+    template <typename Callback> void QuerySphere(const BoundingSphere &sphere, Callback &&callback) const
+    {
+        const float radiusSquared = sphere.radius * sphere.radius;
+        auto test = [&sphere, radiusSquared](const BoundingBox &nodeBox) {
+            return nodeBox.DistanceSquared(sphere.center) <= radiusSquared;
+        };
+        Traverse(test, callback);
+    }
+
+    /**
+     * @brief Calls callback(ProxyId) for every proxy whose box is at least partly inside a frustum.
+     *
+     * Planes a node lies entirely inside are not tested again below it, and a node inside all planes reports
+     * its whole subtree without further tests.
+     * @param frustum The frustum.
+     * @param callback Returns false to stop.
+     */
+    template <typename Callback> void QueryFrustum(const Frustum &frustum, Callback &&callback) const
+    {
+        if (m_root == INVALID_PROXY)
+        {
+            return;
+        }
+
+        constexpr uint32_t ALL_PLANES = (1u << Frustum::PLANE_COUNT) - 1;
+        NodeStack stack;
+        stack.Push(PackFrustumEntry(m_root, ALL_PLANES));
+        while (!stack.IsEmpty())
+        {
+            const uint32_t entry = stack.Pop();
+            const ProxyId index = entry & NODE_MASK;
+            uint32_t planes = entry >> NODE_BITS;
+            const Node &node = m_nodes[index];
+
+            if (planes != 0)
+            {
+                planes = ClassifyAgainstFrustum(node.IsLeaf() ? m_boxes[index] : node.box, frustum, planes);
+                if (planes == OUTSIDE_FRUSTUM)
+                {
+                    continue;
+                }
+            }
+
+            if (node.IsLeaf())
+            {
+                if (!callback(index))
+                {
+                    return;
+                }
+            }
+            else
+            {
+                stack.Push(PackFrustumEntry(node.child1, planes));
+                stack.Push(PackFrustumEntry(node.child2, planes));
+            }
+        }
+    }
+
+    /**
+     * @brief Calls callback(ProxyId, float distance) for every proxy whose box a ray hits, in no particular order.
+     *
+     * The callback returns the new length of the ray: its distance argument to keep only closer hits, the
+     * current length to see every hit, or 0 to stop.
+     * @param origin Start of the ray.
+     * @param direction Direction of the ray; distances are in units of its length.
+     * @param maxDistance Length of the ray.
+     * @param callback Receives the proxy and the distance at which the ray enters its box.
+     */
+    template <typename Callback>
+    void RayCast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance, Callback &&callback) const
+    {
+        if (m_root == INVALID_PROXY)
+        {
+            return;
+        }
+
+        const glm::vec3 inverseDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+        NodeStack stack;
+        stack.Push(m_root);
+        while (!stack.IsEmpty() && maxDistance > 0.0f)
+        {
+            const ProxyId index = stack.Pop();
+            const Node &node = m_nodes[index];
+            const BoundingBox &nodeBox = node.IsLeaf() ? m_boxes[index] : node.box;
+            float distance = 0.0f;
+            if (!nodeBox.IntersectsRay(origin, inverseDirection, maxDistance, distance))
+            {
+                continue;
+            }
+
+            if (node.IsLeaf())
+            {
+                maxDistance = callback(index, distance);
+            }
+            else
+            {
+                stack.Push(node.child1);
+                stack.Push(node.child2);
+            }
+        }
+    }
+
+    /**
+     * @brief Finds the proxies whose boxes are closest to a point.
+     * @param point The point.
+     * @param count Maximum number of proxies.
+     * @param outProxies Cleared, then receives up to count proxies, nearest first.
+     * @param maxDistance Proxies farther away than this are ignored.
+     */
+    void QueryNearest(const glm::vec3 &point, size_t count, std::vector<ProxyId> &outProxies,
+                      float maxDistance = std::numeric_limits<float>::max()) const;
+
+    /**
+     * @brief Calls callback(ProxyId) for the proxies whose boxes are closest to a point, nearest first.
+     *
+     * The callback decides how many proxies it needs by returning false once it has enough, so proxies it
+     * rejects do not take the place of farther ones.
+     * @param point The point.
+     * @param callback Returns false to stop.
+     * @param maxDistance Proxies farther away than this are ignored.
+     */
+    template <typename Callback>
+    void QueryNearest(const glm::vec3 &point, Callback &&callback,
+                      float maxDistance = std::numeric_limits<float>::max()) const
+    {
+        if (m_root == INVALID_PROXY)
+        {
+            return;
+        }
+
+        // Best-first: entries come off the heap nearest first, and no descendant is nearer than its node, so
+        // each leaf that comes off is the next nearest proxy. Leaves enter with the distance to their exact box.
+        // The heap is borrowed from the thread's buffer, which keeps concurrent queries safe without allocating.
+        std::vector<NearestEntry> open = std::move(GetNearestScratch());
+        open.clear();
+        const float limit = maxDistance < std::numeric_limits<float>::max() ? maxDistance * maxDistance : maxDistance;
+
+        auto push = [this, &open, &point, limit](uint32_t index) {
+            const Node &node = m_nodes[index];
+            const BoundingBox &box = node.IsLeaf() ? m_boxes[index] : node.box;
+            const float distance = box.DistanceSquared(point);
+            if (distance <= limit)
+            {
+                open.emplace_back(distance, index);
+                std::push_heap(open.begin(), open.end(), std::greater<NearestEntry>());
+            }
+        };
+
+        push(m_root);
+        while (!open.empty())
+        {
+            std::pop_heap(open.begin(), open.end(), std::greater<NearestEntry>());
+            const uint32_t index = open.back().second;
+            open.pop_back();
+
+            const Node &node = m_nodes[index];
+            if (node.IsLeaf())
+            {
+                if (!callback(index))
+                {
+                    break;
+                }
+            }
+            else
+            {
+                push(node.child1);
+                push(node.child2);
+            }
+        }
+
+        GetNearestScratch() = std::move(open);
+    }
+
+  private:
+    /**
+     * @struct Node
+     * @brief A leaf holding a proxy, or an internal node with two children.
+     */
+    struct Node
+    {
+        BoundingBox box;                 ///< Fat box of a leaf, union of the children's boxes otherwise.
+        void *userData = nullptr;        ///< User data of a leaf.
+        uint32_t parent = INVALID_PROXY; ///< Parent node, or the next free node while the node is unused.
+        uint32_t child1 = INVALID_PROXY; ///< First child, INVALID_PROXY for leaves.
+        uint32_t child2 = INVALID_PROXY; ///< Second child, INVALID_PROXY for leaves.
+        int32_t height = -1;             ///< 0 for leaves, -1 for unused nodes.
+
+        /**
+         * @brief Checks if the node is a leaf.
+         * @return true if the node has no children.
+         */
+        [[nodiscard]] bool IsLeaf() const
+        {
+            return child1 == INVALID_PROXY;
+        }
+    };
+
+    /**
+     * @class NodeStack
+     * @brief Traversal stack that lives on the call stack unless a query goes unusually deep.
+     */
+    class NodeStack
+    {
+      public:
+        /**
+         * @brief Pushes an entry.
+         * @param value The entry.
+         */
+        void Push(uint32_t value)
+        {
+            if (m_size < INLINE_CAPACITY)
+            {
+                m_inline[m_size] = value;
+            }
+            else
+            {
+                m_overflow.push_back(value);
+            }
+            ++m_size;
+        }
+
+        /**
+         * @brief Pops the most recently pushed entry.
+         * @return The entry.
+         */
+        uint32_t Pop()
+        {
+            --m_size;
+            if (m_size < INLINE_CAPACITY)
+            {
+                return m_inline[m_size];
+            }
+
+            const uint32_t value = m_overflow.back();
+            m_overflow.pop_back();
+            return value;
+        }
+
+        /**
+         * @brief Checks if the stack is empty.
+         * @return true if there is nothing to pop.
+         */
+        [[nodiscard]] bool IsEmpty() const
+        {
+            return m_size == 0;
+        }
+
+      private:
+        static constexpr size_t INLINE_CAPACITY = 128;
+
+        uint32_t m_inline[INLINE_CAPACITY]; ///< First entries.
+        std::vector<uint32_t> m_overflow;   ///< Entries beyond INLINE_CAPACITY.
+        size_t m_size = 0;                  ///< Number of entries.
+    };
+
+    using NearestEntry = std::pair<float, uint32_t>;
+
+    static constexpr uint32_t NODE_BITS = 32 - Frustum::PLANE_COUNT;
+    static constexpr uint32_t NODE_MASK = (1u << NODE_BITS) - 1;
+    static constexpr uint32_t OUTSIDE_FRUSTUM = UINT32_MAX;
+
+    /**
+     * @brief Walks the nodes whose boxes pass a test and reports the leaves.
+     * @param test Called with node boxes: the fat box for internal nodes, the exact box for leaves.
+     * @param callback Called with the leaves that pass; returns false to stop.
+     */
+    template <typename Test, typename Callback> void Traverse(Test &&test, Callback &callback) const
+    {
+        if (m_root == INVALID_PROXY)
+        {
+            return;
+        }
+
+        NodeStack stack;
+        stack.Push(m_root);
+        while (!stack.IsEmpty())
+        {
+            const ProxyId index = stack.Pop();
+            const Node &node = m_nodes[index];
+            if (node.IsLeaf())
+            {
+                if (test(m_boxes[index]) && !callback(index))
+                {
+                    return;
+                }
+            }
+            else if (test(node.box))
+            {
+                stack.Push(node.child1);
+                stack.Push(node.child2);
+            }
+        }
+    }
+
+    /**
+     * @brief Gets the calling thread's heap buffer for QueryNearest(). A query nested in a callback finds it
+     * empty and allocates its own.
+     * @return The buffer.
+     */
+    static std::vector<NearestEntry> &GetNearestScratch();
+
+    /**
+     * @brief Packs a node and the frustum planes still to be tested into one stack entry.
+     * @param node The node.
+     * @param planes One bit per plane.
+     * @return The entry.
+     */
+    static uint32_t PackFrustumEntry(ProxyId node, uint32_t planes)
+    {
+        return node | (planes << NODE_BITS);
+    }
+
+    /**
+     * @brief Tests a box against the frustum planes that are still open.
+     * @param box The box.
+     * @param frustum The frustum.
+     * @param planes One bit per plane to test.
+     * @return OUTSIDE_FRUSTUM, or the planes the box is not entirely inside of.
+     */
+    static uint32_t ClassifyAgainstFrustum(const BoundingBox &box, const Frustum &frustum, uint32_t planes);
+
+    /**
+     * @brief Gets an unused node, growing the pool if needed.
+     * @return The node index.
+     */
+    uint32_t AllocateNode();
+
+    /**
+     * @brief Returns a node to the free list.
+     * @param index The node index.
+     */
+    void FreeNode(uint32_t index);
+
+    /**
+     * @brief Links a leaf into the tree next to the sibling that adds the least surface area.
+     * @param leaf The leaf.
+     */
+    void InsertLeaf(uint32_t leaf);
+
+    /**
+     * @brief Unlinks a leaf from the tree and frees its parent.
+     * @param leaf The leaf.
+     */
+    void RemoveLeaf(uint32_t leaf);
+
+    /**
+     * @brief Refits and rebalances the nodes from a node up to the root.
+     * @param index The first node.
+     */
+    void RefitAncestors(uint32_t index);
+
+    /**
+     * @brief Rotates a node's taller grandchild up if its children's heights differ by more than one.
+     * @param index The node.
+     * @return The node now at the node's former position.
+     */
+    uint32_t Balance(uint32_t index);
+
+    /**
+     * @brief Checks a subtree for Validate().
+     * @param index The subtree's root.
+     * @return true if the subtree is consistent.
+     */
+    [[nodiscard]] bool ValidateNode(uint32_t index) const;
+
+  private:
+    std::vector<Node> m_nodes;           ///< Node pool; proxy IDs are leaf indices.
+    std::vector<BoundingBox> m_boxes;    ///< Exact boxes of the leaves, by node index.
+    uint32_t m_root = INVALID_PROXY;     ///< Root node.
+    uint32_t m_freeList = INVALID_PROXY; ///< First unused node.
+    size_t m_proxyCount = 0;             ///< Number of leaves.
+    float m_margin = DEFAULT_MARGIN;     ///< Fat box margin.
+};
+} // namespace eng
\ No newline at end of file
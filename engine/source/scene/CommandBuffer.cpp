@@ -0,0 +1,110 @@
+#include "scene/CommandBuffer.h"
+#include "scene/Scene.h"
+
+namespace eng
+{
+void CommandBuffer::CreateObject(StringId name, ObjectHandle parent, ObjectFunction init)
+{
+    Command command;
+    command.type = CommandType::Create;
+    command.parent = parent;
+    command.name = name;
+    command.function = std::move(init);
+    Record(std::move(command));
+}
+
+void CommandBuffer::Destroy(ObjectHandle object)
+{
+    Command command;
+    command.type = CommandType::Destroy;
+    command.object = object;
+    Record(std::move(command));
+}
+
+void CommandBuffer::SetParent(ObjectHandle object, ObjectHandle parent)
+{
+    Command command;
+    command.type = CommandType::SetParent;
+    command.object = object;
+    command.parent = parent;
+    Record(std::move(command));
+}
+
+void CommandBuffer::Modify(ObjectHandle object, ObjectFunction function)
+{
+    Command command;
+    command.type = CommandType::Modify;
+    command.object = object;
+    command.function = std::move(function);
+    Record(std::move(command));
+}
+
+void CommandBuffer::Apply(Scene &scene)
+{
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_commands.empty())
+            {
+                return;
+            }
+            m_applying.swap(m_commands);
+        }
+
+        for (Command &command : m_applying)
+        {
+            switch (command.type)
+            {
+            case CommandType::Create:
+            {
+                GameObject *parent = scene.Resolve(command.parent);
+                if (command.parent.IsNull() || parent)
+                {
+                    GameObject *object = scene.CreateObject(command.name, parent);
+                    if (command.function)
+                    {
+                        command.function(*object);
+                    }
+                }
+                break;
+            }
+            case CommandType::Destroy:
+                if (GameObject *object = scene.Resolve(command.object))
+                {
+                    object->MarkForDestroy();
+                }
+                break;
+            case CommandType::SetParent:
+                scene.SetParent(command.object, command.parent);
+                break;
+            case CommandType::Modify:
+                if (GameObject *object = scene.Resolve(command.object))
+                {
+                    command.function(*object);
+                }
+                break;
+            }
+        }
+        m_applying.clear();
+    }
+}
+
+void CommandBuffer::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_commands.clear();
+}
+
+bool CommandBuffer::IsEmpty() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_commands.empty();
+}
+
+void CommandBuffer::Record(Command command)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_commands.push_back(std::move(command));
+}
+} // namespace eng
\ No newline at end of file
@@ -0,0 +1,136 @@
+#pragma once
+#include "core/StringId.h"
+#include "scene/Handle.h"
+#include <functional>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace eng
+{
+class GameObject;
+class Scene;
+
+/**
+ * @class CommandBuffer
+ * @brief Records structural changes to a scene so they can be requested while its systems run in parallel.
+ *
+ * Creating, destroying and reparenting objects or adding components changes containers shared by every
+ * system, so systems record these changes here instead and the scene applies them at its next sync point,
+ * after the systems of the current update have finished. Recording is thread-safe. Commands recorded by one
+ * thread are applied in the order they were recorded; the order between threads is unspecified. Objects are
+ * referenced by handle, so commands on objects destroyed in the meantime are dropped.
+ */
+class CommandBuffer
+{
+  public:
+    /**
+     * @brief Called with the object a command applies to.
+     */
+    using ObjectFunction = std::function<void(GameObject &)>;
+
+    CommandBuffer() = default;
+    CommandBuffer(const CommandBuffer &) = delete;
+    CommandBuffer &operator=(const CommandBuffer &) = delete;
+
+    /**
+     * @brief Records the creation of an object.
+     * @param name The name of the new object.
+     * @param parent Handle of the parent, or a null handle for a root object.
+     * @param init Optional function called with the new object, e.g. to add its components.
+     */
+    void CreateObject(StringId name, ObjectHandle parent = {}, ObjectFunction init = {});
+
+    /**
+     * @brief Records the destruction of an object and its children.
+     * @param object Handle of the object.
+     */
+    void Destroy(ObjectHandle object);
+
+    /**
+     * @brief Records a change of parent.
+     * @param object Handle of the object.
+     * @param parent Handle of the new parent, or a null handle for the scene root.
+     */
+    void SetParent(ObjectHandle object, ObjectHandle parent);
+
+    /**
+     * @brief Records a change to an object, such as adding or removing components.
+     * @param object Handle of the object.
+     * @param function Called with the object if it is still alive when the buffer is applied.
+     */
+    void Modify(ObjectHandle object, ObjectFunction function);
+
+    /**
+     * @brief Records adding a component constructed from copies of the arguments.
+     * @tparam T The type of the component.
+     * @param object Handle of the object.
+     * @param args Arguments copied now and forwarded to the constructor of T when the buffer is applied.
+     */
+    template <typename T, typename... Args> void AddComponent(ObjectHandle object, Args &&...args)
+    {
+        // A generic lambda, so GameObject only needs to be complete where this is instantiated
+        Modify(object, [arguments = std::make_tuple(std::forward<Args>(args)...)](auto &target) mutable {
+            std::apply([&target](auto &...values) { target.template AddComponent<T>(std::move(values)...); },
+                       arguments);
+        });
+    }
+
+    /**
+     * @brief Applies all recorded commands to a scene and clears the buffer.
+     *
+     * Commands recorded while applying, e.g. by an init function, are applied in the same call.
+     * @param scene The scene.
+     */
+    void Apply(Scene &scene);
+
+    /**
+     * @brief Drops all recorded commands.
+     */
+    void Clear();
+
+    /**
+     * @brief Checks if no command is recorded.
+     * @return true if the buffer is empty.
+     */
+    [[nodiscard]] bool IsEmpty() const;
+
+  private:
+    /**
+     * @enum CommandType
+     * @brief Kind of a recorded command.
+     */
+    enum class CommandType
+    {
+        Create,    ///< Create an object, then call the function on it.
+        Destroy,   ///< Destroy an object.
+        SetParent, ///< Change the parent of an object.
+        Modify     ///< Call the function on an object.
+    };
+
+    /**
+     * @struct Command
+     * @brief One recorded structural change.
+     */
+    struct Command
+    {
+        CommandType type = CommandType::Modify; ///< What to do.
+        ObjectHandle object;                    ///< Object the command applies to; unused by Create.
+        ObjectHandle parent;                    ///< Parent for Create and SetParent.
+        StringId name;                          ///< Name for Create.
+        ObjectFunction function;                ///< Init function of Create, or the change of Modify.
+    };
+
+    /**
+     * @brief Appends a command under the lock.
+     * @param command The command.
+     */
+    void Record(Command command);
+
+  private:
+    mutable std::mutex m_mutex;      ///< Guards m_commands.
+    std::vector<Command> m_commands; ///< Commands in recording order.
+    std::vector<Command> m_applying; ///< Commands taken by Apply(), kept to reuse their storage.
+};
+} // namespace eng
\ No newline at end of file
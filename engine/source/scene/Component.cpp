@@ -1,11 +1,44 @@
 #include "scene/Component.h"
+#include "scene/GameObject.h"
+#include "scene/ObjectPool.h"
 
 namespace eng
 {
-size_t Component::nextId = 1;
+std::atomic<size_t> Component::nextId{1};
+
+void Component::Update(float)
+{
+}
+
+void Component::FixedUpdate(float)
+{
+}
+
+void Component::LateUpdate(float)
+{
+}
+
+void *Component::operator new(size_t size)
+{
+    return ObjectPool::AllocateFromCurrent(size);
+}
+
+void Component::operator delete(void *memory)
+{
+    ObjectPool::Free(memory);
+}
 
 GameObject *Component::GetOwner()
 {
     return m_owner;
 }
+
+ComponentHandle Component::GetHandle() const
+{
+    if (!m_owner)
+    {
+        return {};
+    }
+    return {m_owner->GetHandle(), GetTypeId()};
+}
 } // namespace eng
\ No newline at end of file
@@ -1,13 +1,32 @@
 #pragma once
+#include "scene/Handle.h"
+#include <atomic>
+#include <bitset>
 #include <cstddef>
 
 namespace eng
 {
 class GameObject;
 
+/**
+ * @brief Number of component type IDs tracked by ComponentMask. Types with larger IDs are still found by
+ * GameObject::GetComponent, only without the bitmask early-out.
+ */
+constexpr size_t MAX_MASKED_COMPONENT_TYPES = 128;
+
+/**
+ * @brief One bit per component type ID, set for every type an object holds.
+ */
+using ComponentMask = std::bitset<MAX_MASKED_COMPONENT_TYPES>;
+
 /**
  * @class Component
  * @brief Base class for all components that can be attached to game objects.
+ *
+ * Components added with GameObject::AddComponent<T>() are updated per type by the scene's systems: each
+ * overridden update function runs over all instances of T in one batch, without virtual calls, and types
+ * that override none of them are never visited. A type can replace its Update batch by declaring
+ * static void UpdateBatch(T *components, uint32_t count, float deltaTime).
  */
 class Component
 {
@@ -18,10 +37,52 @@ class Component
     virtual ~Component() = default;
 
     /**
-     * @brief Pure virtual function for the component's update logic.
+     * @brief Allocates from the ObjectPool current on the calling thread, or from the global heap.
+     * @param size Number of bytes.
+     * @return The memory.
+     */
+    static void *operator new(size_t size);
+
+    /**
+     * @brief Constructs in memory provided by the caller.
+     * @param place The memory.
+     * @return place.
+     */
+    static void *operator new(size_t, void *place) noexcept
+    {
+        return place;
+    }
+
+    /**
+     * @brief Returns memory to the pool it came from.
+     * @param memory The memory.
+     */
+    static void operator delete(void *memory);
+
+    /**
+     * @brief Matches the placement operator new; nothing to free.
+     */
+    static void operator delete(void *, void *) noexcept
+    {
+    }
+
+    /**
+     * @brief Called once per frame. Does nothing by default.
+     * @param deltaTime The time since the last frame in seconds.
+     */
+    virtual void Update(float deltaTime);
+
+    /**
+     * @brief Called at the engine's fixed tick rate, before Update.
+     * @param fixedDeltaTime The duration of one fixed step in seconds.
+     */
+    virtual void FixedUpdate(float fixedDeltaTime);
+
+    /**
+     * @brief Called once per frame after every object has run Update.
      * @param deltaTime The time since the last frame in seconds.
      */
-    virtual void Update(float deltaTime) = 0;
+    virtual void LateUpdate(float deltaTime);
 
     /**
      * @brief Gets the type ID of the component.
@@ -35,14 +96,22 @@ class Component
      */
     GameObject *GetOwner();
 
+    /**
+     * @brief Gets a handle that stays safe to resolve after the component moves or its owner is destroyed.
+     * @return The handle, or a null handle if the component has no owner in a scene.
+     */
+    [[nodiscard]] ComponentHandle GetHandle() const;
+
     /**
      * @brief Statically generates or retrieves a unique type ID for a component class.
+     *
+     * IDs are dense, starting at 1 in the order types are first seen, so they can index tables and bitmasks.
      * @tparam T The component class type.
      * @return The unique type ID for type T.
      */
     template <typename T> static size_t StaticTypeId()
     {
-        static size_t typeId = nextId++;
+        static const size_t typeId = nextId.fetch_add(1, std::memory_order_relaxed);
         return typeId;
     }
 
@@ -52,7 +121,7 @@ class Component
     friend class GameObject;
 
   private:
-    static size_t nextId; ///< Global ID counter for components.
+    static std::atomic<size_t> nextId; ///< Global ID counter for components.
 };
 
 /**
@@ -0,0 +1,310 @@
+#include "scene/ComponentStore.h"
+#include "jobs/JobSystem.h"
+#include "scene/GameObject.h"
+#include "scene/TransformStore.h"
+#include <algorithm>
+
+namespace eng
+{
+ComponentStore::ComponentStore(TransformStore *transforms) : m_transforms(transforms)
+{
+}
+
+void *ComponentStore::Allocate(GameObject *owner, const ComponentTypeInfo &type)
+{
+    Archetype *source = owner->m_archetype;
+    Archetype *destination = GetArchetypeWith(source, type);
+    const uint32_t row = destination->AddRow(owner);
+
+    if (source)
+    {
+        const uint32_t sourceRow = owner->m_archetypeRow;
+        for (size_t column = 0; column < source->GetColumnCount(); ++column)
+        {
+            const auto destinationColumn = static_cast<size_t>(destination->FindColumn(source->GetType(column).typeId));
+            source->GetType(column).moveAndDestroy(destination->GetData(destinationColumn, row),
+                                                   source->GetData(column, sourceRow));
+        }
+
+        if (GameObject *moved = source->RemoveRow(sourceRow, false))
+        {
+            moved->m_archetypeRow = sourceRow;
+        }
+    }
+
+    owner->m_archetype = destination;
+    owner->m_archetypeRow = row;
+
+    return destination->GetData(static_cast<size_t>(destination->FindColumn(type.typeId)), row);
+}
+
+void ComponentStore::Remove(GameObject *owner)
+{
+    if (!owner->m_archetype)
+    {
+        return;
+    }
+
+    if (GameObject *moved = owner->m_archetype->RemoveRow(owner->m_archetypeRow, true))
+    {
+        moved->m_archetypeRow = owner->m_archetypeRow;
+    }
+
+    owner->m_archetype = nullptr;
+    owner->m_archetypeRow = 0;
+}
+
+void ComponentStore::RunUpdate(float deltaTime, JobSystem *jobSystem)
+{
+    RunSystems(&ComponentTypeInfo::update, m_updateSchedule, deltaTime, jobSystem);
+}
+
+void ComponentStore::RunFixedUpdate(float fixedDeltaTime, JobSystem *jobSystem)
+{
+    RunSystems(&ComponentTypeInfo::fixedUpdate, m_fixedUpdateSchedule, fixedDeltaTime, jobSystem);
+}
+
+void ComponentStore::RunLateUpdate(float deltaTime, JobSystem *jobSystem)
+{
+    RunSystems(&ComponentTypeInfo::lateUpdate, m_lateUpdateSchedule, deltaTime, jobSystem);
+}
+
+bool ComponentStore::IsIterating() const
+{
+    return m_iterationDepth > 0;
+}
+
+size_t ComponentStore::GetArchetypeCount() const
+{
+    return m_archetypes.size();
+}
+
+size_t ComponentStore::GetSystemCount() const
+{
+    return m_systems.size();
+}
+
+void ComponentStore::RunSystems(ComponentBatchFunction ComponentTypeInfo::*function, Schedule &schedule,
+                                float deltaTime, JobSystem *jobSystem)
+{
+    IterationLock lock(*this);
+
+    if (!jobSystem || jobSystem->GetWorkerCount() == 0)
+    {
+        for (const auto &system : m_systems)
+        {
+            if (system.type.*function)
+            {
+                RunChunkJob(ChunkJob{&system}, function, deltaTime);
+            }
+        }
+        return;
+    }
+
+    if (!schedule.valid)
+    {
+        BuildSchedule(function, schedule);
+    }
+
+    size_t first = 0;
+    for (uint32_t end : schedule.waveEnds)
+    {
+        RunWave(function, schedule.systems.data() + first, end - first, deltaTime, *jobSystem);
+        first = end;
+    }
+}
+
+void ComponentStore::RunWave(ComponentBatchFunction ComponentTypeInfo::*function, const uint32_t *systems,
+                             size_t count, float deltaTime, JobSystem &jobSystem)
+{
+    const size_t transformTypeId = SystemAccess::GetTransformTypeId();
+    bool readsTransforms = false;
+
+    m_jobs.clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const System &system = m_systems[systems[i]];
+        const SystemAccess &access = *system.type.access;
+        if (!access.declared || access.CanWrite(transformTypeId))
+        {
+            m_jobs.push_back(ChunkJob{&system});
+            continue;
+        }
+
+        readsTransforms = readsTransforms || access.CanRead(transformTypeId);
+        for (Archetype *archetype : system.archetypes)
+        {
+            for (size_t chunk = 0; chunk < archetype->GetChunkCount(); ++chunk)
+            {
+                m_jobs.push_back(ChunkJob{&system, archetype, chunk});
+            }
+        }
+    }
+
+    if (m_jobs.size() == 1)
+    {
+        RunChunkJob(m_jobs.front(), function, deltaTime);
+        return;
+    }
+
+    // World transforms are cached lazily by const getters, which must not race
+    if (readsTransforms && m_transforms)
+    {
+        m_transforms->UpdateWorldTransforms();
+    }
+
+    // A few ranges per thread balance uneven chunks without paying for a job per chunk
+    const size_t grainSize = std::max<size_t>(m_jobs.size() / ((jobSystem.GetWorkerCount() + 1) * 4), 1);
+    jobSystem.ParallelFor(m_jobs.size(), grainSize, [this, function, deltaTime](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            RunChunkJob(m_jobs[i], function, deltaTime);
+        }
+    });
+}
+
+void ComponentStore::RunChunkJob(const ChunkJob &job, ComponentBatchFunction ComponentTypeInfo::*function,
+                                 float deltaTime)
+{
+    const System &system = *job.system;
+    ComponentBatchFunction batch = system.type.*function;
+#if ENG_SYSTEM_ACCESS_CHECKS
+    SystemAccessChecker::Scope accessScope(system.type.access);
+#endif
+
+    if (job.archetype)
+    {
+        const auto column = static_cast<size_t>(job.archetype->FindColumn(system.type.typeId));
+        batch(job.archetype->GetColumn(job.chunk, column), job.archetype->GetChunkRowCount(job.chunk), deltaTime);
+        return;
+    }
+
+    for (Archetype *archetype : system.archetypes)
+    {
+        const auto column = static_cast<size_t>(archetype->FindColumn(system.type.typeId));
+        for (size_t chunk = 0; chunk < archetype->GetChunkCount(); ++chunk)
+        {
+            batch(archetype->GetColumn(chunk, column), archetype->GetChunkRowCount(chunk), deltaTime);
+        }
+    }
+}
+
+void ComponentStore::BuildSchedule(ComponentBatchFunction ComponentTypeInfo::*function, Schedule &schedule) const
+{
+    // Every system goes into the first wave after all earlier systems it conflicts with
+    std::vector<uint32_t> waves(m_systems.size(), 0);
+    uint32_t waveCount = 0;
+    for (size_t i = 0; i < m_systems.size(); ++i)
+    {
+        if (!(m_systems[i].type.*function))
+        {
+            continue;
+        }
+
+        for (size_t j = 0; j < i; ++j)
+        {
+            if (m_systems[j].type.*function && m_systems[i].type.access->ConflictsWith(*m_systems[j].type.access))
+            {
+                waves[i] = std::max(waves[i], waves[j] + 1);
+            }
+        }
+        waveCount = std::max(waveCount, waves[i] + 1);
+    }
+
+    schedule.systems.clear();
+    schedule.waveEnds.clear();
+    for (uint32_t wave = 0; wave < waveCount; ++wave)
+    {
+        for (size_t i = 0; i < m_systems.size(); ++i)
+        {
+            if (m_systems[i].type.*function && waves[i] == wave)
+            {
+                schedule.systems.push_back(static_cast<uint32_t>(i));
+            }
+        }
+        schedule.waveEnds.push_back(static_cast<uint32_t>(schedule.systems.size()));
+    }
+    schedule.valid = true;
+}
+
+void ComponentStore::RegisterSystems(Archetype *archetype)
+{
+    for (size_t column = 0; column < archetype->GetColumnCount(); ++column)
+    {
+        const ComponentTypeInfo &type = archetype->GetType(column);
+        if (!type.update && !type.fixedUpdate && !type.lateUpdate)
+        {
+            continue;
+        }
+
+        auto it = std::lower_bound(m_systems.begin(), m_systems.end(), type.typeId,
+                                   [](const System &system, size_t typeId) { return system.type.typeId < typeId; });
+        if (it == m_systems.end() || it->type.typeId != type.typeId)
+        {
+            it = m_systems.insert(it, System{type, {}});
+            m_updateSchedule.valid = false;
+            m_fixedUpdateSchedule.valid = false;
+            m_lateUpdateSchedule.valid = false;
+        }
+        it->archetypes.push_back(archetype);
+    }
+}
+
+Archetype *ComponentStore::GetArchetypeWith(Archetype *source, const ComponentTypeInfo &type)
+{
+    Archetype *cached = nullptr;
+    if (source)
+    {
+        cached = source->GetAddEdge(type.typeId);
+    }
+    else
+    {
+        auto it = m_rootEdges.find(type.typeId);
+        cached = it != m_rootEdges.end() ? it->second : nullptr;
+    }
+
+    if (cached)
+    {
+        return cached;
+    }
+
+    std::vector<ComponentTypeInfo> types;
+    if (source)
+    {
+        for (size_t column = 0; column < source->GetColumnCount(); ++column)
+        {
+            types.push_back(source->GetType(column));
+        }
+    }
+    types.insert(std::upper_bound(types.begin(), types.end(), type,
+                                  [](const ComponentTypeInfo &a, const ComponentTypeInfo &b) {
+                                      return a.typeId < b.typeId;
+                                  }),
+                 type);
+
+    std::vector<size_t> typeIds;
+    for (const auto &info : types)
+    {
+        typeIds.push_back(info.typeId);
+    }
+
+    Archetype *&archetype = m_archetypesByTypes[typeIds];
+    if (!archetype)
+    {
+        m_archetypes.push_back(std::make_unique<Archetype>(std::move(types)));
+        archetype = m_archetypes.back().get();
+        RegisterSystems(archetype);
+    }
+
+    if (source)
+    {
+        source->SetAddEdge(type.typeId, archetype);
+    }
+    else
+    {
+        m_rootEdges[type.typeId] = archetype;
+    }
+
+    return archetype;
+}
+} // namespace eng
\ No newline at end of file
@@ -0,0 +1,267 @@
+#pragma once
+#include "scene/Archetype.h"
+#include <map>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace eng
+{
+class JobSystem;
+class TransformStore;
+
+/**
+ * @class ComponentStore
+ * @brief Scene-level archetype storage for the components added with GameObject::AddComponent<T>().
+ *
+ * Every object with components here belongs to exactly one Archetype, the one matching its set of
+ * component types. Adding a component moves the object's row to the archetype with one more type;
+ * the archetype graph edges are cached, so this is a lookup plus one move per existing component.
+ * Components are moved in memory when their object or another object of the same archetype changes,
+ * so pointers to them are only valid until the next structural change.
+ *
+ * Every stored type with an update function is a system: RunUpdate() and friends call its batch function
+ * once per chunk, over all instances of the type, in type ID order. While systems or Each() run the
+ * store is locked and GameObject::AddComponent<T>() falls back to a heap allocation.
+ *
+ * Given a JobSystem with workers, the systems run in parallel instead. They are grouped into waves by their
+ * SystemAccess: a system goes into the first wave after every earlier system it conflicts with, so the
+ * result matches the serial order. The systems of a wave run at the same time and systems with a declaration
+ * are split into one job per chunk, except those that write transforms: setting a transform invalidates the
+ * children, which may sit in other chunks. World transforms are refreshed before a wave that reads them.
+ */
+class ComponentStore
+{
+  public:
+    /**
+     * @brief Creates an empty store.
+     * @param transforms Transforms refreshed before systems that read them run in parallel, if any.
+     */
+    explicit ComponentStore(TransformStore *transforms = nullptr);
+    ComponentStore(const ComponentStore &) = delete;
+    ComponentStore &operator=(const ComponentStore &) = delete;
+
+    /**
+     * @brief Moves an object to the archetype that also stores the given type.
+     * @param owner The object receiving the component; must not store that type already.
+     * @param type The added component type.
+     * @return Uninitialized memory for the new component, to be constructed by the caller.
+     */
+    void *Allocate(GameObject *owner, const ComponentTypeInfo &type);
+
+    /**
+     * @brief Destroys all components stored here for an object.
+     * @param owner The object.
+     */
+    void Remove(GameObject *owner);
+
+    /**
+     * @brief Calls a function for every object that stores all of the given component types.
+     *
+     * Objects are visited chunk by chunk, so each component type is read from contiguous memory.
+     * The function must not add components or destroy objects during the iteration.
+     * @tparam Ts The required component types.
+     * @param func Called as func(GameObject &, Ts &...).
+     */
+    template <typename... Ts, typename Func> void Each(Func &&func)
+    {
+        static_assert(sizeof...(Ts) > 0, "Each needs at least one component type");
+        const size_t typeIds[] = {Component::StaticTypeId<Ts>()...};
+        IterationLock lock(*this);
+
+        for (auto &archetype : m_archetypes)
+        {
+            size_t columns[sizeof...(Ts)];
+            bool matches = true;
+            for (size_t i = 0; i < sizeof...(Ts) && matches; ++i)
+            {
+                const int column = archetype->FindColumn(typeIds[i]);
+                matches = column >= 0;
+                columns[i] = static_cast<size_t>(column);
+            }
+
+            if (!matches)
+            {
+                continue;
+            }
+
+            for (size_t chunk = 0; chunk < archetype->GetChunkCount(); ++chunk)
+            {
+                EachInChunk<Ts...>(*archetype, chunk, columns, func, std::index_sequence_for<Ts...>());
+            }
+        }
+    }
+
+    /**
+     * @brief Runs the Update systems.
+     * @param deltaTime The time since the last frame in seconds.
+     * @param jobSystem Runs the systems in parallel if it has workers; nullptr runs them in type ID order.
+     */
+    void RunUpdate(float deltaTime, JobSystem *jobSystem = nullptr);
+
+    /**
+     * @brief Runs the FixedUpdate systems.
+     * @param fixedDeltaTime The duration of one fixed step in seconds.
+     * @param jobSystem Runs the systems in parallel if it has workers; nullptr runs them in type ID order.
+     */
+    void RunFixedUpdate(float fixedDeltaTime, JobSystem *jobSystem = nullptr);
+
+    /**
+     * @brief Runs the LateUpdate systems.
+     * @param deltaTime The time since the last frame in seconds.
+     * @param jobSystem Runs the systems in parallel if it has workers; nullptr runs them in type ID order.
+     */
+    void RunLateUpdate(float deltaTime, JobSystem *jobSystem = nullptr);
+
+    /**
+     * @brief Checks if systems or Each() are iterating, so the storage must not change.
+     * @return true while locked.
+     */
+    [[nodiscard]] bool IsIterating() const;
+
+    /**
+     * @brief Gets the number of distinct archetypes created so far.
+     * @return The archetype count.
+     */
+    [[nodiscard]] size_t GetArchetypeCount() const;
+
+    /**
+     * @brief Gets the number of component types that have at least one update function.
+     * @return The system count.
+     */
+    [[nodiscard]] size_t GetSystemCount() const;
+
+  private:
+    /**
+     * @struct System
+     * @brief A stored component type with an update function, and every archetype that contains it.
+     */
+    struct System
+    {
+        ComponentTypeInfo type;              ///< The component type.
+        std::vector<Archetype *> archetypes; ///< Archetypes with a column of that type.
+    };
+
+    /**
+     * @struct Schedule
+     * @brief The systems of one update function, grouped into waves that can run at the same time.
+     */
+    struct Schedule
+    {
+        std::vector<uint32_t> systems;  ///< Indices in m_systems, wave by wave.
+        std::vector<uint32_t> waveEnds; ///< End of each wave in systems.
+        bool valid = false;             ///< Whether the waves match the current systems.
+    };
+
+    /**
+     * @struct ChunkJob
+     * @brief One chunk of one system, or all chunks of a system that is not split.
+     */
+    struct ChunkJob
+    {
+        const System *system = nullptr; ///< The system.
+        Archetype *archetype = nullptr; ///< Archetype of the chunk, nullptr for the whole system.
+        size_t chunk = 0;               ///< Index of the chunk in the archetype.
+    };
+
+    /**
+     * @class IterationLock
+     * @brief Locks the store for the lifetime of the object.
+     */
+    class IterationLock
+    {
+      public:
+        explicit IterationLock(ComponentStore &store) : m_store(store)
+        {
+            ++m_store.m_iterationDepth;
+        }
+
+        ~IterationLock()
+        {
+            --m_store.m_iterationDepth;
+        }
+
+      private:
+        ComponentStore &m_store; ///< The locked store.
+    };
+
+    /**
+     * @brief Calls one batch function of every system over all of its chunks.
+     * @param function The member of ComponentTypeInfo to call.
+     * @param schedule The waves of that function.
+     * @param deltaTime Passed to the batch functions.
+     * @param jobSystem Runs the waves in parallel if it has workers.
+     */
+    void RunSystems(ComponentBatchFunction ComponentTypeInfo::*function, Schedule &schedule, float deltaTime,
+                    JobSystem *jobSystem);
+
+    /**
+     * @brief Runs the systems of one wave at the same time.
+     * @param function The member of ComponentTypeInfo to call.
+     * @param systems Indices of the systems in m_systems.
+     * @param count Number of systems.
+     * @param deltaTime Passed to the batch functions.
+     * @param jobSystem The job system.
+     */
+    void RunWave(ComponentBatchFunction ComponentTypeInfo::*function, const uint32_t *systems, size_t count,
+                 float deltaTime, JobSystem &jobSystem);
+
+    /**
+     * @brief Calls one batch function of a system over some or all of its chunks.
+     * @param job The system and the chunk.
+     * @param function The member of ComponentTypeInfo to call.
+     * @param deltaTime Passed to the batch function.
+     */
+    static void RunChunkJob(const ChunkJob &job, ComponentBatchFunction ComponentTypeInfo::*function,
+                            float deltaTime);
+
+    /**
+     * @brief Groups the systems of one update function into waves.
+     * @param function The member of ComponentTypeInfo the schedule is for.
+     * @param schedule Receives the waves.
+     */
+    void BuildSchedule(ComponentBatchFunction ComponentTypeInfo::*function, Schedule &schedule) const;
+
+    /**
+     * @brief Adds a new archetype to the systems of its types.
+     * @param archetype The archetype.
+     */
+    void RegisterSystems(Archetype *archetype);
+
+    template <typename... Ts, typename Func, size_t... Is>
+    static void EachInChunk(const Archetype &archetype, size_t chunk, const size_t *columns, Func &func,
+                            std::index_sequence<Is...>)
+    {
+        GameObject *const *owners = archetype.GetOwners(chunk);
+        const uint32_t count = archetype.GetChunkRowCount(chunk);
+        auto data = std::make_tuple(static_cast<Ts *>(archetype.GetColumn(chunk, columns[Is]))...);
+
+        for (uint32_t row = 0; row < count; ++row)
+        {
+            func(*owners[row], std::get<Is>(data)[row]...);
+        }
+    }
+
+    /**
+     * @brief Finds or creates the archetype reached by adding a type to another one.
+     * @param source The current archetype, or nullptr for an object without stored components.
+     * @param type The added component type.
+     * @return The destination archetype.
+     */
+    Archetype *GetArchetypeWith(Archetype *source, const ComponentTypeInfo &type);
+
+  private:
+    std::vector<std::unique_ptr<Archetype>> m_archetypes;           ///< All archetypes, in creation order.
+    std::map<std::vector<size_t>, Archetype *> m_archetypesByTypes; ///< Archetypes keyed by their sorted type IDs.
+    std::unordered_map<size_t, Archetype *> m_rootEdges;            ///< Archetypes holding a single type.
+    std::vector<System> m_systems;                                  ///< Systems, sorted by type ID.
+    Schedule m_updateSchedule;                                      ///< Waves of the Update systems.
+    Schedule m_fixedUpdateSchedule;                                 ///< Waves of the FixedUpdate systems.
+    Schedule m_lateUpdateSchedule;                                  ///< Waves of the LateUpdate systems.
+    std::vector<ChunkJob> m_jobs;                                   ///< Scratch list of RunWave().
+    TransformStore *m_transforms = nullptr;                         ///< Transforms refreshed before reading waves.
+    int m_iterationDepth = 0;                                       ///< Number of active iteration locks.
+};
+} // namespace eng
\ No newline at end of file
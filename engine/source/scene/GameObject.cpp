@@ -1,38 +1,148 @@
 #include "scene/GameObject.h"
+#include "profiling/Profiler.h"
+#include "scene/Scene.h"
+#include "scene/TransformStore.h"
+#include <algorithm>
+#include <glm/common.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <iostream>
 
 namespace eng
 {
+thread_local Scene *GameObject::s_constructionScene = nullptr;
+
+GameObject::GameObject()
+{
+    if (s_constructionScene)
+    {
+        m_scene = s_constructionScene;
+        m_handle = s_constructionScene->AllocateHandle(this);
+        m_transforms = &s_constructionScene->GetTransformStore();
+        m_componentStore = &s_constructionScene->GetComponentStore();
+        m_objectPool = &s_constructionScene->GetObjectPool();
+    }
+    else
+    {
+        m_ownedTransforms = std::make_unique<TransformStore>();
+        m_transforms = m_ownedTransforms.get();
+    }
+    m_transformIndex = m_transforms->Allocate(this);
+}
+
+GameObject::~GameObject()
+{
+    if (m_componentStore)
+    {
+        m_componentStore->Remove(this);
+    }
+    m_transforms->Release(m_transformIndex);
+    if (m_scene)
+    {
+        m_scene->RemoveFromSpatialIndex(this);
+        m_scene->RemoveFromSpatialGrid(this);
+        m_scene->RemoveFromNameIndex(this);
+        m_scene->ReleaseHandle(m_handle);
+    }
+}
+
+void *GameObject::operator new(size_t size)
+{
+    return ObjectPool::AllocateFromCurrent(size);
+}
+
+void GameObject::operator delete(void *memory)
+{
+    ObjectPool::Free(memory);
+}
+
 void GameObject::Update(float deltaTime)
 {
+    ENG_PROFILE_SCOPE("GameObject::Update");
+
     for (auto &component : m_components)
     {
         component->Update(deltaTime);
     }
 
-    for (auto it = m_children.begin(); it != m_children.end();)
+    // Indices instead of iterators, so children created during the update do not invalidate the loop
+    for (size_t i = 0; i < m_children.size(); ++i)
     {
-        if ((*it)->IsAlive())
+        if (m_children[i]->IsAlive())
         {
-            (*it)->Update(deltaTime);
-            ++it;
+            m_children[i]->Update(deltaTime);
         }
-        else
+    }
+}
+
+void GameObject::FixedUpdate(float fixedDeltaTime)
+{
+    if (m_interpolate)
+    {
+        ResetInterpolation();
+    }
+
+    for (auto &component : m_components)
+    {
+        component->FixedUpdate(fixedDeltaTime);
+    }
+
+    for (auto &child : m_children)
+    {
+        if (child->IsAlive())
+        {
+            child->FixedUpdate(fixedDeltaTime);
+        }
+    }
+}
+
+void GameObject::LateUpdate(float deltaTime)
+{
+    for (auto &component : m_components)
+    {
+        component->LateUpdate(deltaTime);
+    }
+
+    for (auto &child : m_children)
+    {
+        if (child->IsAlive())
         {
-            it = m_children.erase(it);
+            child->LateUpdate(deltaTime);
         }
     }
 }
 
 const std::string &GameObject::GetName() const
+{
+    return m_name.GetString();
+}
+
+StringId GameObject::GetNameId() const
 {
     return m_name;
 }
 
 void GameObject::SetName(const std::string &name)
 {
+    SetName(StringId(name));
+}
+
+void GameObject::SetName(StringId name)
+{
+    ENG_CHECK_STRUCTURAL_CHANGE("GameObject::SetName");
+    if (name == m_name)
+    {
+        return;
+    }
+
+    if (m_scene)
+    {
+        m_scene->RemoveFromNameIndex(this);
+    }
     m_name = name;
+    if (m_scene)
+    {
+        m_scene->AddToNameIndex(this);
+    }
 }
 
 GameObject *GameObject::GetParent()
@@ -47,75 +157,286 @@ bool GameObject::IsAlive() const
 
 void GameObject::MarkForDestroy()
 {
+    ENG_CHECK_STRUCTURAL_CHANGE("GameObject::MarkForDestroy");
+    if (!m_isAlive)
+    {
+        return;
+    }
+
     m_isAlive = false;
+    if (m_scene)
+    {
+        m_scene->QueueDestroy(this);
+    }
 }
 
 void GameObject::AddComponent(Component *component)
 {
+    ENG_CHECK_STRUCTURAL_CHANGE("GameObject::AddComponent");
     if (!component)
     {
-        std::cerr << "Error: Attempted to add nullptr component to GameObject " << m_name << std::endl;
+        std::cerr << "Error: Attempted to add nullptr component to GameObject " << GetName() << std::endl;
         return;
     }
+    const size_t typeId = component->GetTypeId();
+    const auto slot = static_cast<uint32_t>(m_components.size());
     m_components.emplace_back(component);
     component->m_owner = this;
+
+    // upper_bound keeps the first added component of a type in front, as the old linear search found it
+    auto it = std::upper_bound(m_componentSlots.begin(), m_componentSlots.end(), typeId,
+                               [](size_t id, const std::pair<size_t, uint32_t> &entry) { return id < entry.first; });
+    m_componentSlots.insert(it, {typeId, slot});
+    MarkComponentType(typeId);
 }
 
-const glm::vec3 &GameObject::GetPosition() const
+const ComponentMask &GameObject::GetComponentMask() const
 {
-    return m_position;
+    return m_componentMask;
+}
+
+void GameObject::MarkComponentType(size_t typeId)
+{
+    if (typeId < MAX_MASKED_COMPONENT_TYPES)
+    {
+        m_componentMask.set(typeId);
+    }
+}
+
+Component *GameObject::FindComponent(size_t typeId) const
+{
+    if (typeId < MAX_MASKED_COMPONENT_TYPES && !m_componentMask.test(typeId))
+    {
+        return nullptr;
+    }
+
+    if (m_archetype)
+    {
+        const int column = m_archetype->FindColumn(typeId);
+        if (column >= 0)
+        {
+            return m_archetype->GetComponent(static_cast<size_t>(column), m_archetypeRow);
+        }
+    }
+
+    return FindHeapComponent(typeId);
+}
+
+ObjectHandle GameObject::GetHandle() const
+{
+    return m_handle;
+}
+
+Component *GameObject::FindHeapComponent(size_t typeId) const
+{
+    auto it = std::lower_bound(m_componentSlots.begin(), m_componentSlots.end(), typeId,
+                               [](const std::pair<size_t, uint32_t> &entry, size_t id) { return entry.first < id; });
+    if (it == m_componentSlots.end() || it->first != typeId)
+    {
+        return nullptr;
+    }
+    return m_components[it->second].get();
+}
+
+glm::vec3 GameObject::GetPosition() const
+{
+    ENG_CHECK_SYSTEM_READ(SystemAccess::GetTransformTypeId());
+    return m_transforms->GetPosition(m_transformIndex);
 }
 
 void GameObject::SetPosition(const glm::vec3 &pos)
 {
-    m_position = pos;
+    ENG_CHECK_SYSTEM_WRITE(SystemAccess::GetTransformTypeId());
+    InvalidateWorldTransform();
+    m_transforms->SetPosition(m_transformIndex, pos);
 }
 
-const glm::quat &GameObject::GetRotation() const
+glm::quat GameObject::GetRotation() const
 {
-    return m_rotation;
+    ENG_CHECK_SYSTEM_READ(SystemAccess::GetTransformTypeId());
+    return m_transforms->GetRotation(m_transformIndex);
 }
 
 void GameObject::SetRotation(const glm::quat &rot)
 {
-    m_rotation = rot;
+    ENG_CHECK_SYSTEM_WRITE(SystemAccess::GetTransformTypeId());
+    InvalidateWorldTransform();
+    m_transforms->SetRotation(m_transformIndex, rot);
 }
 
-const glm::vec3 &GameObject::GetScale() const
+glm::vec3 GameObject::GetScale() const
 {
-    return m_scale;
+    ENG_CHECK_SYSTEM_READ(SystemAccess::GetTransformTypeId());
+    return m_transforms->GetScale(m_transformIndex);
 }
 
 void GameObject::SetScale(const glm::vec3 &scale)
 {
-    m_scale = scale;
+    ENG_CHECK_SYSTEM_WRITE(SystemAccess::GetTransformTypeId());
+    InvalidateWorldTransform();
+    m_transforms->SetScale(m_transformIndex, scale);
 }
 
 glm::mat4 GameObject::GetLocalTransform() const
 {
-    glm::mat4 mat = glm::mat4(1.0f);
+    ENG_CHECK_SYSTEM_READ(SystemAccess::GetTransformTypeId());
+    return m_transforms->ComputeLocalTransform(m_transformIndex);
+}
 
-    // Translation
-    mat = glm::translate(mat, m_position);
+const glm::mat4 &GameObject::GetWorldTransform() const
+{
+    ENG_CHECK_SYSTEM_READ(SystemAccess::GetTransformTypeId());
+    return m_transforms->GetWorldTransform(m_transformIndex);
+}
 
-    // Rotation
-    mat = mat * glm::mat4_cast(m_rotation);
+void GameObject::SetLocalBounds(const BoundingBox &bounds)
+{
+    ENG_CHECK_STRUCTURAL_CHANGE("GameObject::SetLocalBounds");
+    m_localBounds = bounds;
+    if (m_scene)
+    {
+        m_scene->SyncSpatialProxy(this);
+    }
+}
 
-    // Scale
-    mat = glm::scale(mat, m_scale);
+const BoundingBox &GameObject::GetLocalBounds() const
+{
+    return m_localBounds;
+}
 
-    return mat;
+BoundingBox GameObject::GetWorldBounds() const
+{
+    return m_localBounds.Transform(GetWorldTransform());
 }
 
-glm::mat4 GameObject::GetWorldTransform() const
+void GameObject::SetInSpatialGrid(bool enabled)
 {
-    if (m_parent)
+    ENG_CHECK_STRUCTURAL_CHANGE("GameObject::SetInSpatialGrid");
+    m_inSpatialGrid = enabled;
+    if (!m_scene)
+    {
+        return;
+    }
+
+    if (enabled)
     {
-        return m_parent->GetWorldTransform() * GetLocalTransform();
+        m_scene->AddToSpatialGrid(this);
     }
     else
+    {
+        m_scene->RemoveFromSpatialGrid(this);
+    }
+}
+
+bool GameObject::IsInSpatialGrid() const
+{
+    return m_inSpatialGrid;
+}
+
+Scene *GameObject::GetScene() const
+{
+    return m_scene;
+}
+
+void GameObject::InvalidateWorldTransform()
+{
+    // A dirty object always has a dirty subtree, so there is nothing left to do below it
+    if (m_transforms->IsDirty(m_transformIndex))
+    {
+        return;
+    }
+
+    m_transforms->MarkDirty(m_transformIndex);
+    for (auto &child : m_children)
+    {
+        child->InvalidateWorldTransform();
+    }
+}
+
+void GameObject::MoveTransformTo(TransformStore &store)
+{
+    uint32_t index = store.Allocate(this);
+    store.SetPosition(index, GetPosition());
+    store.SetRotation(index, GetRotation());
+    store.SetScale(index, GetScale());
+
+    m_transforms->Release(m_transformIndex);
+    m_transforms = &store;
+    m_transformIndex = index;
+    m_ownedTransforms.reset();
+
+    for (auto &child : m_children)
+    {
+        if (child->m_transforms != &store)
+        {
+            child->MoveTransformTo(store);
+        }
+        store.SetParent(child->m_transformIndex, index);
+    }
+}
+
+const GameObject *GameObject::FindTopInterpolatedInHierarchy() const
+{
+    const GameObject *top = nullptr;
+    for (const GameObject *object = this; object; object = object->m_parent)
+    {
+        if (object->m_interpolate)
+        {
+            top = object;
+        }
+    }
+    return top;
+}
+
+void GameObject::SetInterpolationEnabled(bool enabled)
+{
+    m_interpolate = enabled;
+    ResetInterpolation();
+}
+
+bool GameObject::IsInterpolationEnabled() const
+{
+    return m_interpolate;
+}
+
+void GameObject::ResetInterpolation()
+{
+    m_previousPosition = GetPosition();
+    m_previousRotation = GetRotation();
+    m_previousScale = GetScale();
+}
+
+glm::mat4 GameObject::GetInterpolatedLocalTransform(float alpha) const
+{
+    if (!m_interpolate)
     {
         return GetLocalTransform();
     }
+
+    glm::mat4 mat = glm::mat4(1.0f);
+    mat = glm::translate(mat, glm::mix(m_previousPosition, GetPosition(), alpha));
+    mat = mat * glm::mat4_cast(glm::slerp(m_previousRotation, GetRotation(), alpha));
+    mat = glm::scale(mat, glm::mix(m_previousScale, GetScale(), alpha));
+
+    return mat;
+}
+
+glm::mat4 GameObject::GetInterpolatedWorldTransform(float alpha) const
+{
+    const GameObject *top = FindTopInterpolatedInHierarchy();
+    if (!top)
+    {
+        return GetWorldTransform();
+    }
+
+    // Nothing above the topmost interpolated object blends, so its parent's cached world transform is exact and
+    // only the local transforms from there down to this object are interpolated
+    glm::mat4 world = GetInterpolatedLocalTransform(alpha);
+    for (const GameObject *object = this; object != top;)
+    {
+        object = object->m_parent;
+        world = object->GetInterpolatedLocalTransform(alpha) * world;
+    }
+    return top->m_parent ? top->m_parent->GetWorldTransform() * world : world;
 }
 } // namespace eng
\ No newline at end of file
@@ -1,5 +1,9 @@
 #pragma once
-#include "scene/Component.h"
+#include "core/StringId.h"
+#include "scene/BoundingVolumeTree.h"
+#include "scene/ComponentStore.h"
+#include "scene/SpatialHashGrid.h"
+#include "scene/ObjectPool.h"
 #include <glm/gtc/quaternion.hpp>
 #include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
@@ -9,36 +13,98 @@
 
 namespace eng
 {
+class Scene;
+class TransformStore;
+
 /**
  * @class GameObject
  * @brief Base class for all entities in the game world.
+ *
+ * The local transform lives in the owning Scene's TransformStore; the accessors below forward into it.
+ * Components added with AddComponent<T>() live in the Scene's ComponentStore, grouped by archetype.
  */
 class GameObject
 {
   public:
     /**
-     * @brief Virtual destructor.
+     * @brief Virtual destructor. Releases the object's transform entry.
+     */
+    virtual ~GameObject();
+
+    /**
+     * @brief Allocates from the ObjectPool current on the calling thread, or from the global heap.
+     * @param size Number of bytes.
+     * @return The memory.
      */
-    virtual ~GameObject() = default;
+    static void *operator new(size_t size);
 
     /**
-     * @brief Updates the game object and its components.
+     * @brief Constructs in memory provided by the caller.
+     * @param place The memory.
+     * @return place.
+     */
+    static void *operator new(size_t, void *place) noexcept
+    {
+        return place;
+    }
+
+    /**
+     * @brief Returns memory to the pool it came from.
+     * @param memory The memory.
+     */
+    static void operator delete(void *memory);
+
+    /**
+     * @brief Matches the placement operator new; nothing to free.
+     */
+    static void operator delete(void *, void *) noexcept
+    {
+    }
+
+    /**
+     * @brief Updates the game object, its heap-allocated components and its children.
+     *
+     * Components stored in the scene's ComponentStore are updated by the scene's per-type systems instead.
      * @param deltaTime The time since the last frame in seconds.
      */
     virtual void Update(float deltaTime);
 
+    /**
+     * @brief Runs a fixed simulation step on the game object, its heap-allocated components and children.
+     * @param fixedDeltaTime The duration of one fixed step in seconds.
+     */
+    virtual void FixedUpdate(float fixedDeltaTime);
+
+    /**
+     * @brief Runs the late update on the game object, its heap-allocated components and children.
+     * @param deltaTime The time since the last frame in seconds.
+     */
+    virtual void LateUpdate(float deltaTime);
+
     /**
      * @brief Gets the name of the game object.
-     * @return The name string.
+     * @return The name string, owned by the global string table.
      */
     [[nodiscard]] const std::string &GetName() const;
 
     /**
-     * @brief Sets the name of the game object.
+     * @brief Gets the interned name of the game object.
+     * @return The name ID.
+     */
+    [[nodiscard]] StringId GetNameId() const;
+
+    /**
+     * @brief Sets the name of the game object and updates the scene's name index.
      * @param name The new name string.
      */
     void SetName(const std::string &name);
 
+    /**
+     * @brief Sets the name of the game object from an interned string and updates the scene's name index.
+     * @param name The new name ID.
+     */
+    void SetName(StringId name);
+
     /**
      * @brief Gets the parent game object.
      * @return Pointer to the parent GameObject, or nullptr if none.
@@ -52,41 +118,122 @@ class GameObject
     [[nodiscard]] bool IsAlive() const;
 
     /**
-     * @brief Marks the object for destruction at the end of the frame.
+     * @brief Marks the object for destruction.
+     *
+     * The object stops being updated right away and is queued in its scene, which destroys all queued objects
+     * (and their children) in one pass at the start of the next Scene::Update.
      */
     void MarkForDestroy();
 
     /**
-     * @brief Adds a component to the game object.
+     * @brief Adds a heap-allocated component to the game object, which takes ownership of it.
+     *
+     * Such components are updated like the others but are not visited by Scene::Each; prefer AddComponent<T>().
      * @param component Pointer to the component to add.
      */
     void AddComponent(Component *component);
 
     /**
-     * @brief Gets a component of a specific type.
+     * @brief Constructs a component in the scene's archetype storage.
+     *
+     * Falls back to a heap allocation if the object is not part of a scene yet, already stores a T there, or
+     * the scene's systems are running.
+     * The returned pointer is invalidated when a component is added to this object or to another object
+     * of the same archetype, or when such an object is destroyed.
+     * @tparam T The type of the component.
+     * @param args Arguments forwarded to the constructor of T.
+     * @return Pointer to the new component.
+     */
+    template <typename T, typename... Args, typename = typename std::enable_if_t<std::is_base_of_v<Component, T>>>
+    T *AddComponent(Args &&...args)
+    {
+        ENG_CHECK_STRUCTURAL_CHANGE("GameObject::AddComponent");
+        if (!m_componentStore || m_componentStore->IsIterating() ||
+            (m_archetype && m_archetype->FindColumn(Component::StaticTypeId<T>()) >= 0))
+        {
+            ObjectPool::Scope scope(m_objectPool);
+            T *component = new T(std::forward<Args>(args)...);
+            AddComponent(component);
+            return component;
+        }
+
+        void *memory = m_componentStore->Allocate(this, ComponentTypeInfo::Create<T>());
+        T *component = new (memory) T(std::forward<Args>(args)...);
+        component->m_owner = this;
+        MarkComponentType(Component::StaticTypeId<T>());
+        return component;
+    }
+
+    /**
+     * @brief Gets a component of a specific type without any virtual call.
+     *
+     * The type bitmask rejects missing types immediately; stored components are found through the archetype's
+     * type-to-column table and heap-allocated ones through a small sorted type-to-slot table.
      * @tparam T The type of the component.
      * @return Pointer to the component if found, nullptr otherwise.
      */
     template <typename T, typename = typename std::enable_if_t<std::is_base_of_v<Component, T>>> T *GetComponent()
     {
-        size_t typeId = Component::StaticTypeId<T>();
+        const size_t typeId = Component::StaticTypeId<T>();
+        ENG_CHECK_SYSTEM_READ(typeId);
 
-        for (auto &component : m_components)
+        if (typeId < MAX_MASKED_COMPONENT_TYPES && !m_componentMask.test(typeId))
         {
-            if (component->GetTypeId() == typeId)
+            return nullptr;
+        }
+
+        if (m_archetype)
+        {
+            const int column = m_archetype->FindColumn(typeId);
+            if (column >= 0)
             {
-                return static_cast<T *>(component.get());
+                return static_cast<T *>(m_archetype->GetData(static_cast<size_t>(column), m_archetypeRow));
             }
         }
 
-        return nullptr;
+        return static_cast<T *>(FindHeapComponent(typeId));
     }
 
+    /**
+     * @brief Checks if the object has a component of a specific type.
+     * @tparam T The type of the component.
+     * @return true if a component of type T is attached, false otherwise.
+     */
+    template <typename T, typename = typename std::enable_if_t<std::is_base_of_v<Component, T>>>
+    [[nodiscard]] bool HasComponent() const
+    {
+        const size_t typeId = Component::StaticTypeId<T>();
+        if (typeId < MAX_MASKED_COMPONENT_TYPES)
+        {
+            return m_componentMask.test(typeId);
+        }
+        return (m_archetype && m_archetype->FindColumn(typeId) >= 0) || FindHeapComponent(typeId);
+    }
+
+    /**
+     * @brief Finds a component by type ID, without knowing its static type.
+     * @param typeId The Component::StaticTypeId of the component.
+     * @return Pointer to the component if found, nullptr otherwise.
+     */
+    [[nodiscard]] Component *FindComponent(size_t typeId) const;
+
+    /**
+     * @brief Gets the handle of the object in its scene.
+     * @return The handle, or a null handle if the object is not in a scene.
+     */
+    [[nodiscard]] ObjectHandle GetHandle() const;
+
+    /**
+     * @brief Gets the bitmask of the component types attached to the object.
+     * @return The mask; types with an ID of MAX_MASKED_COMPONENT_TYPES or more are not included.
+     */
+    [[nodiscard]] const ComponentMask &GetComponentMask() const;
+
     /**
      * @brief Gets the local position of the object.
-     * @return Reference to the position vector.
+     * @return The position vector.
      */
-    [[nodiscard]] const glm::vec3 &GetPosition() const;
+    [[nodiscard]] glm::vec3 GetPosition() const;
 
     /**
      * @brief Sets the local position of the object.
@@ -96,9 +243,9 @@ class GameObject
 
     /**
      * @brief Gets the local rotation of the object.
-     * @return Reference to the rotation quaternion.
+     * @return The rotation quaternion.
      */
-    [[nodiscard]] const glm::quat &GetRotation() const;
+    [[nodiscard]] glm::quat GetRotation() const;
 
     /**
      * @brief Sets the local rotation of the object.
@@ -108,9 +255,9 @@ class GameObject
 
     /**
      * @brief Gets the local scale of the object.
-     * @return Reference to the scale vector.
+     * @return The scale vector.
      */
-    [[nodiscard]] const glm::vec3 &GetScale() const;
+    [[nodiscard]] glm::vec3 GetScale() const;
 
     /**
      * @brief Sets the local scale of the object.
@@ -125,24 +272,164 @@ class GameObject
     [[nodiscard]] glm::mat4 GetLocalTransform() const;
 
     /**
-     * @brief Calculates the world transformation matrix.
-     * @return The 4x4 world transform matrix.
+     * @brief Gets the world transformation matrix, recomputing it only if this object or an ancestor changed.
+     *
+     * The cache is filled lazily from this const getter, so the first access after a change must not race
+     * with other readers of the same subtree. Scene::UpdateWorldTransforms() refreshes all of them up front.
+     * @return Reference to the cached 4x4 world transform matrix, valid until the scene is modified.
+     */
+    [[nodiscard]] const glm::mat4 &GetWorldTransform() const;
+
+    /**
+     * @brief Enables blending between the transforms of the last two fixed steps when rendering.
+     *
+     * Use this for objects that are moved from FixedUpdate so they render smoothly at any frame rate.
+     * @param enabled true to interpolate, false to always render the current transform.
+     */
+    void SetInterpolationEnabled(bool enabled);
+
+    /**
+     * @brief Checks if transform interpolation is enabled.
+     * @return true if enabled, false otherwise.
+     */
+    [[nodiscard]] bool IsInterpolationEnabled() const;
+
+    /**
+     * @brief Snaps the interpolation start to the current transform (e.g. after a teleport).
+     */
+    void ResetInterpolation();
+
+    /**
+     * @brief Calculates the local transform blended between the previous and the current fixed step.
+     * @param alpha The blend factor, usually Engine::GetInterpolationAlpha().
+     * @return The 4x4 interpolated local transform matrix.
+     */
+    [[nodiscard]] glm::mat4 GetInterpolatedLocalTransform(float alpha) const;
+
+    /**
+     * @brief Calculates the world transform blended between the previous and the current fixed step.
+     * @param alpha The blend factor, usually Engine::GetInterpolationAlpha().
+     * @return The 4x4 interpolated world transform matrix.
+     */
+    [[nodiscard]] glm::mat4 GetInterpolatedWorldTransform(float alpha) const;
+
+    /**
+     * @brief Sets the bounds of the object in its local space and keeps it in the scene's spatial index.
+     *
+     * The index follows the object's world transform from then on, see Scene::UpdateWorldTransforms().
+     * @param bounds The local bounding box; an invalid box (the default) removes the object from the index.
+     */
+    void SetLocalBounds(const BoundingBox &bounds);
+
+    /**
+     * @brief Gets the bounds of the object in its local space.
+     * @return The box passed to SetLocalBounds(), invalid if none was set.
+     */
+    [[nodiscard]] const BoundingBox &GetLocalBounds() const;
+
+    /**
+     * @brief Gets the bounds of the object in world space.
+     * @return The local bounds transformed by the world transform, invalid if no bounds were set.
+     */
+    [[nodiscard]] BoundingBox GetWorldBounds() const;
+
+    /**
+     * @brief Adds the object to or removes it from the scene's spatial grid.
+     *
+     * The grid is keyed on the x and y of the world position and follows it from then on, see
+     * Scene::QueryGridRadius().
+     * @param enabled true to keep the object in the grid.
      */
-    [[nodiscard]] glm::mat4 GetWorldTransform() const;
+    void SetInSpatialGrid(bool enabled);
+
+    /**
+     * @brief Checks if the object is kept in the scene's spatial grid.
+     * @return true if SetInSpatialGrid(true) was called.
+     */
+    [[nodiscard]] bool IsInSpatialGrid() const;
+
+    /**
+     * @brief Gets the scene the object belongs to.
+     * @return The scene, or nullptr for an object created outside any scene and not attached yet.
+     */
+    [[nodiscard]] Scene *GetScene() const;
 
   protected:
-    GameObject() = default;
+    /**
+     * @brief Allocates the transform entry in the scene that is creating the object, or in a private
+     * store if the object is created outside Scene::CreateObject (it moves into the scene on SetParent).
+     * Only objects created by a scene store their components in its ComponentStore.
+     */
+    GameObject();
+
+  private:
+    /**
+     * @brief Records a component type in the type bitmask.
+     * @param typeId The component type ID.
+     */
+    void MarkComponentType(size_t typeId);
+
+    /**
+     * @brief Looks a heap-allocated component up in the sorted type-to-slot table.
+     * @param typeId The component type ID.
+     * @return The first component of that type that was added, or nullptr.
+     */
+    [[nodiscard]] Component *FindHeapComponent(size_t typeId) const;
+
+    /**
+     * @brief Marks the world transform of this object and of all its descendants as dirty.
+     */
+    void InvalidateWorldTransform();
+
+    /**
+     * @brief Moves the transform entries of this object and its subtree into another store.
+     * @param store The destination store.
+     */
+    void MoveTransformTo(TransformStore &store);
+
+    /**
+     * @brief Finds the object closest to the root among this object and its ancestors that interpolates its
+     * transform.
+     * @return The object, or nullptr if the cached world transform needs no interpolation.
+     */
+    [[nodiscard]] const GameObject *FindTopInterpolatedInHierarchy() const;
 
   private:
-    std::string m_name;                                       ///< The name of the object.
-    GameObject *m_parent = nullptr;                           ///< Pointer to the parent object.
-    std::vector<std::unique_ptr<GameObject>> m_children;      ///< List of child objects.
-    std::vector<std::unique_ptr<Component>> m_components;     ///< List of attached components.
-    bool m_isAlive = true;                                    ///< Lifespan state of the object.
-    glm::vec3 m_position = glm::vec3(0.0f);                   ///< Local position.
-    glm::quat m_rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f); ///< Local rotation.
-    glm::vec3 m_scale = glm::vec3(1.0f);                      ///< Local scale.
+    static constexpr uint32_t INVALID_SLOT = UINT32_MAX; ///< m_slot of an object not held by any container yet.
+
+    StringId m_name;                                           ///< The interned name of the object.
+    uint32_t m_nameSlot = 0;                                   ///< Index in the scene's name index bucket.
+    GameObject *m_parent = nullptr;                            ///< Pointer to the parent object.
+    uint32_t m_slot = INVALID_SLOT;                            ///< Index in the parent's children or the scene roots.
+    std::vector<std::unique_ptr<GameObject>> m_children;       ///< List of child objects.
+    std::vector<std::unique_ptr<Component>> m_components;      ///< Heap-allocated components.
+    std::vector<std::pair<size_t, uint32_t>> m_componentSlots; ///< (type ID, index in m_components), sorted.
+    ComponentMask m_componentMask;                             ///< Types of all attached components.
+    bool m_isAlive = true;                                     ///< Lifespan state of the object.
+    Scene *m_scene = nullptr;                                  ///< Scene the object belongs to, if any.
+    ObjectHandle m_handle;                                     ///< Slot of the object in the scene's slot map.
+    TransformStore *m_transforms = nullptr;                    ///< Store holding the transform.
+    uint32_t m_transformIndex = 0;                             ///< Index of the transform in m_transforms.
+    std::unique_ptr<TransformStore> m_ownedTransforms;         ///< Private store while outside any scene.
+    ComponentStore *m_componentStore = nullptr;                ///< Store of the creating scene, if any.
+    ObjectPool *m_objectPool = nullptr;                        ///< Pool of the creating scene, if any.
+    Archetype *m_archetype = nullptr;                          ///< Archetype holding the stored components.
+    uint32_t m_archetypeRow = 0;                               ///< Row of this object in m_archetype.
+
+    BoundingBox m_localBounds;                                   ///< Bounds in local space.
+    uint32_t m_spatialProxy = BoundingVolumeTree::INVALID_PROXY; ///< Proxy in the scene's spatial index, if any.
+    uint32_t m_gridProxy = SpatialHashGrid::INVALID_PROXY;       ///< Proxy in the scene's spatial grid, if any.
+    bool m_inSpatialGrid = false;                                ///< Whether the object belongs in the grid.
+
+    bool m_interpolate = false;                                       ///< Whether rendering interpolates the transform.
+    glm::vec3 m_previousPosition = glm::vec3(0.0f);                   ///< Local position at the previous fixed step.
+    glm::quat m_previousRotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f); ///< Local rotation at the previous fixed step.
+    glm::vec3 m_previousScale = glm::vec3(1.0f);                      ///< Local scale at the previous fixed step.
+
+    static thread_local Scene *s_constructionScene; ///< Scene currently creating an object.
 
+    friend class ComponentStore;
     friend class Scene;
+    friend class TransformStore;
 };
 } // namespace eng
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace eng
+{
+/**
+ * @struct ObjectHandle
+ * @brief Generational reference to a game object, resolved through Scene::Resolve().
+ *
+ * A handle names a slot of the scene's slot map and the generation the slot had when the object was created.
+ * Destroying the object bumps the generation, so old handles resolve to nullptr instead of dangling, even
+ * after the slot is reused. Handles are plain values: cheap to copy, store and compare.
+ */
+struct ObjectHandle
+{
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    uint32_t index = INVALID_INDEX; ///< Slot in the scene's slot map.
+    uint32_t generation = 0;        ///< Generation of the slot when the handle was made.
+
+    /**
+     * @brief Checks if the handle was never assigned. A non-null handle can still be stale.
+     * @return true for a default-constructed handle.
+     */
+    [[nodiscard]] bool IsNull() const
+    {
+        return index == INVALID_INDEX;
+    }
+
+    /**
+     * @brief Checks if two handles name the same slot and generation.
+     */
+    bool operator==(const ObjectHandle &other) const
+    {
+        return index == other.index && generation == other.generation;
+    }
+
+    /**
+     * @brief Negation of operator==.
+     */
+    bool operator!=(const ObjectHandle &other) const
+    {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @struct ComponentHandle
+ * @brief Reference to a component through its owner's handle and its type.
+ *
+ * Stored components move in memory whenever their archetype changes, so the handle does not keep an address;
+ * Scene::Resolve() finds the component again through the owner's type tables in constant time.
+ */
+struct ComponentHandle
+{
+    ObjectHandle owner; ///< Object the component is attached to.
+    size_t typeId = 0;  ///< Component::StaticTypeId of the component.
+
+    /**
+     * @brief Checks if the handle was never assigned.
+     * @return true for a default-constructed handle.
+     */
+    [[nodiscard]] bool IsNull() const
+    {
+        return owner.IsNull();
+    }
+
+    /**
+     * @brief Checks if two handles name the same owner and type.
+     */
+    bool operator==(const ComponentHandle &other) const
+    {
+        return owner == other.owner && typeId == other.typeId;
+    }
+
+    /**
+     * @brief Negation of operator==.
+     */
+    bool operator!=(const ComponentHandle &other) const
+    {
+        return !(*this == other);
+    }
+};
+} // namespace eng
\ No newline at end of file
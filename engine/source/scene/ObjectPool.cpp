@@ -0,0 +1,142 @@
+#include "scene/ObjectPool.h"
+#include <new>
+
+namespace eng
+{
+namespace
+{
+/**
+ * @struct BlockHeader
+ * @brief Stored in front of every allocation to find its pool when it is freed.
+ */
+struct alignas(ObjectPool::BLOCK_GRANULARITY) BlockHeader
+{
+    ObjectPool *pool = nullptr; ///< Owning pool, nullptr for the global heap.
+    uint32_t sizeClass = 0;     ///< Size class of the block inside the pool.
+};
+
+static_assert(sizeof(BlockHeader) == ObjectPool::BLOCK_GRANULARITY, "BlockHeader must keep blocks aligned");
+
+thread_local ObjectPool *s_currentPool = nullptr;
+} // namespace
+
+ObjectPool::Scope::Scope(ObjectPool *pool) : m_previous(s_currentPool)
+{
+    s_currentPool = pool;
+}
+
+ObjectPool::Scope::~Scope()
+{
+    s_currentPool = m_previous;
+}
+
+ObjectPool::~ObjectPool()
+{
+    for (std::byte *slab : m_slabs)
+    {
+        ::operator delete(slab);
+    }
+}
+
+void *ObjectPool::AllocateFromCurrent(size_t size)
+{
+    const size_t blockSize = sizeof(BlockHeader) + size;
+    BlockHeader *header = nullptr;
+
+    ObjectPool *pool = s_currentPool;
+    if (pool && blockSize <= MAX_BLOCK_SIZE)
+    {
+        const size_t sizeClass = (blockSize - 1) / BLOCK_GRANULARITY;
+        header = new (pool->AllocateBlock(sizeClass)) BlockHeader{pool, static_cast<uint32_t>(sizeClass)};
+    }
+    else
+    {
+        header = new (::operator new(blockSize)) BlockHeader{};
+    }
+
+    return header + 1;
+}
+
+void ObjectPool::Free(void *memory)
+{
+    if (!memory)
+    {
+        return;
+    }
+
+    BlockHeader *header = static_cast<BlockHeader *>(memory) - 1;
+    ObjectPool *pool = header->pool;
+    if (!pool)
+    {
+        ::operator delete(header);
+        return;
+    }
+
+    SizeClass &sizeClass = pool->m_sizeClasses[header->sizeClass];
+    auto *block = new (header) FreeBlock{sizeClass.freeList};
+    sizeClass.freeList = block;
+    --pool->m_stats.liveBlocks;
+}
+
+ObjectPool *ObjectPool::GetCurrent()
+{
+    return s_currentPool;
+}
+
+bool ObjectPool::Release()
+{
+    if (m_stats.liveBlocks > 0)
+    {
+        return false;
+    }
+
+    for (std::byte *slab : m_slabs)
+    {
+        ::operator delete(slab);
+    }
+    m_slabs.clear();
+    m_sizeClasses.clear();
+    m_stats.slabCount = 0;
+    return true;
+}
+
+ObjectPoolStats ObjectPool::GetStats() const
+{
+    return m_stats;
+}
+
+std::byte *ObjectPool::AllocateBlock(size_t sizeClass)
+{
+    if (sizeClass >= m_sizeClasses.size())
+    {
+        m_sizeClasses.resize(MAX_BLOCK_SIZE / BLOCK_GRANULARITY);
+    }
+
+    ++m_stats.allocations;
+    ++m_stats.liveBlocks;
+
+    SizeClass &blocks = m_sizeClasses[sizeClass];
+    if (blocks.freeList)
+    {
+        FreeBlock *block = blocks.freeList;
+        blocks.freeList = block->next;
+        return reinterpret_cast<std::byte *>(block);
+    }
+
+    const size_t blockSize = (sizeClass + 1) * BLOCK_GRANULARITY;
+    if (static_cast<size_t>(blocks.end - blocks.cursor) < blockSize)
+    {
+        // The tail of the previous slab, if any, is too small for a block and stays unused
+        auto *slab = static_cast<std::byte *>(::operator new(SLAB_SIZE));
+        m_slabs.push_back(slab);
+        ++m_stats.slabAllocations;
+        ++m_stats.slabCount;
+        blocks.cursor = slab;
+        blocks.end = slab + SLAB_SIZE;
+    }
+
+    std::byte *block = blocks.cursor;
+    blocks.cursor += blockSize;
+    return block;
+}
+} // namespace eng
\ No newline at end of file
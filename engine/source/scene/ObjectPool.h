@@ -0,0 +1,131 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace eng
+{
+/**
+ * @struct ObjectPoolStats
+ * @brief Allocation counters of an ObjectPool.
+ */
+struct ObjectPoolStats
+{
+    size_t allocations = 0;     ///< Blocks handed out since the pool was created.
+    size_t liveBlocks = 0;      ///< Blocks currently in use.
+    size_t slabAllocations = 0; ///< Slabs requested from the global allocator since the pool was created.
+    size_t slabCount = 0;       ///< Slabs currently held.
+};
+
+/**
+ * @class ObjectPool
+ * @brief Slab allocator for the game objects and heap-allocated components of one scene.
+ *
+ * Blocks are segregated into size classes of BLOCK_GRANULARITY bytes, so every class only ever holds objects
+ * of one or a few types. Each class carves its blocks out of SLAB_SIZE slabs and keeps freed blocks on an
+ * intrusive free list: once the slabs exist, allocating and freeing never call the global allocator.
+ *
+ * GameObject and Component allocate through the pool that is current on the calling thread (see Scope).
+ * Every block starts with a small header naming its pool, so deleting an object finds the right pool, or
+ * the global heap for objects allocated while no pool was current. Pooled objects must not outlive the
+ * pool. The pool is not thread-safe.
+ */
+class ObjectPool
+{
+  public:
+    static constexpr size_t SLAB_SIZE = 64 * 1024;
+    static constexpr size_t BLOCK_GRANULARITY = 16;
+    static constexpr size_t MAX_BLOCK_SIZE = 2048;
+
+    /**
+     * @class Scope
+     * @brief Makes a pool current on the calling thread for the lifetime of the object.
+     */
+    class Scope
+    {
+      public:
+        /**
+         * @brief Makes a pool current.
+         * @param pool The pool, or nullptr to allocate from the global heap.
+         */
+        explicit Scope(ObjectPool *pool);
+        ~Scope();
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+      private:
+        ObjectPool *m_previous = nullptr; ///< Pool that was current before.
+    };
+
+    ObjectPool() = default;
+    ~ObjectPool();
+
+    ObjectPool(const ObjectPool &) = delete;
+    ObjectPool &operator=(const ObjectPool &) = delete;
+
+    /**
+     * @brief Allocates memory from the current pool, or from the global heap if there is none.
+     * @param size Number of bytes.
+     * @return Memory aligned to BLOCK_GRANULARITY bytes.
+     */
+    static void *AllocateFromCurrent(size_t size);
+
+    /**
+     * @brief Frees memory returned by AllocateFromCurrent(), whichever pool it came from.
+     * @param memory The memory, or nullptr.
+     */
+    static void Free(void *memory);
+
+    /**
+     * @brief Gets the pool current on the calling thread.
+     * @return The pool, or nullptr.
+     */
+    static ObjectPool *GetCurrent();
+
+    /**
+     * @brief Frees every slab at once. Does nothing while blocks are still in use.
+     * @return true if the slabs were released.
+     */
+    bool Release();
+
+    /**
+     * @brief Gets the allocation counters.
+     * @return The counters.
+     */
+    [[nodiscard]] ObjectPoolStats GetStats() const;
+
+  private:
+    /**
+     * @struct FreeBlock
+     * @brief Link stored inside a free block.
+     */
+    struct FreeBlock
+    {
+        FreeBlock *next = nullptr; ///< Next free block of the same size class.
+    };
+
+    /**
+     * @struct SizeClass
+     * @brief Blocks of one size.
+     */
+    struct SizeClass
+    {
+        FreeBlock *freeList = nullptr; ///< Freed blocks, reused first.
+        std::byte *cursor = nullptr;   ///< Next never-used block in the current slab.
+        std::byte *end = nullptr;      ///< End of the current slab.
+    };
+
+    /**
+     * @brief Takes a block of a size class.
+     * @param sizeClass Index of the size class.
+     * @return The block.
+     */
+    std::byte *AllocateBlock(size_t sizeClass);
+
+  private:
+    std::vector<SizeClass> m_sizeClasses; ///< Size classes, created on first use.
+    std::vector<std::byte *> m_slabs;     ///< All slabs.
+    ObjectPoolStats m_stats;              ///< Allocation counters.
+};
+} // namespace eng
\ No newline at end of file
@@ -1,34 +1,226 @@
 #include "scene/Scene.h"
+#include "profiling/Profiler.h"
 
 #include <algorithm>
+#include <iostream>
 
 namespace eng
 {
+namespace
+{
+/**
+ * @brief Checks if an object is dead or below a dead ancestor.
+ */
+bool IsDestroyedWithHierarchy(GameObject *object)
+{
+    for (; object; object = object->GetParent())
+    {
+        if (!object->IsAlive())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace
+
 void Scene::Update(float deltaTime)
 {
-    for (auto it = m_objects.begin(); it != m_objects.end();)
+    ENG_PROFILE_SCOPE("Scene::Update");
+
+    DestroyPendingObjects();
+
+    ObjectPool::Scope scope(&m_objectPool);
+    m_isUpdating = true;
+
+    // Indices instead of iterators, so objects created during the update do not invalidate the loop
+    for (size_t i = 0; i < m_objects.size(); ++i)
     {
-        if ((*it)->IsAlive())
+        if (m_objects[i]->IsAlive())
         {
-            (*it)->Update(deltaTime);
-            ++it;
+            m_objects[i]->Update(deltaTime);
         }
-        else
+    }
+
+    DestroyMarkedBeforeSystems();
+
+    {
+        ENG_PROFILE_SCOPE("Scene::Update::Systems");
+        m_componentStore.RunUpdate(deltaTime, m_jobSystem);
+    }
+
+    m_isUpdating = false;
+    m_commands.Apply(*this);
+}
+
+void Scene::FixedUpdate(float fixedDeltaTime)
+{
+    ObjectPool::Scope scope(&m_objectPool);
+    m_isUpdating = true;
+
+    for (size_t i = 0; i < m_objects.size(); ++i)
+    {
+        if (m_objects[i]->IsAlive())
+        {
+            m_objects[i]->FixedUpdate(fixedDeltaTime);
+        }
+    }
+
+    DestroyMarkedBeforeSystems();
+    m_componentStore.RunFixedUpdate(fixedDeltaTime, m_jobSystem);
+
+    m_isUpdating = false;
+    m_commands.Apply(*this);
+}
+
+void Scene::LateUpdate(float deltaTime)
+{
+    UpdateWorldTransforms();
+
+    ObjectPool::Scope scope(&m_objectPool);
+    m_isUpdating = true;
+
+    for (size_t i = 0; i < m_objects.size(); ++i)
+    {
+        if (m_objects[i]->IsAlive())
+        {
+            m_objects[i]->LateUpdate(deltaTime);
+        }
+    }
+
+    DestroyMarkedBeforeSystems();
+    m_componentStore.RunLateUpdate(deltaTime, m_jobSystem);
+
+    m_isUpdating = false;
+    m_commands.Apply(*this);
+}
+
+void Scene::DestroyMarkedBeforeSystems()
+{
+    // Batch functions see component rows only, not their owners, so dead rows must be gone before they run
+    m_isUpdating = false;
+    DestroyPendingObjects();
+    m_isUpdating = true;
+}
+
+void Scene::UpdateWorldTransforms()
+{
+    ENG_PROFILE_SCOPE("Scene::UpdateWorldTransforms");
+
+    m_transforms.UpdateWorldTransforms();
+
+    if (m_spatialIndex.GetProxyCount() == 0 && m_spatialGrid.GetProxyCount() == 0)
+    {
+        return;
+    }
+
+    ENG_PROFILE_SCOPE("Scene::UpdateSpatialIndex");
+    m_transforms.CollectMoved(m_movedObjects);
+    for (GameObject *obj : m_movedObjects)
+    {
+        if (!obj)
+        {
+            continue;
+        }
+
+        const glm::mat4 &world = m_transforms.GetWorldTransform(obj->m_transformIndex);
+        if (obj->m_spatialProxy != BoundingVolumeTree::INVALID_PROXY)
+        {
+            // The displacement stretches the fat box ahead of objects that keep moving the same way
+            const BoundingBox box = obj->m_localBounds.Transform(world);
+            const glm::vec3 displacement = box.GetCenter() - m_spatialIndex.GetBox(obj->m_spatialProxy).GetCenter();
+            m_spatialIndex.MoveProxy(obj->m_spatialProxy, box, displacement);
+        }
+        if (obj->m_gridProxy != SpatialHashGrid::INVALID_PROXY)
         {
-            it = m_objects.erase(it);
+            m_spatialGrid.MoveProxy(obj->m_gridProxy, glm::vec2(world[3]));
         }
     }
+
+    // Objects that changed cells, joined or left the grid are re-sorted together here
+    m_spatialGrid.Flush();
 }
 
 void Scene::Clear()
 {
+    m_commands.Clear();
     m_objects.clear();
-    m_mainCamera = nullptr;
+    m_spatialIndex.Clear();
+    m_spatialGrid.Clear();
+    m_pendingDestroy.clear();
+    m_mainCamera = {};
+    m_objectPool.Release();
+}
+
+void Scene::DestroyObjects(const std::vector<GameObject *> &objects)
+{
+    ENG_CHECK_STRUCTURAL_CHANGE("Scene::DestroyObjects");
+    for (GameObject *object : objects)
+    {
+        object->MarkForDestroy();
+    }
+
+    DestroyPendingObjects();
+}
+
+void Scene::DestroyPendingObjects()
+{
+    if (m_pendingDestroy.empty() || m_isUpdating)
+    {
+        return;
+    }
+
+    ENG_PROFILE_SCOPE("Scene::DestroyPendingObjects");
+
+    auto &parents = m_destroyedParents;
+    parents.clear();
+    bool compactRoots = false;
+    for (GameObject *object : m_pendingDestroy)
+    {
+        if (object->m_parent)
+        {
+            parents.push_back(object->m_parent);
+        }
+        else
+        {
+            compactRoots = true;
+        }
+    }
+    m_pendingDestroy.clear();
+
+    std::sort(parents.begin(), parents.end());
+    parents.erase(std::unique(parents.begin(), parents.end()), parents.end());
+
+    // Decide everything before destroying anything: a parent that is itself doomed is freed together with
+    // its dead ancestor, so its children must not be compacted
+    parents.erase(std::remove_if(parents.begin(), parents.end(), IsDestroyedWithHierarchy), parents.end());
+
+    for (GameObject *parent : parents)
+    {
+        RemoveDeadObjects(parent->m_children);
+    }
+
+    if (compactRoots)
+    {
+        RemoveDeadObjects(m_objects);
+    }
 }
 
 GameObject *Scene::CreateObject(const std::string &name, GameObject *parent)
 {
-    auto obj = new GameObject();
+    return CreateObject(StringId(name), parent);
+}
+
+GameObject *Scene::CreateObject(StringId name, GameObject *parent)
+{
+    ENG_CHECK_STRUCTURAL_CHANGE("Scene::CreateObject");
+    GameObject::s_constructionScene = this;
+    GameObject *obj = nullptr;
+    {
+        ObjectPool::Scope scope(&m_objectPool);
+        obj = new GameObject();
+    }
+    GameObject::s_constructionScene = nullptr;
     obj->SetName(name);
     SetParent(obj, parent);
     return obj;
@@ -36,122 +228,461 @@ GameObject *Scene::CreateObject(const std::string &name, GameObject *parent)
 
 bool Scene::SetParent(GameObject *obj, GameObject *parent)
 {
-    bool result = false;
-    auto currentParent = obj->GetParent();
+    ENG_CHECK_STRUCTURAL_CHANGE("Scene::SetParent");
+    if (!IsInThisScene(obj, parent))
+    {
+        return false;
+    }
 
-    if (parent == nullptr)
+    const bool isNew = obj->m_parent == nullptr && obj->m_slot == GameObject::INVALID_SLOT;
+    if (!isNew && obj->m_parent == parent)
     {
-        if (currentParent != nullptr)
+        return parent != nullptr;
+    }
+
+    for (auto currentElement = parent; currentElement; currentElement = currentElement->GetParent())
+    {
+        if (currentElement == obj)
         {
-            auto it = std::find_if(currentParent->m_children.begin(), currentParent->m_children.end(),
-                                   [obj](const std::unique_ptr<GameObject> &el) { return el.get() == obj; });
+            return false;
+        }
+    }
 
-            if (it != currentParent->m_children.end())
-            {
-                m_objects.push_back(std::move(*it));
-                obj->m_parent = nullptr;
-                currentParent->m_children.erase(it);
-                result = true;
-            }
+    MoveToContainer(obj, parent);
+    AdoptObject(obj);
+    obj->InvalidateWorldTransform();
+    m_transforms.SetParent(obj->m_transformIndex, parent ? parent->m_transformIndex : TransformStore::INVALID_INDEX);
+    return true;
+}
+
+size_t Scene::SetParent(const std::vector<GameObject *> &objects, GameObject *parent)
+{
+    ENG_PROFILE_SCOPE("Scene::SetParent::Batch");
+    ENG_CHECK_STRUCTURAL_CHANGE("Scene::SetParent");
+    if (!IsInThisScene(nullptr, parent))
+    {
+        return 0;
+    }
+
+    std::vector<GameObject *> ancestors;
+    for (auto currentElement = parent; currentElement; currentElement = currentElement->GetParent())
+    {
+        ancestors.push_back(currentElement);
+    }
+    std::sort(ancestors.begin(), ancestors.end());
+
+    auto &container = GetContainer(parent);
+    container.reserve(container.size() + objects.size());
+
+    const uint32_t parentIndex = parent ? parent->m_transformIndex : TransformStore::INVALID_INDEX;
+    size_t count = 0;
+    for (GameObject *obj : objects)
+    {
+        const bool isNew = obj->m_parent == nullptr && obj->m_slot == GameObject::INVALID_SLOT;
+        if ((!isNew && obj->m_parent == parent) || std::binary_search(ancestors.begin(), ancestors.end(), obj) ||
+            !IsInThisScene(obj, nullptr))
+        {
+            continue;
         }
-        // No parent currently. This can be in 2 cases
-        // 1. The object is in the scene root
-        // 2. The object has been just created
-        else
+
+        MoveToContainer(obj, parent);
+        AdoptObject(obj);
+        obj->InvalidateWorldTransform();
+        m_transforms.SetParent(obj->m_transformIndex, parentIndex);
+        ++count;
+    }
+
+    return count;
+}
+
+void Scene::SetMainCamera(GameObject *camera)
+{
+    m_mainCamera = camera ? camera->GetHandle() : ObjectHandle{};
+}
+
+GameObject *Scene::GetMainCamera()
+{
+    return Resolve(m_mainCamera);
+}
+
+GameObject *Scene::FindByName(StringId name) const
+{
+    auto it = m_nameIndex.find(name);
+    if (it == m_nameIndex.end())
+    {
+        return nullptr;
+    }
+
+    for (GameObject *object : it->second)
+    {
+        if (object->IsAlive())
         {
-            auto it = std::find_if(m_objects.begin(), m_objects.end(),
-                                   [obj](const std::unique_ptr<GameObject> &el) { return el.get() == obj; });
+            return object;
+        }
+    }
+    return nullptr;
+}
 
-            if (it == m_objects.end())
+GameObject *Scene::FindByName(std::string_view name) const
+{
+    StringId id;
+    return StringId::Find(name, id) ? FindByName(id) : nullptr;
+}
+
+std::vector<GameObject *> Scene::FindAllByName(StringId name) const
+{
+    std::vector<GameObject *> objects;
+    auto it = m_nameIndex.find(name);
+    if (it != m_nameIndex.end())
+    {
+        objects.reserve(it->second.size());
+        for (GameObject *object : it->second)
+        {
+            if (object->IsAlive())
             {
-                std::unique_ptr<GameObject> objHolder(obj);
-                m_objects.push_back(std::move(objHolder));
-                result = true;
+                objects.push_back(object);
             }
         }
     }
-    // We are trying to add it as a child of another object
-    else
-    {
-        if (currentParent != nullptr)
+    return objects;
+}
+
+std::vector<GameObject *> Scene::FindAllByName(std::string_view name) const
+{
+    StringId id;
+    return StringId::Find(name, id) ? FindAllByName(id) : std::vector<GameObject *>();
+}
+
+void Scene::QueryBox(const BoundingBox &box, std::vector<GameObject *> &outObjects) const
+{
+    outObjects.clear();
+    m_spatialIndex.QueryBox(box, [this, &outObjects](BoundingVolumeTree::ProxyId proxy) {
+        auto *object = static_cast<GameObject *>(m_spatialIndex.GetUserData(proxy));
+        if (object->IsAlive())
         {
-            auto it = std::find_if(currentParent->m_children.begin(), currentParent->m_children.end(),
-                                   [obj](const std::unique_ptr<GameObject> &el) { return el.get() == obj; });
+            outObjects.push_back(object);
+        }
+        return true;
+    });
+}
 
-            if (it != currentParent->m_children.end())
-            {
-                bool found = false;
-                auto currentElement = parent;
-                while (currentElement)
-                {
-                    if (currentElement == obj)
-                    {
-                        found = true;
-                        break;
-                    }
-                    currentElement = currentElement->GetParent();
-                }
-
-                if (!found)
-                {
-                    parent->m_children.push_back(std::move(*it));
-                    obj->m_parent = parent;
-                    currentParent->m_children.erase(it);
-                    result = true;
-                }
-            }
+void Scene::QuerySphere(const BoundingSphere &sphere, std::vector<GameObject *> &outObjects) const
+{
+    outObjects.clear();
+    m_spatialIndex.QuerySphere(sphere, [this, &outObjects](BoundingVolumeTree::ProxyId proxy) {
+        auto *object = static_cast<GameObject *>(m_spatialIndex.GetUserData(proxy));
+        if (object->IsAlive())
+        {
+            outObjects.push_back(object);
         }
-        // No parent currently. This can be in 2 cases
-        // 1. The object is in the scene root
-        // 2. The object has been just created
-        else
+        return true;
+    });
+}
+
+void Scene::QueryFrustum(const Frustum &frustum, std::vector<GameObject *> &outObjects) const
+{
+    outObjects.clear();
+    m_spatialIndex.QueryFrustum(frustum, [this, &outObjects](BoundingVolumeTree::ProxyId proxy) {
+        auto *object = static_cast<GameObject *>(m_spatialIndex.GetUserData(proxy));
+        if (object->IsAlive())
         {
-            auto it = std::find_if(m_objects.begin(), m_objects.end(),
-                                   [obj](const std::unique_ptr<GameObject> &el) { return el.get() == obj; });
+            outObjects.push_back(object);
+        }
+        return true;
+    });
+}
 
-            // The object has been just created
-            if (it == m_objects.end())
-            {
-                std::unique_ptr<GameObject> objHolder(obj);
-                parent->m_children.push_back(std::move(objHolder));
-                obj->m_parent = parent;
-                result = true;
-            }
-            else
-            {
-                bool found = false;
-                auto currentElement = parent;
-                while (currentElement)
-                {
-                    if (currentElement == obj)
-                    {
-                        found = true;
-                        break;
-                    }
-                    currentElement = currentElement->GetParent();
-                }
-
-                if (!found)
-                {
-                    parent->m_children.push_back(std::move(*it));
-                    obj->m_parent = parent;
-                    m_objects.erase(it);
-                    result = true;
-                }
-            }
+GameObject *Scene::RayCast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance,
+                           float *outDistance) const
+{
+    GameObject *closest = nullptr;
+    float closestDistance = maxDistance;
+    m_spatialIndex.RayCast(origin, direction, maxDistance,
+                           [this, &closest, &closestDistance](BoundingVolumeTree::ProxyId proxy, float distance) {
+                               auto *object = static_cast<GameObject *>(m_spatialIndex.GetUserData(proxy));
+                               if (!object->IsAlive())
+                               {
+                                   return closestDistance;
+                               }
+
+                               // Shortening the ray skips every subtree behind this hit
+                               closest = object;
+                               closestDistance = distance;
+                               return distance;
+                           });
+
+    if (closest && outDistance)
+    {
+        *outDistance = closestDistance;
+    }
+    return closest;
+}
+
+void Scene::QueryNearest(const glm::vec3 &point, size_t count, std::vector<GameObject *> &outObjects) const
+{
+    outObjects.clear();
+    if (count == 0)
+    {
+        return;
+    }
+
+    // Dead objects are skipped inside the search, so they never take the place of a farther live one
+    m_spatialIndex.QueryNearest(point, [this, count, &outObjects](BoundingVolumeTree::ProxyId proxy) {
+        auto *object = static_cast<GameObject *>(m_spatialIndex.GetUserData(proxy));
+        if (object->IsAlive())
+        {
+            outObjects.push_back(object);
         }
+        return outObjects.size() < count;
+    });
+}
+
+BoundingVolumeTree &Scene::GetSpatialIndex()
+{
+    return m_spatialIndex;
+}
+
+SpatialHashGrid &Scene::GetSpatialGrid()
+{
+    return m_spatialGrid;
+}
+
+Component *Scene::Resolve(ComponentHandle handle) const
+{
+    GameObject *owner = Resolve(handle.owner);
+    return owner ? owner->FindComponent(handle.typeId) : nullptr;
+}
+
+bool Scene::SetParent(ObjectHandle obj, ObjectHandle parent)
+{
+    GameObject *object = Resolve(obj);
+    GameObject *parentObject = Resolve(parent);
+    if (!object || (!parent.IsNull() && !parentObject))
+    {
+        return false;
     }
+    return SetParent(object, parentObject);
+}
+
+TransformStore &Scene::GetTransformStore()
+{
+    return m_transforms;
+}
 
-    return result;
+ComponentStore &Scene::GetComponentStore()
+{
+    return m_componentStore;
 }
 
-void Scene::SetMainCamera(GameObject *camera)
+void Scene::SetJobSystem(JobSystem *jobSystem)
 {
-    m_mainCamera = camera;
+    m_jobSystem = jobSystem;
 }
 
-GameObject *Scene::GetMainCamera()
+JobSystem *Scene::GetJobSystem() const
+{
+    return m_jobSystem;
+}
+
+CommandBuffer &Scene::GetCommandBuffer()
+{
+    return m_commands;
+}
+
+ObjectPool &Scene::GetObjectPool()
+{
+    return m_objectPool;
+}
+
+void Scene::AdoptObject(GameObject *obj)
+{
+    // SetParent() only lets objects of this scene or of no scene through
+    if (obj->m_scene != this)
+    {
+        obj->m_scene = this;
+        obj->m_handle = AllocateHandle(obj);
+        AddToNameIndex(obj);
+    }
+    if (obj->m_transforms != &m_transforms)
+    {
+        obj->MoveTransformTo(m_transforms);
+    }
+    if (obj->m_spatialProxy == BoundingVolumeTree::INVALID_PROXY && obj->m_localBounds.IsValid())
+    {
+        SyncSpatialProxy(obj);
+    }
+    if (obj->m_inSpatialGrid)
+    {
+        AddToSpatialGrid(obj);
+    }
+}
+
+bool Scene::IsInThisScene(const GameObject *obj, const GameObject *parent) const
+{
+    // The object's memory, components, handle and indices all belong to its scene, so it cannot change scenes
+    if (obj && obj->m_scene && obj->m_scene != this)
+    {
+        std::cerr << "Error: Scene::SetParent: object " << obj->GetName() << " belongs to another scene"
+                  << std::endl;
+        return false;
+    }
+    if (parent && parent->m_scene != this)
+    {
+        std::cerr << "Error: Scene::SetParent: parent " << parent->GetName() << " belongs to another scene"
+                  << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void Scene::MoveToContainer(GameObject *obj, GameObject *parent)
+{
+    std::unique_ptr<GameObject> holder;
+    if (obj->m_slot == GameObject::INVALID_SLOT)
+    {
+        holder.reset(obj);
+    }
+    else
+    {
+        auto &container = GetContainer(obj->m_parent);
+        holder = std::move(container[obj->m_slot]);
+        if (obj->m_slot + 1 != container.size())
+        {
+            container[obj->m_slot] = std::move(container.back());
+            container[obj->m_slot]->m_slot = obj->m_slot;
+        }
+        container.pop_back();
+    }
+
+    auto &container = GetContainer(parent);
+    obj->m_parent = parent;
+    obj->m_slot = static_cast<uint32_t>(container.size());
+    container.push_back(std::move(holder));
+}
+
+std::vector<std::unique_ptr<GameObject>> &Scene::GetContainer(GameObject *parent)
+{
+    return parent ? parent->m_children : m_objects;
+}
+
+void Scene::RemoveDeadObjects(std::vector<std::unique_ptr<GameObject>> &container)
+{
+    uint32_t slot = 0;
+    for (auto &object : container)
+    {
+        if (object->IsAlive())
+        {
+            object->m_slot = slot;
+            container[slot++] = std::move(object);
+        }
+    }
+    container.resize(slot);
+}
+
+ObjectHandle Scene::AllocateHandle(GameObject *obj)
+{
+    uint32_t index = 0;
+    if (!m_freeSlots.empty())
+    {
+        index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    }
+
+    ObjectSlot &slot = m_slots[index];
+    slot.object = obj;
+    return {index, slot.generation};
+}
+
+void Scene::ReleaseHandle(ObjectHandle handle)
+{
+    ObjectSlot &slot = m_slots[handle.index];
+    slot.object = nullptr;
+    ++slot.generation;
+    m_freeSlots.push_back(handle.index);
+}
+
+void Scene::AddToNameIndex(GameObject *obj)
+{
+    if (obj->m_name.IsEmpty())
+    {
+        return;
+    }
+
+    auto &bucket = m_nameIndex[obj->m_name];
+    obj->m_nameSlot = static_cast<uint32_t>(bucket.size());
+    bucket.push_back(obj);
+}
+
+void Scene::RemoveFromNameIndex(GameObject *obj)
+{
+    if (obj->m_name.IsEmpty())
+    {
+        return;
+    }
+
+    // Buckets are kept when they empty out, so the next object with the name does not allocate again
+    auto &bucket = m_nameIndex.find(obj->m_name)->second;
+    if (obj->m_nameSlot + 1 != bucket.size())
+    {
+        bucket[obj->m_nameSlot] = bucket.back();
+        bucket[obj->m_nameSlot]->m_nameSlot = obj->m_nameSlot;
+    }
+    bucket.pop_back();
+}
+
+void Scene::SyncSpatialProxy(GameObject *obj)
+{
+    if (!obj->m_localBounds.IsValid())
+    {
+        RemoveFromSpatialIndex(obj);
+        return;
+    }
+
+    const BoundingBox box = obj->m_localBounds.Transform(m_transforms.GetWorldTransform(obj->m_transformIndex));
+    if (obj->m_spatialProxy == BoundingVolumeTree::INVALID_PROXY)
+    {
+        obj->m_spatialProxy = m_spatialIndex.CreateProxy(box, obj);
+    }
+    else
+    {
+        m_spatialIndex.MoveProxy(obj->m_spatialProxy, box);
+    }
+}
+
+void Scene::RemoveFromSpatialIndex(GameObject *obj)
+{
+    if (obj->m_spatialProxy != BoundingVolumeTree::INVALID_PROXY)
+    {
+        m_spatialIndex.DestroyProxy(obj->m_spatialProxy);
+        obj->m_spatialProxy = BoundingVolumeTree::INVALID_PROXY;
+    }
+}
+
+void Scene::AddToSpatialGrid(GameObject *obj)
+{
+    if (obj->m_gridProxy == SpatialHashGrid::INVALID_PROXY)
+    {
+        const glm::mat4 &world = m_transforms.GetWorldTransform(obj->m_transformIndex);
+        obj->m_gridProxy = m_spatialGrid.CreateProxy(glm::vec2(world[3]), obj);
+    }
+}
+
+void Scene::RemoveFromSpatialGrid(GameObject *obj)
+{
+    if (obj->m_gridProxy != SpatialHashGrid::INVALID_PROXY)
+    {
+        m_spatialGrid.DestroyProxy(obj->m_gridProxy);
+        obj->m_gridProxy = SpatialHashGrid::INVALID_PROXY;
+    }
+}
+
+void Scene::QueueDestroy(GameObject *obj)
 {
-    return m_mainCamera;
+    m_pendingDestroy.push_back(obj);
 }
 } // namespace eng
\ No newline at end of file
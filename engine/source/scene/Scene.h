@@ -1,29 +1,91 @@
 #pragma once
+#include "scene/BoundingVolumeTree.h"
+#include "scene/CommandBuffer.h"
+#include "scene/ComponentStore.h"
 #include "scene/GameObject.h"
+#include "scene/Handle.h"
+#include "scene/ObjectPool.h"
+#include "scene/SpatialHashGrid.h"
+#include "scene/TransformStore.h"
 #include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace eng
 {
+class JobSystem;
+
 /**
  * @class Scene
  * @brief Manages a collection of game objects and the active camera.
+ *
+ * Each update walks the objects serially, then runs the component systems, in parallel if a JobSystem is
+ * set (see ComponentStore). Structural changes requested from systems go through GetCommandBuffer() and are
+ * applied at the sync point after the systems of each update.
  */
 class Scene
 {
   public:
     /**
-     * @brief Updates all active game objects in the scene.
+     * @brief Updates all active game objects in the scene, then runs the component systems.
+     *
+     * Objects marked for destruction are removed first, by DestroyPendingObjects(), and again after the
+     * hierarchy walk, so the component systems never run on a dead object or one below a dead ancestor. The
+     * command buffer is applied last.
      * @param deltaTime The time since the last frame in seconds.
      */
     void Update(float deltaTime);
 
     /**
-     * @brief Clears all game objects from the scene.
+     * @brief Runs a fixed simulation step on all active game objects in the scene, then the component systems.
+     *
+     * Objects marked for destruction so far are removed before the systems run, as in Update().
+     * @param fixedDeltaTime The duration of one fixed step in seconds.
+     */
+    void FixedUpdate(float fixedDeltaTime);
+
+    /**
+     * @brief Runs the late update on all active game objects in the scene.
+     *
+     * World transforms changed during Update are refreshed in one top-down pass first; the component systems
+     * run last, after the objects marked for destruction so far are removed.
+     * @param deltaTime The time since the last frame in seconds.
+     */
+    void LateUpdate(float deltaTime);
+
+    /**
+     * @brief Recomputes all dirty world transforms in one linear pass over the TransformStore.
+     *
+     * Objects with bounds or in the spatial grid whose world transform changed since the last call are then
+     * moved in the spatial index and the grid, in one batch, so the spatial queries reflect the scene as of
+     * this call.
+     */
+    void UpdateWorldTransforms();
+
+    /**
+     * @brief Clears all game objects from the scene and releases the slabs of its ObjectPool.
      */
     void Clear();
 
+    /**
+     * @brief Destroys a set of objects, together with their children, in one pass.
+     *
+     * While the scene is updating the objects are only marked and destroyed at the start of the next Update.
+     * @param objects The objects to destroy; duplicates and objects below another listed object are allowed.
+     */
+    void DestroyObjects(const std::vector<GameObject *> &objects);
+
+    /**
+     * @brief Destroys every object marked with GameObject::MarkForDestroy().
+     *
+     * Each container that holds dead objects (the scene root or a parent's children) is compacted once,
+     * keeping the order of the survivors, so the cost is linear in the size of those containers however many
+     * objects die. Does nothing while the scene is updating.
+     */
+    void DestroyPendingObjects();
+
     /**
      * @brief Creates a new game object in the scene.
      * @param name The name of the new object.
@@ -32,6 +94,14 @@ class Scene
      */
     GameObject *CreateObject(const std::string &name, GameObject *parent = nullptr);
 
+    /**
+     * @brief Creates a new game object in the scene, named by an interned string.
+     * @param name The name of the new object.
+     * @param parent Pointer to the parent object, or nullptr if it's a root object.
+     * @return Pointer to the created GameObject.
+     */
+    GameObject *CreateObject(StringId name, GameObject *parent = nullptr);
+
     /**
      * @brief Creates a new game object of a specific type in the scene.
      * @tparam T The type of the game object.
@@ -42,7 +112,14 @@ class Scene
     template <typename T, typename = typename std::enable_if_t<std::is_base_of_v<GameObject, T>>>
     T *CreateObject(const std::string &name, GameObject *parent = nullptr)
     {
-        auto obj = new T();
+        ENG_CHECK_STRUCTURAL_CHANGE("Scene::CreateObject");
+        GameObject::s_constructionScene = this;
+        T *obj = nullptr;
+        {
+            ObjectPool::Scope scope(&m_objectPool);
+            obj = new T();
+        }
+        GameObject::s_constructionScene = nullptr;
         obj->SetName(name);
         SetParent(obj, parent);
         return obj;
@@ -50,12 +127,218 @@ class Scene
 
     /**
      * @brief Changes the parent of a game object.
+     *
+     * Constant time apart from the cycle check, which walks the ancestors of the new parent. The object that
+     * was last in the old container takes the freed place, so the order of the old siblings can change.
      * @param obj Pointer to the object to reparent.
      * @param parent Pointer to the new parent object.
-     * @return true if successful, false otherwise.
+     * @return true if successful, false if the change would create a cycle or the object or the parent belongs
+     * to another scene.
      */
     bool SetParent(GameObject *obj, GameObject *parent);
 
+    /**
+     * @brief Changes the parent of many game objects at once.
+     *
+     * The ancestors of the new parent are collected once and the destination container grows once, so
+     * attaching n objects costs O(n) instead of n times the single-object overhead.
+     * @param objects The objects to reparent; objects that would create a cycle or belong to another scene are
+     * skipped, and nothing is reparented if the parent belongs to another scene.
+     * @param parent Pointer to the new parent object, or nullptr for the scene root.
+     * @return The number of objects that were reparented.
+     */
+    size_t SetParent(const std::vector<GameObject *> &objects, GameObject *parent);
+
+    /**
+     * @brief Changes the parent of a game object referenced by handle.
+     * @param obj Handle of the object to reparent.
+     * @param parent Handle of the new parent, or a null handle for the scene root.
+     * @return false if a handle is stale or the change would create a cycle.
+     */
+    bool SetParent(ObjectHandle obj, ObjectHandle parent);
+
+    /**
+     * @brief Resolves an object handle in constant time.
+     * @param handle The handle.
+     * @return The object, or nullptr if the handle is null or stale, or the object is marked for destruction.
+     */
+    [[nodiscard]] GameObject *Resolve(ObjectHandle handle) const
+    {
+        if (handle.index >= m_slots.size())
+        {
+            return nullptr;
+        }
+
+        const ObjectSlot &slot = m_slots[handle.index];
+        if (slot.generation != handle.generation || !slot.object || !slot.object->IsAlive())
+        {
+            return nullptr;
+        }
+        return slot.object;
+    }
+
+    /**
+     * @brief Resolves a component handle in constant time, through the owner's type tables.
+     * @param handle The handle.
+     * @return The component, or nullptr if its owner cannot be resolved or no longer has the component.
+     */
+    [[nodiscard]] Component *Resolve(ComponentHandle handle) const;
+
+    /**
+     * @brief Resolves a component handle to a concrete type.
+     * @tparam T The type of the component.
+     * @param handle The handle.
+     * @return The component, or nullptr if the handle cannot be resolved or names another type.
+     */
+    template <typename T, typename = typename std::enable_if_t<std::is_base_of_v<Component, T>>>
+    [[nodiscard]] T *Resolve(ComponentHandle handle) const
+    {
+        if (handle.typeId != Component::StaticTypeId<T>())
+        {
+            return nullptr;
+        }
+        GameObject *owner = Resolve(handle.owner);
+        return owner ? owner->GetComponent<T>() : nullptr;
+    }
+
+    /**
+     * @brief Finds an object by name through the scene's hash index.
+     * @param name The name.
+     * @return One of the live objects with that name, or nullptr.
+     */
+    [[nodiscard]] GameObject *FindByName(StringId name) const;
+
+    /**
+     * @brief Finds an object by name; the name is looked up without being interned.
+     * @param name The name.
+     * @return One of the live objects with that name, or nullptr.
+     */
+    [[nodiscard]] GameObject *FindByName(std::string_view name) const;
+
+    /**
+     * @brief Finds all objects with a name through the scene's hash index.
+     * @param name The name.
+     * @return The live objects with that name, in no particular order.
+     */
+    [[nodiscard]] std::vector<GameObject *> FindAllByName(StringId name) const;
+
+    /**
+     * @brief Finds all objects with a name; the name is looked up without being interned.
+     * @param name The name.
+     * @return The live objects with that name, in no particular order.
+     */
+    [[nodiscard]] std::vector<GameObject *> FindAllByName(std::string_view name) const;
+
+    /**
+     * @brief Finds the objects whose world bounds overlap a box.
+     * @param box The box in world space.
+     * @param outObjects Cleared, then receives the live objects, in no particular order.
+     */
+    void QueryBox(const BoundingBox &box, std::vector<GameObject *> &outObjects) const;
+
+    /**
+     * @brief Finds the objects whose world bounds overlap a sphere.
+     * @param sphere The sphere in world space.
+     * @param outObjects Cleared, then receives the live objects, in no particular order.
+     */
+    void QuerySphere(const BoundingSphere &sphere, std::vector<GameObject *> &outObjects) const;
+
+    /**
+     * @brief Finds the objects whose world bounds are at least partly inside a frustum.
+     * @param frustum The frustum, e.g. Frustum::FromMatrix() of a camera's view projection matrix.
+     * @param outObjects Cleared, then receives the live objects, in no particular order.
+     */
+    void QueryFrustum(const Frustum &frustum, std::vector<GameObject *> &outObjects) const;
+
+    /**
+     * @brief Finds the first object whose world bounds a ray hits.
+     * @param origin Start of the ray.
+     * @param direction Direction of the ray; distances are in units of its length.
+     * @param maxDistance Length of the ray.
+     * @param outDistance Receives the distance at which the ray enters the object's bounds, if not nullptr.
+     * @return The closest live object hit, or nullptr.
+     */
+    GameObject *RayCast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance,
+                        float *outDistance = nullptr) const;
+
+    /**
+     * @brief Finds the objects whose world bounds are closest to a point.
+     * @param point The point in world space.
+     * @param count Maximum number of objects.
+     * @param outObjects Cleared, then receives up to count live objects, nearest first.
+     */
+    void QueryNearest(const glm::vec3 &point, size_t count, std::vector<GameObject *> &outObjects) const;
+
+    /**
+     * @brief Gets the spatial index of the objects that have bounds.
+     * @return Reference to the BoundingVolumeTree; its user data are the GameObject pointers.
+     */
+    BoundingVolumeTree &GetSpatialIndex();
+
+    /**
+     * @brief Calls callback(GameObject *) for every object in the spatial grid inside a rectangle.
+     *
+     * Nothing is allocated, so components can run proximity checks every update. Objects marked for
+     * destruction are skipped. The grid catches up with positions at the end of each transform update, so
+     * during Update() objects are found where the previous frame left them.
+     * @param min Lower corner of the rectangle in world x and y.
+     * @param max Upper corner of the rectangle in world x and y.
+     * @param callback Returns false to stop.
+     */
+    template <typename Callback>
+    void QueryGridRange(const glm::vec2 &min, const glm::vec2 &max, Callback &&callback) const
+    {
+        m_spatialGrid.QueryRange(min, max, [this, &callback](SpatialHashGrid::ProxyId proxy) {
+            auto *object = static_cast<GameObject *>(m_spatialGrid.GetUserData(proxy));
+            return !object->IsAlive() || callback(object);
+        });
+    }
+
+    /**
+     * @brief Calls callback(GameObject *) for every object in the spatial grid within a distance of a point.
+     *
+     * Nothing is allocated. Objects marked for destruction are skipped.
+     * @param center The point in world x and y.
+     * @param radius The distance.
+     * @param callback Returns false to stop.
+     */
+    template <typename Callback> void QueryGridRadius(const glm::vec2 &center, float radius, Callback &&callback) const
+    {
+        m_spatialGrid.QueryRadius(center, radius, [this, &callback](SpatialHashGrid::ProxyId proxy) {
+            auto *object = static_cast<GameObject *>(m_spatialGrid.GetUserData(proxy));
+            return !object->IsAlive() || callback(object);
+        });
+    }
+
+    /**
+     * @brief Calls callback(GameObject *) for every other object in the spatial grid within a distance of an
+     * object in the grid.
+     *
+     * Nothing is allocated. Objects marked for destruction are skipped.
+     * @param object The object.
+     * @param radius The distance.
+     * @param callback Returns false to stop.
+     */
+    template <typename Callback>
+    void QueryGridNeighbors(const GameObject *object, float radius, Callback &&callback) const
+    {
+        if (object->m_gridProxy == SpatialHashGrid::INVALID_PROXY)
+        {
+            return;
+        }
+
+        m_spatialGrid.QueryNeighbors(object->m_gridProxy, radius, [this, &callback](SpatialHashGrid::ProxyId proxy) {
+            auto *neighbor = static_cast<GameObject *>(m_spatialGrid.GetUserData(proxy));
+            return !neighbor->IsAlive() || callback(neighbor);
+        });
+    }
+
+    /**
+     * @brief Gets the spatial grid of the objects added with GameObject::SetInSpatialGrid().
+     * @return Reference to the SpatialHashGrid; its user data are the GameObject pointers.
+     */
+    SpatialHashGrid &GetSpatialGrid();
+
     /**
      * @brief Sets the main camera for the scene.
      * @param camera Pointer to the camera GameObject.
@@ -68,8 +351,192 @@ class Scene
      */
     GameObject *GetMainCamera();
 
+    /**
+     * @brief Gets the store holding the transforms of all objects in the scene.
+     * @return Reference to the TransformStore.
+     */
+    TransformStore &GetTransformStore();
+
+    /**
+     * @brief Gets the archetype storage of the components added with GameObject::AddComponent<T>().
+     * @return Reference to the ComponentStore.
+     */
+    ComponentStore &GetComponentStore();
+
+    /**
+     * @brief Sets the job system that runs the component systems in parallel.
+     * @param jobSystem The job system, or nullptr to run the systems serially.
+     */
+    void SetJobSystem(JobSystem *jobSystem);
+
+    /**
+     * @brief Gets the job system that runs the component systems.
+     * @return The job system, or nullptr.
+     */
+    [[nodiscard]] JobSystem *GetJobSystem() const;
+
+    /**
+     * @brief Gets the buffer of structural changes applied after the systems of each update.
+     *
+     * Systems that run in parallel must request every structural change through it.
+     * @return Reference to the CommandBuffer.
+     */
+    CommandBuffer &GetCommandBuffer();
+
+    /**
+     * @brief Gets the pool that allocates the scene's objects and heap-allocated components.
+     *
+     * The pool is current while the scene creates objects and runs its updates, so components created with
+     * new in that time are pooled too.
+     * @return Reference to the ObjectPool.
+     */
+    ObjectPool &GetObjectPool();
+
+    /**
+     * @brief Calls a function for every object whose stored components include all of the given types.
+     *
+     * Heap-allocated components (GameObject::AddComponent(Component *)) are not visited. The function must not
+     * add components or destroy objects.
+     * @tparam Ts The required component types.
+     * @param func Called as func(GameObject &, Ts &...).
+     */
+    template <typename... Ts, typename Func> void Each(Func &&func)
+    {
+        m_componentStore.Each<Ts...>(std::forward<Func>(func));
+    }
+
   private:
+    /**
+     * @brief Takes an object created outside CreateObject into this scene: gives it a handle here and moves its
+     * transform into this scene's store. Objects of other scenes are rejected earlier by SetParent().
+     * @param obj The object being added to the scene.
+     */
+    void AdoptObject(GameObject *obj);
+
+    /**
+     * @brief Gives an object a slot in the slot map, reusing free slots first.
+     * @param obj The object.
+     * @return The handle of the object.
+     */
+    ObjectHandle AllocateHandle(GameObject *obj);
+
+    /**
+     * @brief Frees the slot of a destroyed object and bumps its generation, so old handles go stale.
+     * @param handle The handle of the object.
+     */
+    void ReleaseHandle(ObjectHandle handle);
+
+    /**
+     * @brief Checks that an object and its new parent may be linked in this scene, reporting an error if not.
+     *
+     * Objects cannot move between scenes: their memory comes from their scene's pool and their components,
+     * handle and index entries live in that scene.
+     * @param obj The object, or nullptr to check only the parent.
+     * @param parent The new parent, or nullptr for the scene roots.
+     * @return false if the object or the parent belongs to another scene.
+     */
+    [[nodiscard]] bool IsInThisScene(const GameObject *obj, const GameObject *parent) const;
+
+    /**
+     * @brief Moves an object into the children of a parent or into the scene roots.
+     *
+     * The object is taken out of its current container by moving the last element into its slot. An object
+     * that is not in any container yet is taken into ownership.
+     * @param obj The object.
+     * @param parent The new parent, or nullptr for the scene roots.
+     */
+    void MoveToContainer(GameObject *obj, GameObject *parent);
+
+    /**
+     * @brief Gets the container holding the children of an object, or the scene roots.
+     * @param parent The parent, or nullptr.
+     * @return The container.
+     */
+    std::vector<std::unique_ptr<GameObject>> &GetContainer(GameObject *parent);
+
+    /**
+     * @brief Destroys the dead objects of one container, keeping the order of the others.
+     * @param container The container.
+     */
+    static void RemoveDeadObjects(std::vector<std::unique_ptr<GameObject>> &container);
+
+    /**
+     * @brief Adds an object to the bucket of its name. Unnamed objects are not indexed.
+     * @param obj The object.
+     */
+    void AddToNameIndex(GameObject *obj);
+
+    /**
+     * @brief Removes an object from the bucket of its name, moving the last entry of the bucket into its place.
+     * @param obj The object.
+     */
+    void RemoveFromNameIndex(GameObject *obj);
+
+    /**
+     * @brief Adds, moves or removes the spatial index proxy of an object to match its current bounds.
+     * @param obj The object.
+     */
+    void SyncSpatialProxy(GameObject *obj);
+
+    /**
+     * @brief Removes an object from the spatial index if it is in it.
+     * @param obj The object.
+     */
+    void RemoveFromSpatialIndex(GameObject *obj);
+
+    /**
+     * @brief Adds an object to the spatial grid at its world position if it is not in it yet.
+     * @param obj The object.
+     */
+    void AddToSpatialGrid(GameObject *obj);
+
+    /**
+     * @brief Removes an object from the spatial grid if it is in it.
+     * @param obj The object.
+     */
+    void RemoveFromSpatialGrid(GameObject *obj);
+
+    /**
+     * @brief Destroys the objects marked during the hierarchy walk of an update, before its component systems run.
+     */
+    void DestroyMarkedBeforeSystems();
+
+    /**
+     * @brief Queues an object that was just marked for destruction.
+     * @param obj The object.
+     */
+    void QueueDestroy(GameObject *obj);
+
+  private:
+    /**
+     * @struct ObjectSlot
+     * @brief Entry of the slot map behind ObjectHandle.
+     */
+    struct ObjectSlot
+    {
+        GameObject *object = nullptr; ///< The object, nullptr while the slot is free.
+        uint32_t generation = 1;      ///< Incremented every time the slot is freed.
+    };
+
+    using NameIndex = std::unordered_map<StringId, std::vector<GameObject *>>;
+
+    ObjectPool m_objectPool;                            ///< Memory of objects and components; outlives all.
+    TransformStore m_transforms;                        ///< Transforms of all objects; outlives m_objects.
+    ComponentStore m_componentStore{&m_transforms};     ///< Archetype component storage; outlives m_objects.
+    std::vector<ObjectSlot> m_slots;                    ///< Slot map of all objects; outlives m_objects.
+    std::vector<uint32_t> m_freeSlots;                  ///< Free entries of m_slots.
+    NameIndex m_nameIndex;                              ///< Objects per name; outlives m_objects.
+    BoundingVolumeTree m_spatialIndex;                  ///< Objects with bounds; outlives m_objects.
+    SpatialHashGrid m_spatialGrid;                      ///< Objects in the grid; outlives m_objects.
     std::vector<std::unique_ptr<GameObject>> m_objects; ///< Root game objects in the scene.
-    GameObject *m_mainCamera = nullptr;                 ///< Pointer to the active camera.
+    ObjectHandle m_mainCamera;                          ///< Handle of the active camera.
+    std::vector<GameObject *> m_pendingDestroy;         ///< Objects marked for destruction.
+    std::vector<GameObject *> m_destroyedParents;       ///< Scratch list of DestroyPendingObjects().
+    std::vector<GameObject *> m_movedObjects;           ///< Scratch list of UpdateWorldTransforms().
+    CommandBuffer m_commands;                           ///< Structural changes recorded by systems.
+    JobSystem *m_jobSystem = nullptr;                   ///< Runs the component systems, if set.
+    bool m_isUpdating = false;                          ///< Whether Update, FixedUpdate or LateUpdate is running.
+
+    friend class GameObject;
 };
 } // namespace eng
\ No newline at end of file
@@ -0,0 +1,217 @@
+#include "scene/SpatialHashGrid.h"
+#include <algorithm>
+
+namespace eng
+{
+SpatialHashGrid::SpatialHashGrid(float cellSize) : m_cellSize(cellSize), m_inverseCellSize(1.0f / cellSize)
+{
+    ResizeBuckets(0);
+}
+
+SpatialHashGrid::ProxyId SpatialHashGrid::CreateProxy(const glm::vec2 &position, void *userData)
+{
+    ProxyId proxy = m_freeList;
+    if (proxy == INVALID_PROXY)
+    {
+        proxy = static_cast<ProxyId>(m_proxies.size());
+        m_proxies.emplace_back();
+    }
+    else
+    {
+        m_freeList = m_proxies[proxy].slot;
+    }
+
+    Proxy &record = m_proxies[proxy];
+    record.x = position.x;
+    record.y = position.y;
+    record.cellX = ToCell(position.x);
+    record.cellY = ToCell(position.y);
+    record.userData = userData;
+    record.slot = INVALID_PROXY;
+    record.isUsed = true;
+
+    ++m_proxyCount;
+    m_needsFlush = true;
+    return proxy;
+}
+
+void SpatialHashGrid::DestroyProxy(ProxyId proxy)
+{
+    Proxy &record = m_proxies[proxy];
+    if (record.slot != INVALID_PROXY)
+    {
+        m_entries[record.slot].proxy = INVALID_PROXY;
+    }
+
+    record = Proxy();
+    record.slot = m_freeList;
+    m_freeList = proxy;
+
+    --m_proxyCount;
+    m_needsFlush = true;
+}
+
+bool SpatialHashGrid::MoveProxy(ProxyId proxy, const glm::vec2 &position)
+{
+    Proxy &record = m_proxies[proxy];
+    record.x = position.x;
+    record.y = position.y;
+
+    const int32_t cellX = ToCell(position.x);
+    const int32_t cellY = ToCell(position.y);
+    const bool changedCell = cellX != record.cellX || cellY != record.cellY;
+    record.cellX = cellX;
+    record.cellY = cellY;
+
+    // Once a flush is pending it rewrites every entry, so there is no point in touching them before
+    if (changedCell)
+    {
+        m_needsFlush = true;
+    }
+    else if (!m_needsFlush && record.slot != INVALID_PROXY)
+    {
+        Entry &entry = m_entries[record.slot];
+        entry.x = position.x;
+        entry.y = position.y;
+    }
+    return changedCell;
+}
+
+void SpatialHashGrid::Flush()
+{
+    if (!m_needsFlush)
+    {
+        return;
+    }
+
+    ResizeBuckets(m_proxyCount);
+
+    // Counting sort by bucket: count, turn the counts into starts, then place every proxy after the
+    // ones before it in its bucket
+    const size_t bucketCount = m_bucketStarts.size() - 1;
+    std::fill(m_bucketStarts.begin(), m_bucketStarts.end(), 0);
+    m_proxyBuckets.resize(m_proxies.size());
+    for (size_t i = 0; i < m_proxies.size(); ++i)
+    {
+        const Proxy &record = m_proxies[i];
+        if (record.isUsed)
+        {
+            const uint32_t bucket = GetBucket(record.cellX, record.cellY);
+            m_proxyBuckets[i] = bucket;
+            ++m_bucketStarts[bucket + 1];
+        }
+    }
+    for (size_t bucket = 1; bucket <= bucketCount; ++bucket)
+    {
+        m_bucketStarts[bucket] += m_bucketStarts[bucket - 1];
+    }
+
+    m_sortScratch.resize(m_proxyCount);
+    for (size_t i = 0; i < m_proxies.size(); ++i)
+    {
+        Proxy &record = m_proxies[i];
+        if (!record.isUsed)
+        {
+            continue;
+        }
+
+        // The starts are advanced while placing, so afterwards each holds the start of the next bucket
+        const uint32_t slot = m_bucketStarts[m_proxyBuckets[i]]++;
+        Entry &entry = m_sortScratch[slot];
+        entry.x = record.x;
+        entry.y = record.y;
+        entry.cellX = record.cellX;
+        entry.cellY = record.cellY;
+        entry.proxy = static_cast<ProxyId>(i);
+        record.slot = slot;
+    }
+    for (size_t bucket = bucketCount; bucket > 0; --bucket)
+    {
+        m_bucketStarts[bucket] = m_bucketStarts[bucket - 1];
+    }
+    m_bucketStarts[0] = 0;
+
+    m_entries.swap(m_sortScratch);
+    m_needsFlush = false;
+}
+
+glm::vec2 SpatialHashGrid::GetPosition(ProxyId proxy) const
+{
+    const Proxy &record = m_proxies[proxy];
+    return glm::vec2(record.x, record.y);
+}
+
+void *SpatialHashGrid::GetUserData(ProxyId proxy) const
+{
+    return m_proxies[proxy].userData;
+}
+
+size_t SpatialHashGrid::GetProxyCount() const
+{
+    return m_proxyCount;
+}
+
+void SpatialHashGrid::SetCellSize(float cellSize)
+{
+    m_cellSize = cellSize;
+    m_inverseCellSize = 1.0f / cellSize;
+    for (Proxy &record : m_proxies)
+    {
+        if (record.isUsed)
+        {
+            record.cellX = ToCell(record.x);
+            record.cellY = ToCell(record.y);
+        }
+    }
+
+    m_needsFlush = true;
+    Flush();
+}
+
+float SpatialHashGrid::GetCellSize() const
+{
+    return m_cellSize;
+}
+
+void SpatialHashGrid::Clear()
+{
+    m_entries.clear();
+    m_proxies.clear();
+    m_freeList = INVALID_PROXY;
+    m_proxyCount = 0;
+    m_needsFlush = false;
+}
+
+void SpatialHashGrid::ResizeBuckets(size_t proxyCount)
+{
+    // About one bucket per proxy, and never fewer than a 64 x 64 table, so wrapped cells rarely share buckets.
+    // The table only grows, so a proxy count hovering around a power of two does not resize it every flush.
+    constexpr uint32_t MIN_BITS = 12;
+    uint32_t bits = MIN_BITS;
+    while ((size_t{1} << bits) < proxyCount && bits < 30)
+    {
+        ++bits;
+    }
+
+    if (m_bucketStarts.size() >= (size_t{1} << bits) + 1)
+    {
+        return;
+    }
+
+    m_columnBits = (bits + 1) / 2;
+    m_columnMask = (1u << m_columnBits) - 1;
+    m_rowMask = (1u << (bits - m_columnBits)) - 1;
+    m_bucketStarts.assign((size_t{1} << bits) + 1, 0);
+
+    // Entries were sorted for the old table; a flush sorts them for this one
+    m_entries.clear();
+    for (Proxy &record : m_proxies)
+    {
+        if (record.isUsed)
+        {
+            record.slot = INVALID_PROXY;
+        }
+    }
+    m_needsFlush = m_proxyCount > 0;
+}
+} // namespace eng
\ No newline at end of file
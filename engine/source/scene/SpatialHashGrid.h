@@ -0,0 +1,276 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <glm/vec2.hpp>
+#include <vector>
+
+namespace eng
+{
+/**
+ * @class SpatialHashGrid
+ * @brief Uniform grid of square cells over the xy plane for many small moving points.
+ *
+ * The grid is unbounded: cell coordinates wrap onto a power of two table of buckets, so cells next to each
+ * other in x map to neighboring buckets and a query over a few cells reads a few short runs of memory.
+ * All entries (position, cell and proxy) live in one array sorted by bucket.
+ *
+ * Changes are batched. A proxy moving within its cell is rewritten in place. Proxies that change cells,
+ * new proxies and removed ones are applied together by Flush(), one counting sort pass over all proxies,
+ * which for scenes full of moving entities is far cheaper than taking each proxy out and putting it back
+ * and leaves every bucket contiguous. Until then queries may see proxies at their previous positions.
+ *
+ * Queries are const and may run on several threads at once, but not while the grid is modified. They do
+ * not allocate. Query callbacks return false to stop a query early.
+ */
+class SpatialHashGrid
+{
+  public:
+    using ProxyId = uint32_t;
+
+    static constexpr ProxyId INVALID_PROXY = UINT32_MAX;
+    static constexpr float DEFAULT_CELL_SIZE = 1.0f;
+
+    /**
+     * @brief Constructor.
+     * @param cellSize Side length of the cells; about twice the typical query radius works well.
+     */
+    explicit SpatialHashGrid(float cellSize = DEFAULT_CELL_SIZE);
+
+    /**
+     * @brief Adds a proxy. It is found by queries after the next Flush().
+     * @param position Position of the proxy.
+     * @param userData Value returned by GetUserData(), e.g. the object the proxy stands for.
+     * @return The ID of the proxy, stable until it is destroyed.
+     */
+    ProxyId CreateProxy(const glm::vec2 &position, void *userData);
+
+    /**
+     * @brief Removes a proxy. Queries stop reporting it immediately.
+     * @param proxy The proxy.
+     */
+    void DestroyProxy(ProxyId proxy);
+
+    /**
+     * @brief Updates the position of a proxy.
+     * @param proxy The proxy.
+     * @param position The new position.
+     * @return true if the proxy changed cells and waits for Flush(), false if it was updated in place.
+     */
+    bool MoveProxy(ProxyId proxy, const glm::vec2 &position);
+
+    /**
+     * @brief Applies the pending cell changes, additions and removals in one pass.
+     */
+    void Flush();
+
+    /**
+     * @brief Gets the position of a proxy.
+     * @param proxy The proxy.
+     * @return The position last passed to CreateProxy() or MoveProxy().
+     */
+    [[nodiscard]] glm::vec2 GetPosition(ProxyId proxy) const;
+
+    /**
+     * @brief Gets the user data of a proxy.
+     * @param proxy The proxy.
+     * @return The value passed to CreateProxy().
+     */
+    [[nodiscard]] void *GetUserData(ProxyId proxy) const;
+
+    /**
+     * @brief Gets the number of proxies.
+     * @return The proxy count.
+     */
+    [[nodiscard]] size_t GetProxyCount() const;
+
+    /**
+     * @brief Changes the cell size and redistributes all proxies.
+     * @param cellSize Side length of the cells.
+     */
+    void SetCellSize(float cellSize);
+
+    /**
+     * @brief Gets the side length of the cells.
+     * @return The cell size.
+     */
+    [[nodiscard]] float GetCellSize() const;
+
+    /**
+     * @brief Removes all proxies.
+     */
+    void Clear();
+
+    /**
+     * @brief Calls callback(ProxyId) for every proxy inside an axis-aligned rectangle.
+     * @param min Lower corner of the rectangle.
+     * @param max Upper corner of the rectangle.
+     * @param callback Returns false to stop.
+     */
+    template <typename Callback> void QueryRange(const glm::vec2 &min, const glm::vec2 &max, Callback &&callback) const
+    {
+        auto test = [&min, &max](const Entry &entry) {
+            return entry.x >= min.x && entry.x <= max.x && entry.y >= min.y && entry.y <= max.y;
+        };
+        VisitCells(min, max, test, callback);
+    }
+
+    /**
+     * @brief Calls callback(ProxyId) for every proxy within a distance of a point.
+     * @param center The point.
+     * @param radius The distance.
+     * @param callback Returns false to stop.
+     */
+    template <typename Callback> void QueryRadius(const glm::vec2 &center, float radius, Callback &&callback) const
+    {
+        const float radiusSquared = radius * radius;
+        auto test = [&center, radiusSquared](const Entry &entry) {
+            const float dx = entry.x - center.x;
+            const float dy = entry.y - center.y;
+            return dx * dx + dy * dy <= radiusSquared;
+        };
+        VisitCells(center - glm::vec2(radius), center + glm::vec2(radius), test, callback);
+    }
+
+    /**
+     * @brief Calls callback(ProxyId) for every other proxy within a distance of a proxy.
+     * @param proxy The proxy.
+     * @param radius The distance.
+     * @param callback Returns false to stop.
+     */
+    template <typename Callback> void QueryNeighbors(ProxyId proxy, float radius, Callback &&callback) const
+    {
+        QueryRadius(GetPosition(proxy), radius,
+                    [proxy, &callback](ProxyId other) { return other == proxy || callback(other); });
+    }
+
+  private:
+    /**
+     * @struct Entry
+     * @brief A proxy as stored in the sorted entry array.
+     */
+    struct Entry
+    {
+        float x = 0.0f;                ///< Position, x component.
+        float y = 0.0f;                ///< Position, y component.
+        int32_t cellX = 0;             ///< Cell column.
+        int32_t cellY = 0;             ///< Cell row.
+        ProxyId proxy = INVALID_PROXY; ///< The proxy, INVALID_PROXY once it is destroyed.
+    };
+
+    /**
+     * @struct Proxy
+     * @brief Current state of a proxy, which the entry array catches up with in Flush().
+     */
+    struct Proxy
+    {
+        float x = 0.0f;                ///< Position, x component.
+        float y = 0.0f;                ///< Position, y component.
+        int32_t cellX = 0;             ///< Cell column.
+        int32_t cellY = 0;             ///< Cell row.
+        void *userData = nullptr;      ///< User data.
+        uint32_t slot = INVALID_PROXY; ///< Index in m_entries, INVALID_PROXY if not flushed in yet.
+        bool isUsed = false;           ///< Whether the proxy exists; unused proxies keep the next free one in slot.
+    };
+
+    /**
+     * @brief Reports the proxies that pass a test in the cells overlapping a rectangle.
+     *
+     * Cells that wrap onto the same bucket are told apart by their coordinates, so no proxy is reported
+     * twice. A rectangle covering more cells than there are buckets scans every entry once instead.
+     * @param min Lower corner of the rectangle.
+     * @param max Upper corner of the rectangle.
+     * @param test Called with the entries of the cells.
+     * @param callback Called with the proxies that pass; returns false to stop.
+     */
+    template <typename Test, typename Callback>
+    void VisitCells(const glm::vec2 &min, const glm::vec2 &max, Test &test, Callback &callback) const
+    {
+        if (m_entries.empty() || !(min.x <= max.x && min.y <= max.y))
+        {
+            return;
+        }
+
+        const int32_t minX = ToCell(min.x);
+        const int32_t minY = ToCell(min.y);
+        const int32_t maxX = ToCell(max.x);
+        const int32_t maxY = ToCell(max.y);
+        const double cellCount = (static_cast<double>(maxX) - minX + 1) * (static_cast<double>(maxY) - minY + 1);
+
+        if (cellCount > static_cast<double>(m_bucketStarts.size() - 1))
+        {
+            for (const Entry &entry : m_entries)
+            {
+                if (entry.proxy != INVALID_PROXY && test(entry) && !callback(entry.proxy))
+                {
+                    return;
+                }
+            }
+            return;
+        }
+
+        for (int32_t cellY = minY; cellY <= maxY; ++cellY)
+        {
+            for (int32_t cellX = minX; cellX <= maxX; ++cellX)
+            {
+                const uint32_t bucket = GetBucket(cellX, cellY);
+                const uint32_t end = m_bucketStarts[bucket + 1];
+                for (uint32_t i = m_bucketStarts[bucket]; i < end; ++i)
+                {
+                    const Entry &entry = m_entries[i];
+                    if (entry.cellX == cellX && entry.cellY == cellY && entry.proxy != INVALID_PROXY &&
+                        test(entry) && !callback(entry.proxy))
+                    {
+                        return;
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Gets the cell coordinate of a position coordinate.
+     * @param value The position coordinate.
+     * @return The cell coordinate, clamped to the int32_t range; NaN maps to the lowest cell.
+     */
+    [[nodiscard]] int32_t ToCell(float value) const
+    {
+        constexpr float LIMIT = 2147483520.0f; // Largest float below 2^31
+        const float cell = std::floor(value * m_inverseCellSize);
+        return static_cast<int32_t>(!(cell >= -LIMIT) ? -LIMIT : (cell > LIMIT ? LIMIT : cell));
+    }
+
+    /**
+     * @brief Gets the bucket of a cell: the cell coordinates wrapped onto the bucket table's rows and columns.
+     * @param cellX Cell column.
+     * @param cellY Cell row.
+     * @return The bucket index.
+     */
+    [[nodiscard]] uint32_t GetBucket(int32_t cellX, int32_t cellY) const
+    {
+        return (static_cast<uint32_t>(cellX) & m_columnMask) |
+               ((static_cast<uint32_t>(cellY) & m_rowMask) << m_columnBits);
+    }
+
+    /**
+     * @brief Sizes the bucket table for a number of proxies.
+     * @param proxyCount The number of proxies.
+     */
+    void ResizeBuckets(size_t proxyCount);
+
+  private:
+    std::vector<Entry> m_entries;         ///< Entries sorted by bucket.
+    std::vector<uint32_t> m_bucketStarts; ///< First entry of every bucket, plus the entry count at the end.
+    std::vector<Proxy> m_proxies;         ///< Proxies by ID.
+    std::vector<Entry> m_sortScratch;     ///< Second entry array for Flush().
+    std::vector<uint32_t> m_proxyBuckets; ///< Bucket per proxy during Flush().
+    uint32_t m_columnBits = 0;            ///< Number of bits of the wrapped cell column.
+    uint32_t m_columnMask = 0;            ///< Mask of the wrapped cell column.
+    uint32_t m_rowMask = 0;               ///< Mask of the wrapped cell row.
+    uint32_t m_freeList = INVALID_PROXY;  ///< First unused proxy.
+    size_t m_proxyCount = 0;              ///< Number of proxies in use.
+    float m_cellSize = DEFAULT_CELL_SIZE; ///< Side length of the cells.
+    float m_inverseCellSize = 1.0f;       ///< One over m_cellSize.
+    bool m_needsFlush = false;            ///< Whether m_entries is behind m_proxies.
+};
+} // namespace eng
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "scene/SystemAccess.h"
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <utility>
+
+namespace eng
+{
+namespace
+{
+thread_local const SystemAccess *t_currentAccess = nullptr; ///< Access of the system running on this thread.
+std::atomic<size_t> s_violationCount = 0;                   ///< Violations found so far.
+std::mutex s_reportMutex;                                   ///< Guards s_reported and the output.
+std::set<std::pair<size_t, size_t>> s_reported;             ///< (system type, accessed type) pairs printed.
+
+/**
+ * @brief Counts a violation and prints it the first time it is seen for the system and type.
+ */
+void ReportViolation(const SystemAccess &access, size_t typeId, const char *what)
+{
+    s_violationCount.fetch_add(1, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(s_reportMutex);
+    if (s_reported.emplace(access.typeId, typeId).second)
+    {
+        std::cerr << "Error: the system of component type " << access.typeId << " " << what
+                  << " without declaring it" << std::endl;
+    }
+}
+} // namespace
+
+bool SystemAccess::CanRead(size_t id) const
+{
+    return !declared || std::binary_search(reads.begin(), reads.end(), id) || CanWrite(id);
+}
+
+bool SystemAccess::CanWrite(size_t id) const
+{
+    return !declared || std::binary_search(writes.begin(), writes.end(), id);
+}
+
+bool SystemAccess::ConflictsWith(const SystemAccess &other) const
+{
+    if (!declared || !other.declared)
+    {
+        return true;
+    }
+
+    for (size_t id : writes)
+    {
+        if (other.CanRead(id))
+        {
+            return true;
+        }
+    }
+    for (size_t id : other.writes)
+    {
+        if (std::binary_search(reads.begin(), reads.end(), id))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SystemAccess::Normalize()
+{
+    std::sort(writes.begin(), writes.end());
+    writes.erase(std::unique(writes.begin(), writes.end()), writes.end());
+
+    std::sort(reads.begin(), reads.end());
+    reads.erase(std::unique(reads.begin(), reads.end()), reads.end());
+    reads.erase(std::remove_if(reads.begin(), reads.end(),
+                               [this](size_t id) { return std::binary_search(writes.begin(), writes.end(), id); }),
+                reads.end());
+}
+
+SystemAccessChecker::Scope::Scope(const SystemAccess *access) : m_previous(t_currentAccess)
+{
+    t_currentAccess = access;
+}
+
+SystemAccessChecker::Scope::~Scope()
+{
+    t_currentAccess = m_previous;
+}
+
+void SystemAccessChecker::CheckRead(size_t typeId)
+{
+    const SystemAccess *access = t_currentAccess;
+    if (access && !access->CanRead(typeId))
+    {
+        ReportViolation(*access, typeId, ("read type " + std::to_string(typeId)).c_str());
+    }
+}
+
+void SystemAccessChecker::CheckWrite(size_t typeId)
+{
+    const SystemAccess *access = t_currentAccess;
+    if (access && !access->CanWrite(typeId))
+    {
+        ReportViolation(*access, typeId, ("wrote type " + std::to_string(typeId)).c_str());
+    }
+}
+
+void SystemAccessChecker::CheckStructuralChange(const char *operation)
+{
+    // Systems without a declaration run alone on the updating thread, where structural changes stay allowed
+    const SystemAccess *access = t_currentAccess;
+    if (access && access->declared)
+    {
+        ReportViolation(*access, 0, (std::string("made a structural change (") + operation + ")").c_str());
+    }
+}
+
+size_t SystemAccessChecker::GetViolationCount()
+{
+    return s_violationCount.load(std::memory_order_relaxed);
+}
+} // namespace eng
\ No newline at end of file
@@ -0,0 +1,215 @@
+#pragma once
+#include "scene/Component.h"
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#ifndef ENG_SYSTEM_ACCESS_CHECKS
+#define ENG_SYSTEM_ACCESS_CHECKS 0
+#endif
+
+namespace eng
+{
+/**
+ * @struct TransformData
+ * @brief Pseudo component type that stands for the object transforms in access declarations.
+ *
+ * Declare it as read by systems that call GetPosition(), GetWorldTransform() and friends, and as written by
+ * systems that call SetPosition(), SetRotation() or SetScale().
+ */
+struct TransformData
+{
+};
+
+/**
+ * @struct ComponentList
+ * @brief Compile-time list of component types, used to declare what a system reads or writes.
+ */
+template <typename... Ts> struct ComponentList
+{
+    /**
+     * @brief Appends the type IDs of the listed types.
+     * @param typeIds The list to append to.
+     */
+    static void AppendTypeIds(std::vector<size_t> &typeIds)
+    {
+        (typeIds.push_back(Component::StaticTypeId<Ts>()), ...);
+    }
+};
+
+/**
+ * @brief Detects a using Reads = ComponentList<...> declared by T.
+ */
+template <typename T, typename = void> struct HasReadsDeclaration : std::false_type
+{
+};
+
+template <typename T> struct HasReadsDeclaration<T, std::void_t<typename T::Reads>> : std::true_type
+{
+};
+
+/**
+ * @brief Detects a using Writes = ComponentList<...> declared by T.
+ */
+template <typename T, typename = void> struct HasWritesDeclaration : std::false_type
+{
+};
+
+template <typename T> struct HasWritesDeclaration<T, std::void_t<typename T::Writes>> : std::true_type
+{
+};
+
+/**
+ * @struct SystemAccess
+ * @brief The component types the system of a component type reads and writes.
+ *
+ * A component class declares its access with member aliases, for example
+ * using Reads = ComponentList<TransformData>; using Writes = ComponentList<Velocity>;
+ * Its own type always counts as written. A system with a declaration promises to touch nothing else, and only
+ * the components of the objects in the batches it is given, so the scene can run it concurrently with the
+ * systems it does not conflict with and split it into one job per chunk. A system without a declaration is
+ * assumed to touch anything and always runs alone.
+ */
+struct SystemAccess
+{
+    size_t typeId = 0;          ///< Component type of the system.
+    std::vector<size_t> reads;  ///< Sorted type IDs that are only read.
+    std::vector<size_t> writes; ///< Sorted type IDs that are written, including typeId.
+    bool declared = false;      ///< Whether the type declared Reads or Writes.
+
+    /**
+     * @brief Gets the access of the system of a component type, built once.
+     * @tparam T The component class type.
+     * @return The access description, valid for the lifetime of the process.
+     */
+    template <typename T> static const SystemAccess &Of()
+    {
+        static const SystemAccess access = Create<T>();
+        return access;
+    }
+
+    /**
+     * @brief Gets the type ID standing for the object transforms.
+     * @return Component::StaticTypeId<TransformData>().
+     */
+    static size_t GetTransformTypeId()
+    {
+        return Component::StaticTypeId<TransformData>();
+    }
+
+    /**
+     * @brief Checks if a type may be read, which includes writable types.
+     * @param id The type ID.
+     * @return true if declared as read or written, or if nothing was declared.
+     */
+    [[nodiscard]] bool CanRead(size_t id) const;
+
+    /**
+     * @brief Checks if a type may be written.
+     * @param id The type ID.
+     * @return true if declared as written, or if nothing was declared.
+     */
+    [[nodiscard]] bool CanWrite(size_t id) const;
+
+    /**
+     * @brief Checks if two systems must not run at the same time: one writes what the other reads or writes.
+     * @param other The other system.
+     * @return true if they conflict; always true if either has no declaration.
+     */
+    [[nodiscard]] bool ConflictsWith(const SystemAccess &other) const;
+
+  private:
+    template <typename T> static SystemAccess Create()
+    {
+        SystemAccess access;
+        access.typeId = Component::StaticTypeId<T>();
+        access.writes.push_back(access.typeId);
+
+        if constexpr (HasReadsDeclaration<T>::value)
+        {
+            T::Reads::AppendTypeIds(access.reads);
+            access.declared = true;
+        }
+        if constexpr (HasWritesDeclaration<T>::value)
+        {
+            T::Writes::AppendTypeIds(access.writes);
+            access.declared = true;
+        }
+
+        access.Normalize();
+        return access;
+    }
+
+    /**
+     * @brief Sorts both lists, removes duplicates and drops reads that are also writes.
+     */
+    void Normalize();
+};
+
+/**
+ * @class SystemAccessChecker
+ * @brief Debug check that systems only touch what they declared, enabled with ENG_SYSTEM_ACCESS_CHECKS.
+ *
+ * While a system runs, its access is current on the running thread. Component lookups, transform accessors
+ * and structural changes (creating, destroying or reparenting objects, adding components, renaming) report
+ * every access the current system did not declare to std::cerr, once per system and type.
+ */
+class SystemAccessChecker
+{
+  public:
+    /**
+     * @class Scope
+     * @brief Makes a system's access current on the calling thread for the lifetime of the object.
+     */
+    class Scope
+    {
+      public:
+        /**
+         * @brief Makes an access current.
+         * @param access The access of the running system.
+         */
+        explicit Scope(const SystemAccess *access);
+        ~Scope();
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+      private:
+        const SystemAccess *m_previous = nullptr; ///< Access that was current before.
+    };
+
+    /**
+     * @brief Reports a read of a type the current system did not declare.
+     * @param typeId The type ID.
+     */
+    static void CheckRead(size_t typeId);
+
+    /**
+     * @brief Reports a write of a type the current system did not declare.
+     * @param typeId The type ID.
+     */
+    static void CheckWrite(size_t typeId);
+
+    /**
+     * @brief Reports a structural change made from a system with a declaration.
+     * @param operation Name of the operation, for the message.
+     */
+    static void CheckStructuralChange(const char *operation);
+
+    /**
+     * @brief Gets the number of violations found so far, including the ones not printed again.
+     * @return The violation count.
+     */
+    static size_t GetViolationCount();
+};
+} // namespace eng
+
+#if ENG_SYSTEM_ACCESS_CHECKS
+#define ENG_CHECK_SYSTEM_READ(typeId) ::eng::SystemAccessChecker::CheckRead(typeId)
+#define ENG_CHECK_SYSTEM_WRITE(typeId) ::eng::SystemAccessChecker::CheckWrite(typeId)
+#define ENG_CHECK_STRUCTURAL_CHANGE(operation) ::eng::SystemAccessChecker::CheckStructuralChange(operation)
+#else
+#define ENG_CHECK_SYSTEM_READ(typeId) ((void)0)
+#define ENG_CHECK_SYSTEM_WRITE(typeId) ((void)0)
+#define ENG_CHECK_STRUCTURAL_CHANGE(operation) ((void)0)
+#endif
\ No newline at end of file
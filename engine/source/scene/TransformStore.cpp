@@ -0,0 +1,536 @@
+#include "scene/TransformStore.h"
+#include "scene/GameObject.h"
+#include <algorithm>
+#include <cstring>
+#include <glm/gtc/type_ptr.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENG_TRANSFORM_SSE 1
+#include <xmmintrin.h>
+#else
+#define ENG_TRANSFORM_SSE 0
+#endif
+
+namespace eng
+{
+namespace
+{
+/**
+ * @brief out = a * b for column-major 4x4 matrices; out may alias b.
+ */
+inline void MultiplyMatrices(const float *a, const float *b, float *out)
+{
+#if ENG_TRANSFORM_SSE
+    const __m128 a0 = _mm_loadu_ps(a);
+    const __m128 a1 = _mm_loadu_ps(a + 4);
+    const __m128 a2 = _mm_loadu_ps(a + 8);
+    const __m128 a3 = _mm_loadu_ps(a + 12);
+
+    __m128 columns[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        const float *column = b + i * 4;
+        __m128 result = _mm_mul_ps(a0, _mm_set1_ps(column[0]));
+        result = _mm_add_ps(result, _mm_mul_ps(a1, _mm_set1_ps(column[1])));
+        result = _mm_add_ps(result, _mm_mul_ps(a2, _mm_set1_ps(column[2])));
+        result = _mm_add_ps(result, _mm_mul_ps(a3, _mm_set1_ps(column[3])));
+        columns[i] = result;
+    }
+
+    for (int i = 0; i < 4; ++i)
+    {
+        _mm_storeu_ps(out + i * 4, columns[i]);
+    }
+#else
+    float result[16];
+    for (int column = 0; column < 4; ++column)
+    {
+        for (int row = 0; row < 4; ++row)
+        {
+            result[column * 4 + row] = a[row] * b[column * 4] + a[4 + row] * b[column * 4 + 1] +
+                                       a[8 + row] * b[column * 4 + 2] + a[12 + row] * b[column * 4 + 3];
+        }
+    }
+    std::memcpy(out, result, sizeof(result));
+#endif
+}
+
+template <typename T> void Permute(std::vector<T> &values, const std::vector<uint32_t> &order, std::vector<T> &scratch)
+{
+    // Swapping keeps both buffers, so the next permutation of the same type reuses the old one
+    scratch.clear();
+    for (uint32_t index : order)
+    {
+        scratch.push_back(values[index]);
+    }
+    values.swap(scratch);
+}
+} // namespace
+
+uint32_t TransformStore::Allocate(GameObject *owner)
+{
+    // A reused entry is a root, which is in hierarchy order wherever it sits
+    if (!m_freeIndices.empty())
+    {
+        const uint32_t index = m_freeIndices.back();
+        m_freeIndices.pop_back();
+
+        m_positionX[index] = 0.0f;
+        m_positionY[index] = 0.0f;
+        m_positionZ[index] = 0.0f;
+        m_rotationX[index] = 0.0f;
+        m_rotationY[index] = 0.0f;
+        m_rotationZ[index] = 0.0f;
+        m_rotationW[index] = 1.0f;
+        m_scaleX[index] = 1.0f;
+        m_scaleY[index] = 1.0f;
+        m_scaleZ[index] = 1.0f;
+        m_parents[index] = INVALID_INDEX;
+        m_owners[index] = owner;
+        m_alive[index] = 1;
+        m_worldMatrices[index] = glm::mat4(1.0f);
+        MarkDirty(index);
+        return index;
+    }
+
+    const auto index = static_cast<uint32_t>(m_parents.size());
+
+    m_positionX.push_back(0.0f);
+    m_positionY.push_back(0.0f);
+    m_positionZ.push_back(0.0f);
+    m_rotationX.push_back(0.0f);
+    m_rotationY.push_back(0.0f);
+    m_rotationZ.push_back(0.0f);
+    m_rotationW.push_back(1.0f);
+    m_scaleX.push_back(1.0f);
+    m_scaleY.push_back(1.0f);
+    m_scaleZ.push_back(1.0f);
+    m_parents.push_back(INVALID_INDEX);
+    m_owners.push_back(owner);
+    m_alive.push_back(1);
+    m_dirty.push_back(1);
+    m_moved.push_back(1);
+    m_worldMatrices.emplace_back(1.0f);
+    m_anyDirty = true;
+    m_anyMoved = true;
+
+    return index;
+}
+
+void TransformStore::Release(uint32_t index)
+{
+    m_owners[index] = nullptr;
+    m_alive[index] = 0;
+    m_dirty[index] = 0;
+    m_moved[index] = 0;
+    m_parents[index] = INVALID_INDEX;
+
+    // Released entries are skipped by every pass until Allocate() reuses them; only when they make up a large
+    // part of the store is it worth compacting them away with a full sort
+    m_freeIndices.push_back(index);
+    if (m_freeIndices.size() * COMPACT_DIVISOR > m_parents.size())
+    {
+        m_orderDirty = true;
+    }
+}
+
+void TransformStore::SetParent(uint32_t index, uint32_t parentIndex)
+{
+    m_parents[index] = parentIndex;
+    if (parentIndex != INVALID_INDEX && parentIndex > index)
+    {
+        m_orderDirty = true;
+    }
+    MarkDirty(index);
+}
+
+uint32_t TransformStore::GetParent(uint32_t index) const
+{
+    return m_parents[index];
+}
+
+glm::vec3 TransformStore::GetPosition(uint32_t index) const
+{
+    return glm::vec3(m_positionX[index], m_positionY[index], m_positionZ[index]);
+}
+
+void TransformStore::SetPosition(uint32_t index, const glm::vec3 &position)
+{
+    m_positionX[index] = position.x;
+    m_positionY[index] = position.y;
+    m_positionZ[index] = position.z;
+    MarkDirty(index);
+}
+
+glm::quat TransformStore::GetRotation(uint32_t index) const
+{
+    return glm::quat(m_rotationW[index], m_rotationX[index], m_rotationY[index], m_rotationZ[index]);
+}
+
+void TransformStore::SetRotation(uint32_t index, const glm::quat &rotation)
+{
+    m_rotationX[index] = rotation.x;
+    m_rotationY[index] = rotation.y;
+    m_rotationZ[index] = rotation.z;
+    m_rotationW[index] = rotation.w;
+    MarkDirty(index);
+}
+
+glm::vec3 TransformStore::GetScale(uint32_t index) const
+{
+    return glm::vec3(m_scaleX[index], m_scaleY[index], m_scaleZ[index]);
+}
+
+void TransformStore::SetScale(uint32_t index, const glm::vec3 &scale)
+{
+    m_scaleX[index] = scale.x;
+    m_scaleY[index] = scale.y;
+    m_scaleZ[index] = scale.z;
+    MarkDirty(index);
+}
+
+glm::mat4 TransformStore::ComputeLocalTransform(uint32_t index) const
+{
+    const float x = m_rotationX[index];
+    const float y = m_rotationY[index];
+    const float z = m_rotationZ[index];
+    const float w = m_rotationW[index];
+    const float sx = m_scaleX[index];
+    const float sy = m_scaleY[index];
+    const float sz = m_scaleZ[index];
+
+    // Same result as translate * mat4_cast * scale, without the two full matrix products
+    glm::mat4 mat(1.0f);
+    mat[0] = glm::vec4((1.0f - 2.0f * (y * y + z * z)) * sx, 2.0f * (x * y + w * z) * sx, 2.0f * (x * z - w * y) * sx,
+                       0.0f);
+    mat[1] = glm::vec4(2.0f * (x * y - w * z) * sy, (1.0f - 2.0f * (x * x + z * z)) * sy, 2.0f * (y * z + w * x) * sy,
+                       0.0f);
+    mat[2] = glm::vec4(2.0f * (x * z + w * y) * sz, 2.0f * (y * z - w * x) * sz, (1.0f - 2.0f * (x * x + y * y)) * sz,
+                       0.0f);
+    mat[3] = glm::vec4(m_positionX[index], m_positionY[index], m_positionZ[index], 1.0f);
+    return mat;
+}
+
+const glm::mat4 &TransformStore::GetWorldTransform(uint32_t index) const
+{
+    if (m_dirty[index])
+    {
+        glm::mat4 local = ComputeLocalTransform(index);
+        const uint32_t parent = m_parents[index];
+        if (parent != INVALID_INDEX)
+        {
+            MultiplyMatrices(glm::value_ptr(GetWorldTransform(parent)), glm::value_ptr(local),
+                             glm::value_ptr(m_worldMatrices[index]));
+        }
+        else
+        {
+            m_worldMatrices[index] = local;
+        }
+        m_dirty[index] = 0;
+    }
+
+    return m_worldMatrices[index];
+}
+
+void TransformStore::MarkDirty(uint32_t index)
+{
+    m_dirty[index] = 1;
+    m_moved[index] = 1;
+    m_anyDirty = true;
+    m_anyMoved = true;
+}
+
+bool TransformStore::IsDirty(uint32_t index) const
+{
+    return m_dirty[index] != 0;
+}
+
+void TransformStore::InvalidateAll()
+{
+    for (size_t i = 0; i < m_dirty.size(); ++i)
+    {
+        m_dirty[i] = m_alive[i];
+        m_moved[i] = m_alive[i];
+    }
+    m_anyDirty = true;
+    m_anyMoved = true;
+}
+
+void TransformStore::CollectMoved(std::vector<GameObject *> &outOwners)
+{
+    outOwners.clear();
+    if (!m_anyMoved)
+    {
+        return;
+    }
+
+    // Most entries do not move in a typical frame, so runs of eight clear flags are skipped with one load
+    const size_t count = m_moved.size();
+    size_t index = 0;
+    while (index < count)
+    {
+        if (index + 8 <= count)
+        {
+            uint64_t movedMask = 0;
+            std::memcpy(&movedMask, &m_moved[index], sizeof(movedMask));
+            if (movedMask == 0)
+            {
+                index += 8;
+                continue;
+            }
+        }
+
+        const size_t end = std::min(index + 8, count);
+        for (; index < end; ++index)
+        {
+            if (m_moved[index])
+            {
+                m_moved[index] = 0;
+                outOwners.push_back(m_owners[index]);
+            }
+        }
+    }
+
+    m_anyMoved = false;
+}
+
+void TransformStore::UpdateWorldTransforms()
+{
+    if (m_orderDirty)
+    {
+        SortByDepth();
+    }
+
+    if (!m_anyDirty)
+    {
+        return;
+    }
+
+    const size_t count = m_parents.size();
+    size_t first = 0;
+
+#if ENG_TRANSFORM_SSE
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; first + 4 <= count; first += 4)
+    {
+        uint32_t dirtyMask = 0;
+        std::memcpy(&dirtyMask, &m_dirty[first], sizeof(dirtyMask));
+        if (dirtyMask == 0)
+        {
+            continue;
+        }
+
+        // Local matrices of four entries at once, one entry per lane
+        const __m128 x = _mm_loadu_ps(&m_rotationX[first]);
+        const __m128 y = _mm_loadu_ps(&m_rotationY[first]);
+        const __m128 z = _mm_loadu_ps(&m_rotationZ[first]);
+        const __m128 w = _mm_loadu_ps(&m_rotationW[first]);
+        const __m128 sx = _mm_loadu_ps(&m_scaleX[first]);
+        const __m128 sy = _mm_loadu_ps(&m_scaleY[first]);
+        const __m128 sz = _mm_loadu_ps(&m_scaleZ[first]);
+
+        const __m128 xx = _mm_mul_ps(x, x);
+        const __m128 yy = _mm_mul_ps(y, y);
+        const __m128 zz = _mm_mul_ps(z, z);
+        const __m128 xy = _mm_mul_ps(x, y);
+        const __m128 xz = _mm_mul_ps(x, z);
+        const __m128 yz = _mm_mul_ps(y, z);
+        const __m128 wx = _mm_mul_ps(w, x);
+        const __m128 wy = _mm_mul_ps(w, y);
+        const __m128 wz = _mm_mul_ps(w, z);
+
+        __m128 c0x = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx);
+        __m128 c0y = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx);
+        __m128 c0z = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx);
+        __m128 c0w = zero;
+        __m128 c1x = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy);
+        __m128 c1y = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy);
+        __m128 c1z = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy);
+        __m128 c1w = zero;
+        __m128 c2x = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz);
+        __m128 c2y = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz);
+        __m128 c2z = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz);
+        __m128 c2w = zero;
+        __m128 c3x = _mm_loadu_ps(&m_positionX[first]);
+        __m128 c3y = _mm_loadu_ps(&m_positionY[first]);
+        __m128 c3z = _mm_loadu_ps(&m_positionZ[first]);
+        __m128 c3w = one;
+
+        // Transposing turns the lanes into one matrix column per entry
+        _MM_TRANSPOSE4_PS(c0x, c0y, c0z, c0w);
+        _MM_TRANSPOSE4_PS(c1x, c1y, c1z, c1w);
+        _MM_TRANSPOSE4_PS(c2x, c2y, c2z, c2w);
+        _MM_TRANSPOSE4_PS(c3x, c3y, c3z, c3w);
+        const __m128 columns[4][4] = {
+            {c0x, c1x, c2x, c3x}, {c0y, c1y, c2y, c3y}, {c0z, c1z, c2z, c3z}, {c0w, c1w, c2w, c3w}};
+
+        for (size_t lane = 0; lane < 4; ++lane)
+        {
+            const size_t index = first + lane;
+            if (!m_dirty[index])
+            {
+                continue;
+            }
+
+            float *world = glm::value_ptr(m_worldMatrices[index]);
+            for (int column = 0; column < 4; ++column)
+            {
+                _mm_storeu_ps(world + column * 4, columns[lane][column]);
+            }
+
+            // Parents precede their children, so the parent's matrix is already final
+            const uint32_t parent = m_parents[index];
+            if (parent != INVALID_INDEX)
+            {
+                MultiplyMatrices(glm::value_ptr(m_worldMatrices[parent]), world, world);
+            }
+            m_dirty[index] = 0;
+        }
+    }
+#endif
+
+    for (size_t index = first; index < count; ++index)
+    {
+        if (!m_dirty[index])
+        {
+            continue;
+        }
+
+        m_worldMatrices[index] = ComputeLocalTransform(static_cast<uint32_t>(index));
+        const uint32_t parent = m_parents[index];
+        if (parent != INVALID_INDEX)
+        {
+            float *world = glm::value_ptr(m_worldMatrices[index]);
+            MultiplyMatrices(glm::value_ptr(m_worldMatrices[parent]), world, world);
+        }
+        m_dirty[index] = 0;
+    }
+
+    m_anyDirty = false;
+}
+
+void TransformStore::Reserve(size_t capacity)
+{
+    m_positionX.reserve(capacity);
+    m_positionY.reserve(capacity);
+    m_positionZ.reserve(capacity);
+    m_rotationX.reserve(capacity);
+    m_rotationY.reserve(capacity);
+    m_rotationZ.reserve(capacity);
+    m_rotationW.reserve(capacity);
+    m_scaleX.reserve(capacity);
+    m_scaleY.reserve(capacity);
+    m_scaleZ.reserve(capacity);
+    m_parents.reserve(capacity);
+    m_owners.reserve(capacity);
+    m_alive.reserve(capacity);
+    m_dirty.reserve(capacity);
+    m_moved.reserve(capacity);
+    m_worldMatrices.reserve(capacity);
+    m_freeIndices.reserve(capacity);
+}
+
+size_t TransformStore::GetSize() const
+{
+    return m_parents.size();
+}
+
+void TransformStore::SortByDepth()
+{
+    const size_t count = m_parents.size();
+
+    // Depth of every live entry; walking up stops at the first ancestor whose depth is known
+    auto &depths = m_sortScratch.depths;
+    auto &path = m_sortScratch.path;
+    depths.assign(count, INVALID_INDEX);
+    path.clear();
+    uint32_t maxDepth = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!m_alive[i] || depths[i] != INVALID_INDEX)
+        {
+            continue;
+        }
+
+        auto current = static_cast<uint32_t>(i);
+        while (current != INVALID_INDEX && depths[current] == INVALID_INDEX)
+        {
+            path.push_back(current);
+            current = m_parents[current];
+        }
+
+        uint32_t depth = current == INVALID_INDEX ? 0 : depths[current] + 1;
+        for (auto it = path.rbegin(); it != path.rend(); ++it)
+        {
+            depths[*it] = depth++;
+        }
+        maxDepth = std::max(maxDepth, depth - 1);
+        path.clear();
+    }
+
+    // Stable counting sort keeps siblings in their previous relative order
+    auto &offsets = m_sortScratch.offsets;
+    offsets.assign(static_cast<size_t>(maxDepth) + 2, 0);
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (m_alive[i])
+        {
+            ++offsets[depths[i] + 1];
+        }
+    }
+    for (size_t depth = 1; depth < offsets.size(); ++depth)
+    {
+        offsets[depth] += offsets[depth - 1];
+    }
+
+    const uint32_t liveCount = offsets.back();
+    auto &order = m_sortScratch.order;
+    auto &newIndices = m_sortScratch.newIndices;
+    order.resize(liveCount);
+    newIndices.assign(count, INVALID_INDEX);
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (m_alive[i])
+        {
+            const uint32_t newIndex = offsets[depths[i]]++;
+            order[newIndex] = static_cast<uint32_t>(i);
+            newIndices[i] = newIndex;
+        }
+    }
+
+    Permute(m_positionX, order, m_sortScratch.floats);
+    Permute(m_positionY, order, m_sortScratch.floats);
+    Permute(m_positionZ, order, m_sortScratch.floats);
+    Permute(m_rotationX, order, m_sortScratch.floats);
+    Permute(m_rotationY, order, m_sortScratch.floats);
+    Permute(m_rotationZ, order, m_sortScratch.floats);
+    Permute(m_rotationW, order, m_sortScratch.floats);
+    Permute(m_scaleX, order, m_sortScratch.floats);
+    Permute(m_scaleY, order, m_sortScratch.floats);
+    Permute(m_scaleZ, order, m_sortScratch.floats);
+    Permute(m_parents, order, m_sortScratch.indices);
+    Permute(m_owners, order, m_sortScratch.owners);
+    Permute(m_alive, order, m_sortScratch.flags);
+    Permute(m_dirty, order, m_sortScratch.flags);
+    Permute(m_moved, order, m_sortScratch.flags);
+    Permute(m_worldMatrices, order, m_sortScratch.matrices);
+
+    for (uint32_t i = 0; i < liveCount; ++i)
+    {
+        if (m_parents[i] != INVALID_INDEX)
+        {
+            m_parents[i] = newIndices[m_parents[i]];
+        }
+        if (m_owners[i])
+        {
+            m_owners[i]->m_transformIndex = i;
+        }
+    }
+
+    m_freeIndices.clear();
+    m_orderDirty = false;
+}
+} // namespace eng
\ No newline at end of file
@@ -0,0 +1,210 @@
+#pragma once
+#include <cstdint>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <vector>
+
+namespace eng
+{
+class GameObject;
+
+/**
+ * @class TransformStore
+ * @brief Scene-level structure-of-arrays storage for the transforms of all game objects.
+ *
+ * Positions, rotations and scales live in one float array per component, next to parent indices, dirty
+ * flags and the world matrices. Entries are kept in hierarchy order (every parent before its children),
+ * so UpdateWorldTransforms() computes all dirty world matrices in a single linear pass: four local
+ * matrices at a time with SSE, then one parent multiply per node. Creating objects keeps the order;
+ * a reparenting that breaks it triggers a stable counting sort by depth before the next pass. Released
+ * entries stay in place as skipped tombstones and are reused by Allocate(); the sort also compacts them,
+ * and runs for that alone once more than 1 / COMPACT_DIVISOR of the entries are released. Indices
+ * therefore change during the sort and are written back to the owning GameObject.
+ */
+class TransformStore
+{
+  public:
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+    static constexpr size_t COMPACT_DIVISOR = 4;
+
+    TransformStore() = default;
+    TransformStore(const TransformStore &) = delete;
+    TransformStore &operator=(const TransformStore &) = delete;
+
+    /**
+     * @brief Adds an identity transform at the root of the hierarchy, reusing a released entry if there is one.
+     * @param owner Object whose index is updated when entries are reordered (may be nullptr).
+     * @return Index of the new entry.
+     */
+    uint32_t Allocate(GameObject *owner);
+
+    /**
+     * @brief Releases an entry. Its storage is reused by a later Allocate() or reclaimed by compaction.
+     * @param index Index of the entry.
+     */
+    void Release(uint32_t index);
+
+    /**
+     * @brief Sets the parent of an entry and marks it dirty. Descendants are not invalidated here.
+     * @param index Index of the entry.
+     * @param parentIndex Index of the new parent, or INVALID_INDEX for a root.
+     */
+    void SetParent(uint32_t index, uint32_t parentIndex);
+
+    /**
+     * @brief Gets the parent of an entry.
+     * @param index Index of the entry.
+     * @return Index of the parent, or INVALID_INDEX for a root.
+     */
+    [[nodiscard]] uint32_t GetParent(uint32_t index) const;
+
+    /**
+     * @brief Gets the local position of an entry.
+     * @param index Index of the entry.
+     * @return The position vector.
+     */
+    [[nodiscard]] glm::vec3 GetPosition(uint32_t index) const;
+
+    /**
+     * @brief Sets the local position of an entry and marks it dirty. The caller invalidates the subtree.
+     * @param index Index of the entry.
+     * @param position The new position vector.
+     */
+    void SetPosition(uint32_t index, const glm::vec3 &position);
+
+    /**
+     * @brief Gets the local rotation of an entry.
+     * @param index Index of the entry.
+     * @return The rotation quaternion.
+     */
+    [[nodiscard]] glm::quat GetRotation(uint32_t index) const;
+
+    /**
+     * @brief Sets the local rotation of an entry and marks it dirty. The caller invalidates the subtree.
+     * @param index Index of the entry.
+     * @param rotation The new rotation quaternion.
+     */
+    void SetRotation(uint32_t index, const glm::quat &rotation);
+
+    /**
+     * @brief Gets the local scale of an entry.
+     * @param index Index of the entry.
+     * @return The scale vector.
+     */
+    [[nodiscard]] glm::vec3 GetScale(uint32_t index) const;
+
+    /**
+     * @brief Sets the local scale of an entry and marks it dirty. The caller invalidates the subtree.
+     * @param index Index of the entry.
+     * @param scale The new scale vector.
+     */
+    void SetScale(uint32_t index, const glm::vec3 &scale);
+
+    /**
+     * @brief Builds the local matrix (translation * rotation * scale) of an entry.
+     * @param index Index of the entry.
+     * @return The 4x4 local transform matrix.
+     */
+    [[nodiscard]] glm::mat4 ComputeLocalTransform(uint32_t index) const;
+
+    /**
+     * @brief Gets the world matrix of an entry, computing it and its dirty ancestors on demand.
+     * @param index Index of the entry.
+     * @return Reference to the world matrix, valid until the store is modified.
+     */
+    [[nodiscard]] const glm::mat4 &GetWorldTransform(uint32_t index) const;
+
+    /**
+     * @brief Marks an entry's world matrix as out of date.
+     * @param index Index of the entry.
+     */
+    void MarkDirty(uint32_t index);
+
+    /**
+     * @brief Checks if an entry's world matrix is out of date.
+     * @param index Index of the entry.
+     * @return true if the world matrix must be recomputed.
+     */
+    [[nodiscard]] bool IsDirty(uint32_t index) const;
+
+    /**
+     * @brief Marks every live entry dirty, e.g. after bulk edits that bypassed the setters.
+     */
+    void InvalidateAll();
+
+    /**
+     * @brief Gets the owners of the entries marked dirty since the last call and clears their moved flags.
+     *
+     * Unlike the dirty flags, which UpdateWorldTransforms() and GetWorldTransform() clear as they recompute,
+     * the moved flags stay set until collected, so structures that follow world transforms (such as the
+     * scene's spatial index) see every change exactly once.
+     * @param outOwners Cleared, then receives the owners in store order.
+     */
+    void CollectMoved(std::vector<GameObject *> &outOwners);
+
+    /**
+     * @brief Restores hierarchy order if needed and recomputes every dirty world matrix in one linear pass.
+     */
+    void UpdateWorldTransforms();
+
+    /**
+     * @brief Reserves storage for a number of entries.
+     * @param capacity Number of entries.
+     */
+    void Reserve(size_t capacity);
+
+    /**
+     * @brief Gets the number of entries, including released ones not yet reclaimed.
+     * @return Number of entries.
+     */
+    [[nodiscard]] size_t GetSize() const;
+
+  private:
+    /**
+     * @brief Stable counting sort of the live entries by hierarchy depth; drops released entries.
+     */
+    void SortByDepth();
+
+  private:
+    /**
+     * @struct SortScratch
+     * @brief Buffers of SortByDepth(), kept between sorts so that steady-state sorting does not allocate.
+     */
+    struct SortScratch
+    {
+        std::vector<uint32_t> depths;     ///< Depth per entry.
+        std::vector<uint32_t> path;       ///< Entries on the walk up to a known depth.
+        std::vector<uint32_t> offsets;    ///< Counting sort offsets per depth.
+        std::vector<uint32_t> order;      ///< Old index per new index.
+        std::vector<uint32_t> newIndices; ///< New index per old index.
+        std::vector<float> floats;        ///< Spare buffer for the float columns.
+        std::vector<uint32_t> indices;    ///< Spare buffer for m_parents.
+        std::vector<GameObject *> owners; ///< Spare buffer for m_owners.
+        std::vector<uint8_t> flags;       ///< Spare buffer for m_alive, m_dirty and m_moved.
+        std::vector<glm::mat4> matrices;  ///< Spare buffer for m_worldMatrices.
+    };
+
+    std::vector<float> m_positionX;                 ///< Local position, x components.
+    std::vector<float> m_positionY;                 ///< Local position, y components.
+    std::vector<float> m_positionZ;                 ///< Local position, z components.
+    std::vector<float> m_rotationX;                 ///< Local rotation, x components.
+    std::vector<float> m_rotationY;                 ///< Local rotation, y components.
+    std::vector<float> m_rotationZ;                 ///< Local rotation, z components.
+    std::vector<float> m_rotationW;                 ///< Local rotation, w components.
+    std::vector<float> m_scaleX;                    ///< Local scale, x components.
+    std::vector<float> m_scaleY;                    ///< Local scale, y components.
+    std::vector<float> m_scaleZ;                    ///< Local scale, z components.
+    std::vector<uint32_t> m_parents;                ///< Parent indices, INVALID_INDEX for roots.
+    std::vector<GameObject *> m_owners;             ///< Owning objects, nullptr for released entries.
+    std::vector<uint8_t> m_alive;                   ///< Whether the entry is in use.
+    mutable std::vector<uint8_t> m_dirty;           ///< Whether the world matrix must be recomputed.
+    std::vector<uint8_t> m_moved;                   ///< Whether the entry was marked dirty since CollectMoved().
+    mutable std::vector<glm::mat4> m_worldMatrices; ///< Cached world matrices.
+    bool m_orderDirty = false;                      ///< Whether a parent may come after its child.
+    bool m_anyDirty = false;                        ///< Whether any entry was marked dirty since the last pass.
+    bool m_anyMoved = false;                        ///< Whether any moved flag is set.
+    SortScratch m_sortScratch;                      ///< Reused buffers of SortByDepth().
+    std::vector<uint32_t> m_freeIndices;            ///< Released entries, reused by Allocate().
+};
+} // namespace eng
\ No newline at end of file
@@ -4,10 +4,6 @@
 
 namespace eng
 {
-void CameraComponent::Update(float deltaTime)
-{
-}
-
 glm::mat4 CameraComponent::GetViewMatrix() const
 {
     if (!m_owner)
@@ -13,12 +13,6 @@ class CameraComponent : public Component
 {
     COMPONENT(CameraComponent)
   public:
-    /**
-     * @brief Updates the camera component.
-     * @param deltaTime The time since the last frame in seconds.
-     */
-    void Update(float deltaTime) override;
-
     /**
      * @brief Calculates the view matrix based on the object's transform.
      * @return The 4x4 view matrix.
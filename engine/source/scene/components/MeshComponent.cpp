@@ -4,6 +4,7 @@
 #include "render/Mesh.h"
 #include "render/RenderQueue.h"
 #include "scene/GameObject.h"
+#include <utility>
 
 namespace eng
 {
@@ -12,19 +13,41 @@ MeshComponent::MeshComponent(const std::shared_ptr<Material> &material, const st
 {
 }
 
+MeshComponent::MeshComponent(const std::shared_ptr<Material> &material, std::vector<MeshLod> lods, float hysteresis)
+    : m_material(material), m_mesh(lods.empty() ? nullptr : lods.front().mesh),
+      m_lods(std::make_shared<MeshLodChain>(std::move(lods), hysteresis))
+{
+}
+
 void MeshComponent::Update(float deltaTime)
 {
-    if (!m_material || !m_mesh)
+    UpdateBatch(this, 1, deltaTime);
+}
+
+void MeshComponent::UpdateBatch(MeshComponent *components, uint32_t count, float)
+{
+    auto &engine = Engine::GetInstance();
+    const float alpha = engine.GetInterpolationAlpha();
+    auto &renderQueue = engine.GetRenderQueue();
+
+    // Per thread, since chunks of the system may run in parallel
+    thread_local std::vector<RenderCommand> commands;
+    for (uint32_t i = 0; i < count; ++i)
     {
-        return;
-    }
+        const MeshComponent &component = components[i];
+        if (!component.m_material || !component.m_mesh)
+        {
+            continue;
+        }
 
-    RenderCommand command;
-    command.material = m_material;
-    command.mesh = m_mesh;
-    command.modelMatrix = GetOwner()->GetWorldTransform();
+        RenderCommand &command = commands.emplace_back();
+        command.material = component.m_material;
+        command.mesh = component.m_mesh;
+        command.modelMatrix = component.m_owner->GetInterpolatedWorldTransform(alpha);
+        command.lods = component.m_lods;
+    }
 
-    auto &renderQueue = Engine::GetInstance().GetRenderQueue();
-    renderQueue.Submit(command);
+    renderQueue.Submit(commands.data(), commands.size());
+    commands.clear();
 }
 } // namespace eng
\ No newline at end of file
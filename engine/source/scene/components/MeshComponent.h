@@ -1,7 +1,11 @@
 #pragma once
 
+#include "render/MeshLodChain.h"
 #include "scene/Component.h"
+#include "scene/SystemAccess.h"
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace eng
 {
@@ -10,12 +14,20 @@ class Mesh;
 
 /**
  * @class MeshComponent
- * @brief Component that encapsulates a mesh and a material for rendering.
+ * @brief Component that encapsulates a mesh, or a chain of levels of detail, and a material for rendering.
+ *
+ * The level of detail is not chosen here: the render queue picks it once per frame for all visible commands,
+ * see RenderQueue::Draw().
  */
 class MeshComponent : public Component
 {
     COMPONENT(MeshComponent)
   public:
+    /**
+     * @brief The render system reads the world transforms; it can run in parallel, one job per chunk.
+     */
+    using Reads = ComponentList<TransformData>;
+
     /**
      * @brief Constructs a MeshComponent.
      * @param material Shared pointer to the material.
@@ -23,15 +35,36 @@ class MeshComponent : public Component
      */
     MeshComponent(const std::shared_ptr<Material> &material, const std::shared_ptr<Mesh> &mesh);
 
+    /**
+     * @brief Constructs a MeshComponent drawn with levels of detail.
+     * @param material Shared pointer to the material.
+     * @param lods The levels, most detailed first; the first level's bounds are used for culling.
+     * @param hysteresis Relative width of the band around each screen coverage threshold, see MeshLodChain.
+     */
+    MeshComponent(const std::shared_ptr<Material> &material, std::vector<MeshLod> lods,
+                  float hysteresis = MeshLodChain::DEFAULT_HYSTERESIS);
+
     /**
      * @brief Updates the mesh component (handles rendering submission).
      * @param deltaTime The time since the last frame in seconds.
      */
     void Update(float deltaTime) override;
 
+    /**
+     * @brief Submits the render commands of a contiguous run of mesh components.
+     *
+     * The render system: the engine, render queue and interpolation factor are looked up once per batch and
+     * the commands are submitted together, taking the render queue's lock once.
+     * @param components The first component.
+     * @param count Number of components.
+     * @param deltaTime The time since the last frame in seconds.
+     */
+    static void UpdateBatch(MeshComponent *components, uint32_t count, float deltaTime);
+
   private:
     std::shared_ptr<Material> m_material; ///< The material used for rendering.
-    std::shared_ptr<Mesh> m_mesh;         ///< The mesh used for rendering.
+    std::shared_ptr<Mesh> m_mesh;         ///< The mesh used for rendering, the most detailed level with LODs.
+    std::shared_ptr<MeshLodChain> m_lods; ///< Levels of detail and the current one, null without LODs.
 };
 
 } // namespace eng
\ No newline at end of file
@@ -8,8 +8,21 @@
 namespace eng
 {
 void PlayerControllerComponent::Update(float deltaTime)
+{
+    ApplyInput(Engine::GetInstance().GetInputManager(), deltaTime);
+}
+
+void PlayerControllerComponent::UpdateBatch(PlayerControllerComponent *components, uint32_t count, float deltaTime)
 {
     auto &inputManager = Engine::GetInstance().GetInputManager();
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        components[i].ApplyInput(inputManager, deltaTime);
+    }
+}
+
+void PlayerControllerComponent::ApplyInput(InputManager &inputManager, float deltaTime)
+{
     auto rotation = m_owner->GetRotation();
 
     if (inputManager.IsMouseButtonPressed(GLFW_MOUSE_BUTTON_LEFT))
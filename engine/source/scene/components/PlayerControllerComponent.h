@@ -1,9 +1,12 @@
 #pragma once
 
 #include "scene/Component.h"
+#include <cstdint>
 
 namespace eng
 {
+class InputManager;
+
 /**
  * @class PlayerControllerComponent
  * @brief Component that provides player-controlled movement and rotation.
@@ -19,7 +22,22 @@ class PlayerControllerComponent : public Component
      */
     void Update(float deltaTime) override;
 
+    /**
+     * @brief Runs the player controller system over a contiguous run of components.
+     * @param components The first component.
+     * @param count Number of components.
+     * @param deltaTime The time since the last frame in seconds.
+     */
+    static void UpdateBatch(PlayerControllerComponent *components, uint32_t count, float deltaTime);
+
   private:
+    /**
+     * @brief Moves and rotates the owner from the current input state.
+     * @param inputManager The input manager to read.
+     * @param deltaTime The time since the last frame in seconds.
+     */
+    void ApplyInput(InputManager &inputManager, float deltaTime);
+
     float m_sensitivity = 1.5f; ///< Mouse look sensitivity.
     float m_moveSpeed = 3.0f;   ///< Movement speed.
 };
@@ -7,11 +7,21 @@ bool Game::Init()
     return true;
 }
 
+void Game::FixedUpdate(float fixedDeltaTime)
+{
+    m_scene.FixedUpdate(fixedDeltaTime);
+}
+
 void Game::Update(float deltaTime)
 {
     m_scene.Update(deltaTime);
 }
 
+void Game::LateUpdate(float deltaTime)
+{
+    m_scene.LateUpdate(deltaTime);
+}
+
 void Game::Destroy()
 {
 }
\ No newline at end of file
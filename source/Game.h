@@ -15,12 +15,24 @@ class Game : public eng::Application
      */
     bool Init() override;
 
+    /**
+     * @brief Runs a fixed simulation step of the game state.
+     * @param fixedDeltaTime The duration of one fixed step.
+     */
+    void FixedUpdate(float fixedDeltaTime) override;
+
     /**
      * @brief Updates the game state.
      * @param deltaTime The time since the last frame.
      */
     void Update(float deltaTime) override;
 
+    /**
+     * @brief Runs the late update of the game state.
+     * @param deltaTime The time since the last frame.
+     */
+    void LateUpdate(float deltaTime) override;
+
     /**
      * @brief Cleans up game resources.
      */
@@ -2,6 +2,11 @@
 #include <GLFW/glfw3.h>
 #include <iostream>
 
+namespace
+{
+const eng::StringId OFFSET_PARAM("uOffset");
+} // namespace
+
 TestObject::TestObject()
 {
     std::string vertexShaderSource = R"(
@@ -78,7 +83,7 @@ void TestObject::Update(float deltaTime)
         m_offsetY -= moveSpeed * deltaTime;
     }
 
-    m_material.SetParam("uOffset", m_offsetX, m_offsetY);
+    m_material.SetParam(OFFSET_PARAM, m_offsetX, m_offsetY);
 
     eng::RenderCommand command;
     command.material = std::shared_ptr<eng::Material>(&m_material, [](eng::Material *) {});
@@ -1,20 +1,116 @@
 #include "Game.h"
+#include <cstdlib>
+#include <cstring>
 #include <eng.h>
+#include <iostream>
 
-int main()
+namespace
 {
+void PrintUsage(const char *executable)
+{
+    std::cout << "Usage: " << executable << " [options]\n"
+              << "  --headless        Render offscreen without a display (GLFW null platform + OSMesa)\n"
+              << "  --frames <n>      Exit after n frames\n"
+              << "  --duration <s>    Exit after s seconds of simulated time\n"
+              << "  --dt <s>          Advance the simulation by a fixed s seconds per frame\n"
+              << "  --tick-rate <hz>  Rate of fixed simulation steps (0 disables them)\n"
+              << "  --single-threaded Render on the main thread (for debugging)\n"
+              << "  --workers <n>     Job system worker threads (-1 = hardware threads - 1)\n"
+              << "  --trace <file>    Write a Chrome trace on exit (profiler builds only)\n"
+              << "  --gpu-report <s>  Print GPU pass timings every s seconds\n"
+              << "  --width <px>      Window or framebuffer width\n"
+              << "  --height <px>     Window or framebuffer height" << std::endl;
+}
+
+bool ParseOptions(int argc, char **argv, eng::EngineInitOptions &options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (std::strcmp(arg, "--headless") == 0)
+        {
+            options.headless = true;
+        }
+        else if (std::strcmp(arg, "--frames") == 0 && value)
+        {
+            options.maxFrames = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+            ++i;
+        }
+        else if (std::strcmp(arg, "--duration") == 0 && value)
+        {
+            options.maxSimulatedTime = std::strtof(value, nullptr);
+            ++i;
+        }
+        else if (std::strcmp(arg, "--dt") == 0 && value)
+        {
+            options.simulatedDeltaTime = std::strtof(value, nullptr);
+            ++i;
+        }
+        else if (std::strcmp(arg, "--tick-rate") == 0 && value)
+        {
+            options.fixedTickRate = std::strtof(value, nullptr);
+            ++i;
+        }
+        else if (std::strcmp(arg, "--single-threaded") == 0)
+        {
+            options.threadedRendering = false;
+        }
+        else if (std::strcmp(arg, "--workers") == 0 && value)
+        {
+            options.workerThreads = std::atoi(value);
+            ++i;
+        }
+        else if (std::strcmp(arg, "--trace") == 0 && value)
+        {
+            options.traceOutputPath = value;
+            ++i;
+        }
+        else if (std::strcmp(arg, "--gpu-report") == 0 && value)
+        {
+            options.gpuReportInterval = std::strtof(value, nullptr);
+            ++i;
+        }
+        else if (std::strcmp(arg, "--width") == 0 && value)
+        {
+            options.width = std::atoi(value);
+            ++i;
+        }
+        else if (std::strcmp(arg, "--height") == 0 && value)
+        {
+            options.height = std::atoi(value);
+            ++i;
+        }
+        else
+        {
+            PrintUsage(argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    eng::EngineInitOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        return 1;
+    }
+
     Game *game = new Game();
     eng::Engine &engine = eng::Engine::GetInstance();
     engine.SetApplication(game);
 
-    static constexpr int WINDOW_WIDTH = 1280;
-    static constexpr int WINDOW_HEIGHT = 720;
-
-    if (engine.Init(WINDOW_WIDTH, WINDOW_HEIGHT))
+    int exitCode = 1;
+    if (engine.Init(options))
     {
         engine.Run();
+        exitCode = 0;
     }
 
     engine.Destroy();
-    return 0;
+    return exitCode;
 }
\ No newline at end of file
@@ -0,0 +1,20 @@
+#include "StressComponents.h"
+#include <cmath>
+
+MoverComponent::MoverComponent(const glm::vec3 &origin, float phase) : m_origin(origin), m_angle(phase)
+{
+}
+
+void MoverComponent::Update(float deltaTime)
+{
+    m_angle += ANGULAR_SPEED * deltaTime;
+    GetOwner()->SetPosition(m_origin + glm::vec3(std::cos(m_angle), std::sin(m_angle), 0.0f) * RADIUS);
+}
+
+void PayloadComponent::Update(float deltaTime)
+{
+    for (float &value : m_state)
+    {
+        value = value * 0.99f + deltaTime;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+#include <eng.h>
+
+/**
+ * @class MoverComponent
+ * @brief Moves its owner along a small circle around its starting position every frame.
+ */
+class MoverComponent : public eng::Component
+{
+    COMPONENT(MoverComponent)
+  public:
+    /**
+     * @brief Constructs a MoverComponent.
+     * @param origin Local position the owner circles around.
+     * @param phase Starting angle in radians, so objects do not move in lockstep.
+     */
+    MoverComponent(const glm::vec3 &origin, float phase);
+
+    /**
+     * @brief Advances the owner along its circle.
+     * @param deltaTime The time since the last frame in seconds.
+     */
+    void Update(float deltaTime) override;
+
+  private:
+    static constexpr float RADIUS = 0.5f;
+    static constexpr float ANGULAR_SPEED = 2.0f;
+
+    glm::vec3 m_origin; ///< Center of the circle in local space.
+    float m_angle;      ///< Current angle in radians.
+};
+
+/**
+ * @class PayloadComponent
+ * @brief Stands in for gameplay components: does a fixed amount of arithmetic on its own state per frame.
+ */
+class PayloadComponent : public eng::Component
+{
+    COMPONENT(PayloadComponent)
+  public:
+    /**
+     * @brief Updates the component's state.
+     * @param deltaTime The time since the last frame in seconds.
+     */
+    void Update(float deltaTime) override;
+
+  private:
+    float m_state[4] = {0.0f, 1.0f, 2.0f, 3.0f}; ///< State touched every frame.
+};
\ No newline at end of file
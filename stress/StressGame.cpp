@@ -0,0 +1,276 @@
+#include "StressGame.h"
+#include "StressComponents.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace
+{
+const char *VERTEX_SHADER = R"(
+    #version 330 core
+    layout (location = 0) in vec3 position;
+    layout (location = 1) in vec3 color;
+
+    out vec3 vColor;
+
+    uniform mat4 uModel;
+    uniform mat4 uView;
+    uniform mat4 uProjection;
+
+    void main()
+    {
+        vColor = color;
+        gl_Position = uProjection * uView * uModel * vec4(position, 1.0);
+    }
+)";
+
+const char *FRAGMENT_SHADER = R"(
+    #version 330 core
+    out vec4 FragColor;
+
+    in vec3 vColor;
+
+    uniform float uTint;
+
+    void main()
+    {
+        FragColor = vec4(vColor * uTint, 1.0);
+    }
+)";
+
+constexpr float FIELD_HALF_EXTENT = 40.0f;
+constexpr float CHILD_OFFSET = 1.5f;
+constexpr float CAMERA_DISTANCE = 80.0f;
+
+std::shared_ptr<eng::Mesh> CreateCubeMesh(float halfSize)
+{
+    const float s = halfSize;
+    // Position followed by color
+    std::vector<float> vertices = {-s, -s, s,  1.0f, 0.0f, 0.0f, s,  -s, s,  0.0f, 1.0f, 0.0f,
+                                   s,  s,  s,  0.0f, 0.0f, 1.0f, -s, s,  s,  1.0f, 1.0f, 0.0f,
+                                   -s, -s, -s, 1.0f, 0.0f, 1.0f, s,  -s, -s, 0.0f, 1.0f, 1.0f,
+                                   s,  s,  -s, 1.0f, 1.0f, 1.0f, -s, s,  -s, 0.2f, 0.2f, 0.2f};
+
+    std::vector<uint32_t> indices = {0, 1, 2, 0, 2, 3, 1, 5, 6, 1, 6, 2, 5, 4, 7, 5, 7, 6,
+                                     4, 0, 3, 4, 3, 7, 3, 2, 6, 3, 6, 7, 4, 5, 1, 4, 1, 0};
+
+    eng::VertexLayout vertexLayout;
+    vertexLayout.elements.push_back({0, 3, GL_FLOAT, 0});
+    vertexLayout.elements.push_back({1, 3, GL_FLOAT, sizeof(float) * 3});
+    vertexLayout.stride = sizeof(float) * 6;
+
+    return std::make_shared<eng::Mesh>(vertexLayout, vertices, indices);
+}
+
+std::shared_ptr<eng::Mesh> CreateTessellatedCubeMesh(float halfSize, uint32_t subdivisions)
+{
+    // Normal, then the two in-face axes, ordered so that u x v points along the normal
+    const glm::vec3 faces[6][3] = {{{1, 0, 0}, {0, 0, -1}, {0, 1, 0}},  {{-1, 0, 0}, {0, 0, 1}, {0, 1, 0}},
+                                   {{0, 1, 0}, {1, 0, 0}, {0, 0, -1}},  {{0, -1, 0}, {1, 0, 0}, {0, 0, 1}},
+                                   {{0, 0, 1}, {1, 0, 0}, {0, 1, 0}},   {{0, 0, -1}, {-1, 0, 0}, {0, 1, 0}}};
+
+    // Position followed by color, the color fading with the position across the cube
+    std::vector<float> vertices;
+    std::vector<uint32_t> indices;
+    const uint32_t rowLength = subdivisions + 1;
+    for (const auto &face : faces)
+    {
+        const auto first = static_cast<uint32_t>(vertices.size() / 6);
+        for (uint32_t j = 0; j <= subdivisions; ++j)
+        {
+            for (uint32_t i = 0; i <= subdivisions; ++i)
+            {
+                const float a = 2.0f * static_cast<float>(i) / static_cast<float>(subdivisions) - 1.0f;
+                const float b = 2.0f * static_cast<float>(j) / static_cast<float>(subdivisions) - 1.0f;
+                const glm::vec3 position = (face[0] + face[1] * a + face[2] * b) * halfSize;
+                const glm::vec3 color = position / (2.0f * halfSize) + glm::vec3(0.5f);
+                vertices.insert(vertices.end(), {position.x, position.y, position.z, color.x, color.y, color.z});
+            }
+        }
+        for (uint32_t j = 0; j < subdivisions; ++j)
+        {
+            for (uint32_t i = 0; i < subdivisions; ++i)
+            {
+                const uint32_t corner = first + j * rowLength + i;
+                indices.insert(indices.end(), {corner, corner + 1, corner + rowLength + 1, corner,
+                                               corner + rowLength + 1, corner + rowLength});
+            }
+        }
+    }
+
+    eng::VertexLayout vertexLayout;
+    vertexLayout.elements.push_back({0, 3, GL_FLOAT, 0});
+    vertexLayout.elements.push_back({1, 3, GL_FLOAT, sizeof(float) * 3});
+    vertexLayout.stride = sizeof(float) * 6;
+
+    return std::make_shared<eng::Mesh>(vertexLayout, vertices, indices);
+}
+} // namespace
+
+StressGame::StressGame(const StressOptions &options) : m_options(options)
+{
+}
+
+bool StressGame::Init()
+{
+    auto &engine = eng::Engine::GetInstance();
+
+    if (m_options.render && !CreateResources())
+    {
+        return false;
+    }
+
+    auto scene = std::make_unique<eng::Scene>();
+    m_scene = scene.get();
+    engine.SetScene(std::move(scene));
+
+    auto camera = m_scene->CreateObject("Camera");
+    camera->AddComponent<eng::CameraComponent>();
+    camera->SetPosition(glm::vec3(0.0f, 0.0f, CAMERA_DISTANCE));
+    m_scene->SetMainCamera(camera);
+
+    auto start = std::chrono::steady_clock::now();
+    uint32_t levels = CreateObjects();
+    double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Stress scene: " << m_options.objectCount << " objects, " << levels << " levels (fan-out "
+              << m_options.fanOut << "), " << m_options.componentsPerObject << " payload components per object, "
+              << m_meshes.size() << " meshes, " << m_materials.size() << " materials, "
+              << m_options.movingFraction * 100.0f << "% moving; built in " << buildMs << " ms" << std::endl;
+    return true;
+}
+
+void StressGame::FixedUpdate(float fixedDeltaTime)
+{
+    m_scene->FixedUpdate(fixedDeltaTime);
+}
+
+void StressGame::Update(float deltaTime)
+{
+    m_scene->Update(deltaTime);
+}
+
+void StressGame::LateUpdate(float deltaTime)
+{
+    m_scene->LateUpdate(deltaTime);
+}
+
+void StressGame::Destroy()
+{
+    m_scene = nullptr;
+    m_meshes.clear();
+    m_meshLods.clear();
+    m_materials.clear();
+}
+
+bool StressGame::CreateResources()
+{
+    auto &graphicsAPI = eng::Engine::GetInstance().GetGraphicsAPI();
+    auto shaderProgram = graphicsAPI.CreateShaderProgram(VERTEX_SHADER, FRAGMENT_SHADER);
+    if (!shaderProgram)
+    {
+        return false;
+    }
+
+    const uint32_t meshCount = std::max(m_options.uniqueMeshes, 1u);
+    for (uint32_t i = 0; i < meshCount; ++i)
+    {
+        const float halfSize = 0.2f + 0.1f * static_cast<float>(i % 4);
+        if (m_options.lods)
+        {
+            // 3072, 192 and 12 triangles; with the default camera the field spans all three levels
+            std::vector<eng::MeshLod> lods = {{CreateTessellatedCubeMesh(halfSize, 16), 0.02f},
+                                              {CreateTessellatedCubeMesh(halfSize, 4), 0.01f},
+                                              {CreateTessellatedCubeMesh(halfSize, 1), m_options.minScreenCoverage}};
+            m_meshes.push_back(lods.front().mesh);
+            m_meshLods.push_back(std::move(lods));
+        }
+        else
+        {
+            m_meshes.push_back(CreateCubeMesh(halfSize));
+        }
+    }
+
+    const uint32_t materialCount = std::max(m_options.uniqueMaterials, 1u);
+    for (uint32_t i = 0; i < materialCount; ++i)
+    {
+        auto material = std::make_shared<eng::Material>();
+        material->SetShaderProgram(shaderProgram);
+        material->SetParam("uTint", 0.5f + 0.5f * static_cast<float>(i) / static_cast<float>(materialCount));
+        m_materials.push_back(material);
+    }
+
+    return true;
+}
+
+uint32_t StressGame::CreateObjects()
+{
+    std::mt19937 random(m_options.seed);
+    std::uniform_real_distribution<float> field(-FIELD_HALF_EXTENT, FIELD_HALF_EXTENT);
+    std::uniform_real_distribution<float> offset(-CHILD_OFFSET, CHILD_OFFSET);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    // Objects that can still receive children, with their level and child count
+    struct OpenParent
+    {
+        eng::GameObject *object;
+        uint32_t level;
+        uint32_t children;
+    };
+    std::vector<OpenParent> openParents;
+    size_t cursor = 0;
+    uint32_t deepestLevel = 0;
+
+    for (uint32_t i = 0; i < m_options.objectCount; ++i)
+    {
+        eng::GameObject *parent = nullptr;
+        uint32_t level = 0;
+        if (cursor < openParents.size())
+        {
+            auto &open = openParents[cursor];
+            parent = open.object;
+            level = open.level + 1;
+            if (++open.children >= m_options.fanOut)
+            {
+                ++cursor;
+            }
+        }
+
+        auto object = m_scene->CreateObject("Object" + std::to_string(i), parent);
+        glm::vec3 position = parent ? glm::vec3(offset(random), offset(random), offset(random))
+                                    : glm::vec3(field(random), field(random), field(random) * 0.5f);
+        object->SetPosition(position);
+
+        if (m_options.render)
+        {
+            const size_t meshIndex = (i / m_materials.size()) % m_meshes.size();
+            if (m_options.lods)
+            {
+                object->AddComponent<eng::MeshComponent>(m_materials[i % m_materials.size()], m_meshLods[meshIndex]);
+            }
+            else
+            {
+                object->AddComponent<eng::MeshComponent>(m_materials[i % m_materials.size()], m_meshes[meshIndex]);
+            }
+        }
+
+        for (uint32_t c = 0; c < m_options.componentsPerObject; ++c)
+        {
+            object->AddComponent<PayloadComponent>();
+        }
+
+        if (unit(random) < m_options.movingFraction)
+        {
+            object->AddComponent<MoverComponent>(position, unit(random) * 6.2831853f);
+        }
+
+        if (level + 1 < m_options.depth && m_options.fanOut > 0)
+        {
+            openParents.push_back({object, level, 0});
+        }
+        deepestLevel = std::max(deepestLevel, level + 1);
+    }
+
+    return deepestLevel;
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstdint>
+#include <eng.h>
+#include <memory>
+#include <vector>
+
+/**
+ * @struct StressOptions
+ * @brief Shape of the generated stress scene.
+ */
+struct StressOptions
+{
+    uint32_t objectCount = 10000;     ///< Total number of generated objects (the camera not included).
+    uint32_t depth = 1;               ///< Hierarchy levels; 1 puts every object at the scene root.
+    uint32_t fanOut = 4;              ///< Children per object below the root level.
+    uint32_t componentsPerObject = 1; ///< PayloadComponents added to every object.
+    uint32_t uniqueMeshes = 1;        ///< Number of distinct meshes (vertex and index buffers).
+    uint32_t uniqueMaterials = 1;     ///< Number of distinct materials.
+    float movingFraction = 0.1f;      ///< Fraction of objects that get a MoverComponent.
+    bool render = true;               ///< Give every object a MeshComponent.
+    bool lods = false;                ///< Draw tessellated cubes with three levels of detail.
+    float minScreenCoverage = 0.0f;   ///< Screen coverage below which LOD objects are not drawn, 0 = never.
+    uint32_t seed = 1;                ///< Seed of the placement and selection random generator.
+};
+
+/**
+ * @class StressGame
+ * @brief Application that builds a configurable scene through Scene::CreateObject to measure engine scaling.
+ */
+class StressGame : public eng::Application
+{
+  public:
+    /**
+     * @brief Constructs the application.
+     * @param options Shape of the scene to generate.
+     */
+    explicit StressGame(const StressOptions &options);
+
+    /**
+     * @brief Generates the scene and prints its shape.
+     * @return true if the resources could be created, false otherwise.
+     */
+    bool Init() override;
+
+    /**
+     * @brief Runs a fixed simulation step of the scene.
+     * @param fixedDeltaTime The duration of one fixed step.
+     */
+    void FixedUpdate(float fixedDeltaTime) override;
+
+    /**
+     * @brief Updates the scene.
+     * @param deltaTime The time since the last frame.
+     */
+    void Update(float deltaTime) override;
+
+    /**
+     * @brief Runs the late update of the scene.
+     * @param deltaTime The time since the last frame.
+     */
+    void LateUpdate(float deltaTime) override;
+
+    /**
+     * @brief Cleans up resources.
+     */
+    void Destroy() override;
+
+  private:
+    /**
+     * @brief Creates the shared shader, the meshes and the materials.
+     * @return true on success.
+     */
+    bool CreateResources();
+
+    /**
+     * @brief Creates the objects breadth-first, filling each level before starting the next.
+     * @return The deepest level that was reached (1-based).
+     */
+    uint32_t CreateObjects();
+
+  private:
+    StressOptions m_options;                                 ///< Shape of the scene.
+    eng::Scene *m_scene = nullptr;                           ///< The generated scene, owned by the engine.
+    std::vector<std::shared_ptr<eng::Mesh>> m_meshes;        ///< Distinct meshes.
+    std::vector<std::vector<eng::MeshLod>> m_meshLods;       ///< Levels of detail of each distinct mesh with lods.
+    std::vector<std::shared_ptr<eng::Material>> m_materials; ///< Distinct materials.
+};
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include "StressGame.h"
+#include <cstdlib>
+#include <cstring>
+#include <eng.h>
+#include <iostream>
+
+namespace
+{
+constexpr uint32_t DEFAULT_FRAMES = 600;
+
+void PrintUsage(const char *executable)
+{
+    std::cout << "Usage: " << executable << " [options]\n"
+              << "Scene shape:\n"
+              << "  --objects <n>     Number of generated objects (default 10000)\n"
+              << "  --depth <n>       Hierarchy levels, 1 = all objects at the root (default 1)\n"
+              << "  --fan-out <n>     Children per object below the root (default 4)\n"
+              << "  --components <n>  Payload components per object (default 1)\n"
+              << "  --meshes <n>      Distinct meshes (default 1)\n"
+              << "  --materials <n>   Distinct materials (default 1)\n"
+              << "  --moving <f>      Fraction of objects moving every frame, 0..1 (default 0.1)\n"
+              << "  --no-render       Do not give objects a MeshComponent\n"
+              << "  --lods            Draw tessellated cubes with three levels of detail\n"
+              << "  --min-coverage <f> With --lods, skip objects covering less of the screen height (default 0)\n"
+              << "  --seed <n>        Random seed (default 1)\n"
+              << "Engine:\n"
+              << "  --headless        Render offscreen without a display (GLFW null platform + OSMesa)\n"
+              << "  --frames <n>      Exit after n frames (default " << DEFAULT_FRAMES << ", 0 = no limit)\n"
+              << "  --duration <s>    Exit after s seconds of simulated time\n"
+              << "  --dt <s>          Advance the simulation by a fixed s seconds per frame\n"
+              << "  --single-threaded Render on the main thread\n"
+              << "  --workers <n>     Job system worker threads (-1 = hardware threads - 1)\n"
+              << "  --trace <file>    Write a Chrome trace on exit (profiler builds only)\n"
+              << "  --width <px>      Window or framebuffer width\n"
+              << "  --height <px>     Window or framebuffer height" << std::endl;
+}
+
+uint32_t ToUInt(const char *value)
+{
+    return static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+}
+
+bool ParseOptions(int argc, char **argv, eng::EngineInitOptions &engineOptions, StressOptions &stressOptions)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (std::strcmp(arg, "--no-render") == 0)
+        {
+            stressOptions.render = false;
+            continue;
+        }
+        else if (std::strcmp(arg, "--lods") == 0)
+        {
+            stressOptions.lods = true;
+            continue;
+        }
+        else if (std::strcmp(arg, "--headless") == 0)
+        {
+            engineOptions.headless = true;
+            continue;
+        }
+        else if (std::strcmp(arg, "--single-threaded") == 0)
+        {
+            engineOptions.threadedRendering = false;
+            continue;
+        }
+        else if (!value)
+        {
+            PrintUsage(argv[0]);
+            return false;
+        }
+        else if (std::strcmp(arg, "--objects") == 0)
+        {
+            stressOptions.objectCount = ToUInt(value);
+        }
+        else if (std::strcmp(arg, "--depth") == 0)
+        {
+            stressOptions.depth = ToUInt(value);
+        }
+        else if (std::strcmp(arg, "--fan-out") == 0)
+        {
+            stressOptions.fanOut = ToUInt(value);
+        }
+        else if (std::strcmp(arg, "--components") == 0)
+        {
+            stressOptions.componentsPerObject = ToUInt(value);
+        }
+        else if (std::strcmp(arg, "--meshes") == 0)
+        {
+            stressOptions.uniqueMeshes = ToUInt(value);
+        }
+        else if (std::strcmp(arg, "--materials") == 0)
+        {
+            stressOptions.uniqueMaterials = ToUInt(value);
+        }
+        else if (std::strcmp(arg, "--moving") == 0)
+        {
+            stressOptions.movingFraction = std::strtof(value, nullptr);
+        }
+        else if (std::strcmp(arg, "--min-coverage") == 0)
+        {
+            stressOptions.minScreenCoverage = std::strtof(value, nullptr);
+        }
+        else if (std::strcmp(arg, "--seed") == 0)
+        {
+            stressOptions.seed = ToUInt(value);
+        }
+        else if (std::strcmp(arg, "--frames") == 0)
+        {
+            engineOptions.maxFrames = ToUInt(value);
+        }
+        else if (std::strcmp(arg, "--duration") == 0)
+        {
+            engineOptions.maxSimulatedTime = std::strtof(value, nullptr);
+        }
+        else if (std::strcmp(arg, "--dt") == 0)
+        {
+            engineOptions.simulatedDeltaTime = std::strtof(value, nullptr);
+        }
+        else if (std::strcmp(arg, "--workers") == 0)
+        {
+            engineOptions.workerThreads = std::atoi(value);
+        }
+        else if (std::strcmp(arg, "--trace") == 0)
+        {
+            engineOptions.traceOutputPath = value;
+        }
+        else if (std::strcmp(arg, "--width") == 0)
+        {
+            engineOptions.width = std::atoi(value);
+        }
+        else if (std::strcmp(arg, "--height") == 0)
+        {
+            engineOptions.height = std::atoi(value);
+        }
+        else
+        {
+            PrintUsage(argv[0]);
+            return false;
+        }
+        ++i;
+    }
+    return true;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    eng::EngineInitOptions engineOptions;
+    engineOptions.maxFrames = DEFAULT_FRAMES;
+    StressOptions stressOptions;
+    if (!ParseOptions(argc, argv, engineOptions, stressOptions))
+    {
+        return 1;
+    }
+
+    eng::Engine &engine = eng::Engine::GetInstance();
+    engine.SetApplication(new StressGame(stressOptions));
+
+    int exitCode = 1;
+    if (engine.Init(engineOptions))
+    {
+        engine.Run();
+        exitCode = 0;
+    }
+
+    engine.Destroy();
+    return exitCode;
+}
\ No newline at end of file